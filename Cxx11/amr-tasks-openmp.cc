@@ -0,0 +1,477 @@
+///
+/// Copyright (c) 2016, Intel Corporation
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions
+/// are met:
+///
+/// * Redistributions of source code must retain the above copyright
+///       notice, this list of conditions and the following disclaimer.
+/// * Redistributions in binary form must reproduce the above
+///       copyright notice, this list of conditions and the following
+///       disclaimer in the documentation and/or other materials provided
+///       with the distribution.
+/// * Neither the name of Intel Corporation nor the names of its
+///       contributors may be used to endorse or promote products
+///       derived from this software without specific prior written
+///       permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+/// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+/// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+/// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+/// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+/// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+/// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+/// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+/// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+/// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+
+//////////////////////////////////////////////////////////////////////
+///
+/// NAME:    AMR
+///
+/// PURPOSE: This program tests the efficiency with which a space-invariant,
+///          linear, symmetric filter (stencil) can be applied to a square
+///          grid or image, with periodic introduction and removal of
+///          subgrids.
+///
+///          In this version the background grid update and the work on
+///          each of the four refinements are OpenMP tasks whose
+///          dependences encode the data flow of the serial algorithm:
+///          a refinement is interpolated from the background input field
+///          before the background adds its constant, and the sub-iterations
+///          on a refinement only depend on earlier work on that refinement.
+///          Refinement work can therefore overlap background updates.
+///
+/// USAGE:   The program takes as input the linear
+///          dimension of the grid, and the number of iterations on the grid
+///
+///                <progname> <iterations> <background grid size> <refinement size>
+///                           <refinement level> <refinement period>
+///                           <refinement duration> <refinement sub-iterations>
+///                           [<tile_size> <star/grid> <radius>]
+///
+///          The output consists of diagnostics to make sure the
+///          algorithm worked, and of timing statistics.  The time spent
+///          in the background and refinement tasks is reported separately.
+///
+/// FUNCTIONS CALLED:
+///
+///          Other than standard C functions, the following functions are used in
+///          this program:
+///          wtime()
+///          interpolate()
+///
+/// HISTORY: - Written by Rob Van der Wijngaart, July 2016
+///            C++11-ification with OpenMP tasks, 2018.
+///
+//////////////////////////////////////////////////////////////////////
+
+#include "prk_util.h"
+#include "prk_openmp.h"
+#include "stencil_seq.hpp"
+
+void nothing(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out)
+{
+    std::cout << "You are trying to use a stencil that does not exist.\n";
+    std::cout << "Please generate the new stencil using the code generator\n";
+    std::cout << "and add it to the case-switch in the driver." << std::endl;
+    // n will never be zero - this is to silence compiler warnings.
+    if (n==0 || t==0) std::cout << in.size() << out.size() << std::endl;
+    std::abort();
+}
+
+// Two-stage, bi-linear interpolation from background grid to refinement.
+// Both grids are stored with the x index fastest, as in SERIAL/AMR/amr.c.
+void interpolate(std::vector<double> & ing_r, const std::vector<double> & in,
+                 long n, long n_r_true, long istart_r, long jstart_r, long expand, double h_r)
+{
+  if (expand==1) {
+    // simply copy background grid values to refinement if same resolution
+    for (long jr=0; jr<n_r_true; jr++) {
+      for (long ir=0; ir<n_r_true; ir++) {
+        ing_r[ir+jr*n_r_true] = in[(ir+istart_r)+(jr+jstart_r)*n];
+      }
+    }
+  } else {
+    const long iend_r = istart_r+(n_r_true-1)/expand;
+    // first, interpolate in x-direction
+    for (long jr=0, jb=jstart_r; jr<n_r_true; jr+=expand, jb++) {
+      for (long ir=0; ir<n_r_true-1; ir++) {
+        const double xr = istart_r+h_r*static_cast<double>(ir);
+        const long ib = static_cast<long>(xr);
+        const double xb = static_cast<double>(ib);
+        ing_r[ir+jr*n_r_true] = in[(ib+1)+jb*n]*(xr-xb) + in[ib+jb*n]*(xb+1.0-xr);
+      }
+      ing_r[(n_r_true-1)+jr*n_r_true] = in[iend_r+jb*n];
+    }
+    // next, interpolate in y-direction
+    for (long jr=0; jr<n_r_true-1; jr++) {
+      const double yr = h_r*static_cast<double>(jr);
+      const long jb = static_cast<long>(yr);
+      const long jrb = jb*expand;
+      const long jrb1 = (jb+1)*expand;
+      const double yb = static_cast<double>(jb);
+      for (long ir=0; ir<n_r_true; ir++) {
+        ing_r[ir+jr*n_r_true] = ing_r[ir+jrb1*n_r_true]*(yr-yb) + ing_r[ir+jrb*n_r_true]*(yb+1.0-yr);
+      }
+    }
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  std::cout << "Parallel Research Kernels version " << PRKVERSION << std::endl;
+#ifdef _OPENMP
+  std::cout << "C++11/OpenMP TASKS AMR stencil execution on 2D grid" << std::endl;
+#else
+  std::cout << "C++11/Serial AMR stencil execution on 2D grid" << std::endl;
+#endif
+
+  //////////////////////////////////////////////////////////////////////
+  // Process and test input parameters
+  //////////////////////////////////////////////////////////////////////
+
+  int iterations;     // number of times to run the algorithm
+  int64_t n;          // linear grid dimension
+  int64_t n_r;        // linear refinement size in bg grid units
+  int refine_level;   // refinement level
+  int period;         // refinement period
+  int duration;       // lifetime of a refinement
+  int sub_iterations; // number of sub-iterations on refinement
+  int64_t tile_size;  // loop nest block factor
+  bool star = true;
+  int radius;
+  try {
+      if (argc < 8) {
+        throw "Usage: <# iterations> <background grid size> <refinement size>\n"
+              "       <refinement level> <refinement period> <refinement duration>\n"
+              "       <refinement sub-iterations> [<tile_size> <star/grid> <radius>]";
+      }
+
+      iterations  = std::atoi(argv[1]);
+      if (iterations < 1) {
+        throw "ERROR: iterations must be >= 1";
+      }
+
+      n  = std::atoll(argv[2]);
+      if (n < 2) {
+        throw "ERROR: grid must have at least one cell";
+      } else if (n > std::floor(std::sqrt(INT64_MAX))) {
+        throw "ERROR: grid dimension too large - overflow risk";
+      }
+
+      n_r = std::atoll(argv[3]);
+      if (n_r < 2) {
+        throw "ERROR: refinements must have at least one cell";
+      }
+      if (n_r > n) {
+        throw "ERROR: refinements must be contained in background grid";
+      }
+
+      refine_level = std::atoi(argv[4]);
+      if (refine_level < 0) {
+        throw "ERROR: refinement levels must be >= 0";
+      }
+
+      period = std::atoi(argv[5]);
+      if (period < 1) {
+        throw "ERROR: refinement period must be at least one";
+      }
+
+      duration = std::atoi(argv[6]);
+      if (duration < 1 || duration > period) {
+        throw "ERROR: refinement duration must be positive, no greater than period";
+      }
+
+      sub_iterations = std::atoi(argv[7]);
+      if (sub_iterations < 1) {
+        throw "ERROR: refinement sub-iterations must be positive";
+      }
+
+      tile_size = 32;
+      if (argc > 8) {
+          tile_size = std::atoll(argv[8]);
+          if (tile_size <= 0) tile_size = n;
+          if (tile_size > n) tile_size = n;
+      }
+
+      if (argc > 9) {
+          auto stencil = std::string(argv[9]);
+          auto grid = std::string("grid");
+          star = (stencil == grid) ? false : true;
+      }
+
+      radius = 2;
+      if (argc > 10) {
+          radius = std::atoi(argv[10]);
+      }
+
+      if ( (radius < 1) || (2*radius+1 > n) ) {
+        throw "ERROR: Stencil radius negative or too large";
+      }
+  }
+  catch (const char * e) {
+    std::cout << e << std::endl;
+    return 1;
+  }
+
+  // refinement mesh spacing plus ratio of mesh spacings
+  double h_r = 1.0;
+  long expand = 1;
+  for (int l=0; l<refine_level; l++) {
+    h_r /= 2.0;
+    expand *= 2;
+  }
+
+  const int64_t n_r_true = (n_r-1)*expand+1;
+  if (2*radius+1 > n_r_true) {
+    std::cout << "ERROR: Stencil radius exceeds refinement size" << std::endl;
+    return 1;
+  } else if (n_r_true > std::floor(std::sqrt(INT64_MAX))) {
+    std::cout << "ERROR: refinement dimension too large - overflow risk" << std::endl;
+    return 1;
+  }
+
+#ifdef _OPENMP
+  std::cout << "Number of threads (max)   = " << omp_get_max_threads() << std::endl;
+#endif
+  std::cout << "Background grid size = " << n << std::endl;
+  std::cout << "Radius of stencil    = " << radius << std::endl;
+  std::cout << "Type of stencil      = " << (star ? "star" : "grid") << std::endl;
+  std::cout << "Tile size            = " << tile_size << std::endl;
+  std::cout << "Number of iterations = " << iterations << std::endl;
+  std::cout << "Refinements:" << std::endl;
+  std::cout << "   Background grid points = " << n_r << std::endl;
+  std::cout << "   Grid size              = " << n_r_true << std::endl;
+  std::cout << "   Period                 = " << period << std::endl;
+  std::cout << "   Duration               = " << duration << std::endl;
+  std::cout << "   Level                  = " << refine_level << std::endl;
+  std::cout << "   Sub-iterations         = " << sub_iterations << std::endl;
+
+  auto stencil = nothing;
+  if (star) {
+      switch (radius) {
+          case 1: stencil = star1<double>; break;
+          case 2: stencil = star2<double>; break;
+          case 3: stencil = star3<double>; break;
+          case 4: stencil = star4<double>; break;
+          case 5: stencil = star5<double>; break;
+      }
+  } else {
+      switch (radius) {
+          case 1: stencil = grid1<double>; break;
+          case 2: stencil = grid2<double>; break;
+          case 3: stencil = grid3<double>; break;
+          case 4: stencil = grid4<double>; break;
+          case 5: stencil = grid5<double>; break;
+      }
+  }
+
+  //////////////////////////////////////////////////////////////////////
+  // Allocate space and perform the computation
+  //////////////////////////////////////////////////////////////////////
+
+  std::vector<double> in(n*n);
+  std::vector<double> out(n*n,0.0);
+  for (long j=0; j<n; j++) {
+    for (long i=0; i<n; i++) {
+      in[i+j*n] = static_cast<double>(i+j);
+    }
+  }
+
+  // layout of refinements (bottom left background grid coordinate)
+  const long istart_r[4] = { 0, n-n_r, 0,     n-n_r };
+  const long jstart_r[4] = { 0, n-n_r, n-n_r, 0     };
+
+  std::vector<double> in_r[4];
+  std::vector<double> out_r[4];
+  for (int g=0; g<4; g++) {
+    in_r[g].resize(n_r_true*n_r_true,0.0);
+    out_r[g].resize(n_r_true*n_r_true,0.0);
+  }
+
+  // The Cxx11 stencil kernels have fixed weights, while the refinement weights
+  // are those of the background scaled by expand.  Because the stencil is
+  // linear, out_r accumulates the unscaled result and is scaled once at the end.
+
+  auto stencil_time = 0.0;
+  auto bg_time = 0.0;
+  double refine_time[4] = {0.0,0.0,0.0,0.0};
+  int num_interpolations = 0;
+
+  OMP_PARALLEL()
+  OMP_MASTER
+  {
+    for (int iter = 0; iter<=iterations; iter++) {
+
+      // start timer after a warmup iteration
+      if (iter == 1) {
+        OMP_TASKWAIT
+        stencil_time = prk::wtime();
+      }
+
+      const int g = (iter/period)%4;
+
+      if (!(iter%period)) {
+        // a specific refinement has come to life
+        num_interpolations++;
+        OMP_TASK( firstprivate(g,iter) depend(in:in) depend(inout:in_r[g]) )
+        {
+          const double t0 = prk::wtime();
+          interpolate(in_r[g], in, n, n_r_true, istart_r[g], jstart_r[g], expand, h_r);
+          if (iter>=1) refine_time[g] += prk::wtime() - t0;
+        }
+      }
+
+      if ((iter%period) < duration) {
+        OMP_TASK( firstprivate(g,iter) depend(inout:in_r[g]) )
+        {
+          const double t0 = prk::wtime();
+          for (int sub_iter=0; sub_iter<sub_iterations; sub_iter++) {
+            stencil(n_r_true, tile_size, in_r[g], out_r[g]);
+            // add constant to solution to force refresh of neighbor data, if any
+            std::transform(in_r[g].begin(), in_r[g].end(), in_r[g].begin(), [](double c) { return c+=1.0; });
+          }
+          if (iter>=1) refine_time[g] += prk::wtime() - t0;
+        }
+      }
+
+      // apply the stencil operator to background grid
+      OMP_TASK( firstprivate(iter) depend(in:in) depend(inout:out) )
+      {
+        const double t0 = prk::wtime();
+        stencil(n, tile_size, in, out);
+        if (iter>=1) bg_time += prk::wtime() - t0;
+      }
+
+      // add constant to solution to force refresh of neighbor data, if any
+      OMP_TASK( firstprivate(iter) depend(inout:in) )
+      {
+        const double t0 = prk::wtime();
+        std::transform(in.begin(), in.end(), in.begin(), [](double c) { return c+=1.0; });
+        if (iter>=1) bg_time += prk::wtime() - t0;
+      }
+    }
+    OMP_TASKWAIT
+    stencil_time = prk::wtime() - stencil_time;
+  }
+
+  //////////////////////////////////////////////////////////////////////
+  // Analyze and output results.
+  //////////////////////////////////////////////////////////////////////
+
+  const double epsilon = 1.e-8;
+  const double f_active_points   = static_cast<double>(n-2*radius)*static_cast<double>(n-2*radius);
+  const double f_active_points_r = static_cast<double>(n_r_true-2*radius)*static_cast<double>(n_r_true-2*radius);
+  bool validate = true;
+
+  // normalized L1 solution and input field norms on background grid
+  double norm(0), norm_in(0);
+  for (long j=radius; j<n-radius; j++) {
+    for (long i=radius; i<n-radius; i++) {
+      norm += std::fabs(out[i+j*n]);
+    }
+  }
+  norm /= f_active_points;
+  for (long j=0; j<n; j++) {
+    for (long i=0; i<n; i++) {
+      norm_in += std::fabs(in[i+j*n]);
+    }
+  }
+  norm_in /= n*n;
+
+  const double reference_norm = 2.*(iterations+1.);
+  const double reference_norm_in = 2.*((n-1)/2.0)+iterations+1;
+  if (std::fabs(norm-reference_norm) > epsilon) {
+    std::cout << "ERROR: L1 norm = " << norm
+              << " Reference L1 norm = " << reference_norm << std::endl;
+    validate = false;
+  }
+  if (std::fabs(norm_in-reference_norm_in) > epsilon) {
+    std::cout << "ERROR: L1 input norm = " << norm_in
+              << " Reference L1 input norm = " << reference_norm_in << std::endl;
+    validate = false;
+  }
+
+  // verify correctness of refinement grid solutions and input fields
+  const int full_cycles = ((iterations+1)/(period*4));
+  const int leftover_iterations = (iterations+1)%(period*4);
+  int iterations_r[4];
+  for (int g=0; g<4; g++) {
+    double norm_r(0), norm_in_r(0);
+    for (long j=radius; j<n_r_true-radius; j++) {
+      for (long i=radius; i<n_r_true-radius; i++) {
+        norm_r += std::fabs(out_r[g][i+j*n_r_true]);
+      }
+    }
+    norm_r *= static_cast<double>(expand)/f_active_points_r;
+    for (long j=0; j<n_r_true; j++) {
+      for (long i=0; i<n_r_true; i++) {
+        norm_in_r += std::fabs(in_r[g][i+j*n_r_true]);
+      }
+    }
+    norm_in_r /= n_r_true*n_r_true;
+
+    const int active = std::min(std::max(0,leftover_iterations-g*period),duration);
+    iterations_r[g] = sub_iterations*(full_cycles*duration+active);
+    const double reference_norm_r = 2.*iterations_r[g];
+    double reference_norm_in_r(0);
+    if (iterations_r[g] != 0) {
+      int bg_updates = (full_cycles*4 + g)*period;
+      int r_updates  = active * sub_iterations;
+      if (bg_updates > iterations) {
+        // if this refinement not active in last AMR cycle, it completed the previous one completely
+        bg_updates -= 4*period;
+        r_updates = sub_iterations*duration;
+      }
+      reference_norm_in_r = (istart_r[g] + jstart_r[g]) // initial value at bottom left corner of refinement
+                          + 2.*(n_r-1)/2.0              // variable part
+                          + bg_updates                  // background updates before interpolation
+                          + r_updates;                  // refinement updates since interpolation
+    }
+
+    if (std::fabs(norm_r-reference_norm_r) > epsilon) {
+      std::cout << "ERROR: L1 norm " << g << " = " << norm_r
+                << " Reference L1 norm = " << reference_norm_r << std::endl;
+      validate = false;
+    }
+    if (std::fabs(norm_in_r-reference_norm_in_r) > epsilon) {
+      std::cout << "ERROR: L1 input norm " << g << " = " << norm_in_r
+                << " Reference L1 input norm = " << reference_norm_in_r << std::endl;
+      validate = false;
+    }
+  }
+
+  if (!validate) {
+    std::cout << "Solution does not validate" << std::endl;
+    return 1;
+  }
+
+  std::cout << "Solution validates" << std::endl;
+
+  const int stencil_size = star ? 4*radius+1 : (2*radius+1)*(2*radius+1);
+  double flops = f_active_points * iterations;
+  // subtract one untimed iteration from refinement 0
+  iterations_r[0]--;
+  for (int g=0; g<4; g++) flops += f_active_points_r * iterations_r[g];
+  flops *= (2*stencil_size+1);
+  // add interpolation flops, if applicable, except the untimed one
+  if (refine_level>0) {
+    num_interpolations--;
+    flops += n_r_true*(num_interpolations)*3*(n_r_true+n_r);
+  }
+
+  std::cout << "Background task time (s): " << bg_time << std::endl;
+  for (int g=0; g<4; g++) {
+    std::cout << "Refinement " << g << " task time (s): " << refine_time[g] << std::endl;
+  }
+  auto avgtime = stencil_time/iterations;
+  std::cout << "Rate (MFlops/s): " << 1.0e-6 * flops/stencil_time
+            << " Avg time (s): " << avgtime << std::endl;
+
+  return 0;
+}
@@ -75,14 +75,14 @@
 
 #ifdef PRK_DEBUG
 #include <random>
-void prk_dgemm_loops(const int order,
+void prk_dgemm_loops(const int64_t order,
                const std::vector<double> & A,
                const std::vector<double> & B,
                      std::vector<double> & C)
 {
-    for (int i=0; i<order; ++i) {
-      for (int j=0; j<order; ++j) {
-        for (int k=0; k<order; ++k) {
+    for (int64_t i=0; i<order; ++i) {
+      for (int64_t j=0; j<order; ++j) {
+        for (int64_t k=0; k<order; ++k) {
             C[i*order+j] += A[i*order+k] * B[k*order+j];
         }
       }
@@ -189,7 +189,7 @@ int main(int argc, char * argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int order;
+  int64_t order;
   int batches = 0;
   int batch_threads = 1;
   try {
@@ -202,11 +202,13 @@ int main(int argc, char * argv[])
         throw "ERROR: iterations must be >= 1";
       }
 
-      order = std::atoi(argv[2]);
+      order = std::atoll(argv[2]);
       if (order <= 0) {
         throw "ERROR: Matrix Order must be greater than 0";
-      } else if (order > std::floor(std::sqrt(INT_MAX))) {
+      } else if (order > std::floor(std::sqrt(INT64_MAX))) {
         throw "ERROR: matrix dimension too large - overflow risk";
+      } else if (order > INT_MAX) {
+        throw "ERROR: matrix dimension exceeds the BLAS integer range";
       }
 
       if (argc>3) {
@@ -258,8 +260,8 @@ int main(int argc, char * argv[])
   std::vector<std::vector<double>> B(matrices,M);
   std::vector<std::vector<double>> C(matrices,M);
   for (int b=0; b<matrices; ++b) {
-    for (int i=0; i<order; ++i) {
-      for (int j=0; j<order; ++j) {
+    for (int64_t i=0; i<order; ++i) {
+      for (int64_t j=0; j<order; ++j) {
          A[b][i*order+j] = i;
          B[b][i*order+j] = i;
          C[b][i*order+j] = 0;
@@ -322,8 +324,8 @@ int main(int argc, char * argv[])
               << "Residuum           = " << residuum << std::endl;
 #if VERBOSE
     std::cout << "i, j, A, B, C, D" << std::endl;
-    for (int i=0; i<order; ++i)
-      for (int j=0; j<order; ++j)
+    for (int64_t i=0; i<order; ++i)
+      for (int64_t j=0; j<order; ++j)
         std::cout << i << "," << j << " = " << A[i*order+j] << ", " << B[i*order+j] << ", " << C[i*order+j] << ", " << D[i*order+j] << "\n";
     std::cout << std::endl;
 #endif
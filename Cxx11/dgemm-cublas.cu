@@ -62,10 +62,10 @@
 #include "prk_util.h"
 #include "prk_cuda.h"
 
-__global__ void init(int order, const int matrices, double * A, double * B, double * C)
+__global__ void init(int64_t order, const int matrices, double * A, double * B, double * C)
 {
-    int i = blockIdx.x * blockDim.x + threadIdx.x;
-    int j = blockIdx.y * blockDim.y + threadIdx.y;
+    int64_t i = blockIdx.x * blockDim.x + threadIdx.x;
+    int64_t j = blockIdx.y * blockDim.y + threadIdx.y;
 
     for (int b=0; b<matrices; ++b) {
       if ((i<order) && (j<order)) {
@@ -76,10 +76,10 @@ __global__ void init(int order, const int matrices, double * A, double * B, doub
     }
 }
 
-__global__ void init(int order, const int matrices, double * C)
+__global__ void init(int64_t order, const int matrices, double * C)
 {
-    int i = blockIdx.x * blockDim.x + threadIdx.x;
-    int j = blockIdx.y * blockDim.y + threadIdx.y;
+    int64_t i = blockIdx.x * blockDim.x + threadIdx.x;
+    int64_t j = blockIdx.y * blockDim.y + threadIdx.y;
 
     for (int b=0; b<matrices; ++b) {
       if ((i<order) && (j<order)) {
@@ -89,7 +89,7 @@ __global__ void init(int order, const int matrices, double * C)
 }
 
 void prk_dgemm(const cublasHandle_t & h,
-               const int order,
+               const int64_t order,
                const int batches,
                double * A,
                double * B,
@@ -115,7 +115,7 @@ void prk_dgemm(const cublasHandle_t & h,
 }
 
 void prk_bgemm(const cublasHandle_t & h,
-               const int order,
+               const int64_t order,
                const int batches,
                double * A,
                double * B,
@@ -160,7 +160,7 @@ int main(int argc, char * argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int order;
+  int64_t order;
   int batches = 0;
   int input_copy = 0;
   try {
@@ -173,11 +173,13 @@ int main(int argc, char * argv[])
         throw "ERROR: iterations must be >= 1";
       }
 
-      order = std::atoi(argv[2]);
+      order = std::atoll(argv[2]);
       if (order <= 0) {
         throw "ERROR: Matrix Order must be greater than 0";
-      } else if (order > std::floor(std::sqrt(INT_MAX))) {
+      } else if (order > std::floor(std::sqrt(INT64_MAX))) {
         throw "ERROR: matrix dimension too large - overflow risk";
+      } else if (order > INT_MAX) {
+        throw "ERROR: matrix dimension exceeds the BLAS integer range";
       }
 
       if (argc>3) {
@@ -241,8 +243,8 @@ int main(int argc, char * argv[])
 
   if (input_copy) {
 
-    for (int i=0; i<order; ++i) {
-      for (int j=0; j<order; ++j) {
+    for (int64_t i=0; i<order; ++i) {
+      for (int64_t j=0; j<order; ++j) {
          h_a[i*order+j] = i;
          h_b[i*order+j] = i;
       }
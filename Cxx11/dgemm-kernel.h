@@ -0,0 +1,146 @@
+///
+/// Copyright (c) 2018, Intel Corporation
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions
+/// are met:
+///
+/// * Redistributions of source code must retain the above copyright
+///       notice, this list of conditions and the following disclaimer.
+/// * Redistributions in binary form must reproduce the above
+///       copyright notice, this list of conditions and the following
+///       disclaimer in the documentation and/or other materials provided
+///       with the distribution.
+/// * Neither the name of Intel Corporation nor the names of its
+///       contributors may be used to endorse or promote products
+///       derived from this software without specific prior written
+///       permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+/// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+/// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+/// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+/// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+/// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+/// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+/// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+/// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+/// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DGEMM_KERNEL_H
+#define DGEMM_KERNEL_H
+
+#include <vector>
+
+#include "prk_types.h"
+
+// C += A*B for dgemm-vector and prk-suite, untiled (IKJ loop order) or
+// tiled.  The 16-bit types accumulate in their compute type.
+
+template <typename T>
+void prk_dgemm(const int64_t order,
+               const std::vector<T> & A,
+               const std::vector<T> & B,
+                     std::vector<T> & C)
+{
+    using U = typename prk::precision_traits<T>::compute;
+    if (std::is_same<T,U>::value) {
+      PRAGMA_SIMD
+      for (int64_t i=0; i<order; ++i) {
+        PRAGMA_SIMD
+        for (int64_t k=0; k<order; ++k) {
+          PRAGMA_SIMD
+          for (int64_t j=0; j<order; ++j) {
+              C[i*order+j] += A[i*order+k] * B[k*order+j];
+          }
+        }
+      }
+    } else {
+      // rounding C to 16 bits after every k would swamp the result
+      std::vector<U> Ci(order);
+      for (int64_t i=0; i<order; ++i) {
+        std::fill(Ci.begin(), Ci.end(), U(0));
+        for (int64_t k=0; k<order; ++k) {
+          const U Aik = A[i*order+k];
+          PRAGMA_SIMD
+          for (int64_t j=0; j<order; ++j) {
+              Ci[j] += Aik * static_cast<U>(B[k*order+j]);
+          }
+        }
+        for (int64_t j=0; j<order; ++j) {
+            C[i*order+j] += Ci[j];
+        }
+      }
+    }
+}
+
+template <typename T>
+void prk_dgemm(const int64_t order, const int64_t tile_size,
+               const std::vector<T> & A,
+               const std::vector<T> & B,
+                     std::vector<T> & C)
+{
+    using U = typename prk::precision_traits<T>::compute;
+    if (std::is_same<T,U>::value) {
+      for (int64_t it=0; it<order; it+=tile_size) {
+        for (int64_t kt=0; kt<order; kt+=tile_size) {
+          for (int64_t jt=0; jt<order; jt+=tile_size) {
+            // ICC will not hoist these on its own...
+            auto iend = std::min(order,it+tile_size);
+            auto jend = std::min(order,jt+tile_size);
+            auto kend = std::min(order,kt+tile_size);
+            PRAGMA_SIMD
+            for (auto i=it; i<iend; ++i) {
+              PRAGMA_SIMD
+              for (auto k=kt; k<kend; ++k) {
+                PRAGMA_SIMD
+                for (auto j=jt; j<jend; ++j) {
+                  C[i*order+j] += A[i*order+k] * B[k*order+j];
+                }
+              }
+            }
+          }
+        }
+      }
+    } else {
+      // kt is innermost so that each tile of C is accumulated in U
+      // and rounded once
+      std::vector<U> Ct(tile_size*tile_size);
+      for (int64_t it=0; it<order; it+=tile_size) {
+        for (int64_t jt=0; jt<order; jt+=tile_size) {
+          auto iend = std::min(order,it+tile_size);
+          auto jend = std::min(order,jt+tile_size);
+          std::fill(Ct.begin(), Ct.end(), U(0));
+          for (int64_t kt=0; kt<order; kt+=tile_size) {
+            auto kend = std::min(order,kt+tile_size);
+            for (auto i=it; i<iend; ++i) {
+              for (auto k=kt; k<kend; ++k) {
+                const U Aik = A[i*order+k];
+                PRAGMA_SIMD
+                for (auto j=jt; j<jend; ++j) {
+                  Ct[(i-it)*tile_size+(j-jt)] += Aik * static_cast<U>(B[k*order+j]);
+                }
+              }
+            }
+          }
+          for (auto i=it; i<iend; ++i) {
+            for (auto j=jt; j<jend; ++j) {
+              C[i*order+j] += Ct[(i-it)*tile_size+(j-jt)];
+            }
+          }
+        }
+      }
+    }
+}
+
+// The sum of the entries of C after iterations+1 products of A and B,
+// whose rows i hold i*scale.
+inline double dgemm_reference(int64_t order, int iterations, double scale = 1.0)
+{
+    const auto forder = static_cast<double>(order);
+    return 0.25 * std::pow(forder,3) * std::pow(forder-1.0,2) * (iterations+1) * scale * scale;
+}
+
+#endif /* DGEMM_KERNEL_H */
@@ -41,7 +41,13 @@
 ///          is carried out, and, optionally, a tile size for matrix
 ///          blocking
 ///
-///          <progname> <# iterations> <matrix order> [<tile size>]
+///          <progname> <# iterations> <matrix order> [<tile size|auto>]
+///
+///          With "auto", the tile size is found by prk::autotune and cached.
+///
+///          The element type is chosen with PRK_PRECISION (see prk_types.h).
+///          The 16-bit types accumulate in float and round C once per
+///          iteration, and A and B are scaled by 1/order to stay in range.
 ///
 ///          The output consists of diagnostics to make sure the
 ///          algorithm worked, and of timing statistics.
@@ -59,117 +65,72 @@
 //////////////////////////////////////////////////////////////////////
 
 #include "prk_util.h"
+#include "prk_autotune.h"
+#include "dgemm-kernel.h"
 
-void prk_dgemm(const int order,
-               const std::vector<double> & A,
-               const std::vector<double> & B,
-                     std::vector<double> & C)
+template <typename T>
+int dgemm(int iterations, int64_t order, int64_t tile_size, bool autotune)
 {
-    PRAGMA_SIMD
-    for (auto i=0; i<order; ++i) {
-      PRAGMA_SIMD
-      for (auto k=0; k<order; ++k) {
-        PRAGMA_SIMD
-        for (auto j=0; j<order; ++j) {
-            C[i*order+j] += A[i*order+k] * B[k*order+j];
-        }
-      }
-    }
-}
+  using U = typename prk::precision_traits<T>::compute;
 
-void prk_dgemm(const int order, const int tile_size,
-               const std::vector<double> & A,
-               const std::vector<double> & B,
-                     std::vector<double> & C)
-{
-    for (auto it=0; it<order; it+=tile_size) {
-      for (auto kt=0; kt<order; kt+=tile_size) {
-        for (auto jt=0; jt<order; jt+=tile_size) {
-          // ICC will not hoist these on its own...
-          auto iend = std::min(order,it+tile_size);
-          auto jend = std::min(order,jt+tile_size);
-          auto kend = std::min(order,kt+tile_size);
-          PRAGMA_SIMD
-          for (auto i=it; i<iend; ++i) {
-            PRAGMA_SIMD
-            for (auto k=kt; k<kend; ++k) {
-              PRAGMA_SIMD
-              for (auto j=jt; j<jend; ++j) {
-                C[i*order+j] += A[i*order+k] * B[k*order+j];
-              }
-            }
-          }
-        }
-      }
-    }
-}
+  std::cout << "Precision            = " << prk::precision_traits<T>::description << std::endl;
 
-int main(int argc, char * argv[])
-{
-  //////////////////////////////////////////////////////////////////////
-  /// Read and test input parameters
-  //////////////////////////////////////////////////////////////////////
-
-  std::cout << "Parallel Research Kernels version " << PRKVERSION << std::endl;
-  std::cout << "C++11 Dense matrix-matrix multiplication: C += A x B" << std::endl;
-
-  int iterations;
-  int order;
-  int tile_size;
-  try {
-      if (argc < 3) {
-        throw "Usage: <# iterations> <matrix order> [tile size]";
-      }
-
-      iterations  = std::atoi(argv[1]);
-      if (iterations < 1) {
-        throw "ERROR: iterations must be >= 1";
-      }
-
-      order = std::atoi(argv[2]);
-      if (order <= 0) {
-        throw "ERROR: Matrix Order must be greater than 0";
-      } else if (order > std::floor(std::sqrt(INT_MAX))) {
-        throw "ERROR: matrix dimension too large - overflow risk";
-      }
-
-      tile_size = (argc>3) ? std::atoi(argv[3]) : 32;
-      if (tile_size <= 0) tile_size = order;
-
-  }
-  catch (const char * e) {
-    std::cout << e << std::endl;
+  // the 16-bit types cannot hold the entries of C, so A and B are scaled by 1/order
+  const double scale = (sizeof(T) < sizeof(float)) ? 1.0/order : 1.0;
+  const double largest = 0.5*std::pow(order,3)*scale*scale*(iterations+1);
+  if (largest > prk::precision_traits<T>::max) {
+    std::cout << "ERROR: too many iterations for the range of " << prk::precision_traits<T>::name << std::endl;
     return 1;
   }
 
-  std::cout << "Number of iterations = " << iterations << std::endl;
-  std::cout << "Matrix order         = " << order << std::endl;
-  if (tile_size < order) {
-      std::cout << "Tile size            = " << tile_size << std::endl;
-  } else {
-      std::cout << "Untiled (IKJ loop order)" << std::endl;
-  }
-
   //////////////////////////////////////////////////////////////////////
   /// Allocate space for matrices
   //////////////////////////////////////////////////////////////////////
 
   double dgemm_time(0);
-
-  std::vector<double> A(order*order);
-  std::vector<double> B(order*order);
-  std::vector<double> C(order*order,0.0);
-  for (auto i=0; i<order; ++i) {
-    for (auto j=0; j<order; ++j) {
-       A[i*order+j] = i;
-       B[i*order+j] = i;
+  prk::counters counters;
+
+  std::vector<T> A(order*order);
+  std::vector<T> B(order*order);
+  std::vector<T> C(order*order,U(0));
+  for (int64_t i=0; i<order; ++i) {
+    for (int64_t j=0; j<order; ++j) {
+       A[i*order+j] = U(i*scale);
+       B[i*order+j] = U(i*scale);
     }
   }
 
+  // trials accumulate into C, which is reset afterwards
+  if (autotune) {
+    prk::autotune tuner("dgemm-vector", "order=" + std::to_string(order) + "," + prk::precision_traits<T>::name,
+                        {{"tile_size", 4, order}});
+    tile_size = tuner.tune([&] (const prk::autotune::point & p) {
+                             double t = prk::wtime();
+                             if (p[0] < order) {
+                                 prk_dgemm(order, p[0], A, B, C);
+                             } else {
+                                 prk_dgemm(order, A, B, C);
+                             }
+                             return prk::wtime() - t;
+                           })[0];
+    std::fill(C.begin(), C.end(), U(0));
+  }
+  if (tile_size < order) {
+      std::cout << "Tile size            = " << tile_size << std::endl;
+  } else {
+      std::cout << "Untiled (IKJ loop order)" << std::endl;
+  }
+
   {
     for (auto iter = 0; iter<=iterations; iter++) {
 
-      if (iter==1) dgemm_time = prk::wtime();
+      prk::cold::flush(counters, {A, B, C});
+
+      if (iter==1) {
+        dgemm_time = prk::wtime();
+        counters.start();
+        prk::cold::start();
+      }
 
       if (tile_size < order) {
           prk_dgemm(order, tile_size, A, B, C);
@@ -177,7 +138,8 @@ int main(int argc, char * argv[])
           prk_dgemm(order, A, B, C);
       }
     }
-    dgemm_time = prk::wtime() - dgemm_time;
+    dgemm_time = prk::wtime() - dgemm_time - prk::cold::elapsed();
+    counters.stop();
   }
 
   //////////////////////////////////////////////////////////////////////
@@ -185,10 +147,13 @@ int main(int argc, char * argv[])
   //////////////////////////////////////////////////////////////////////
 
   const auto forder = static_cast<double>(order);
-  const auto reference = 0.25 * std::pow(forder,3) * std::pow(forder-1.0,2) * (iterations+1);
-  const auto checksum = prk::reduce(C.begin(), C.end(), 0.0);
+  const auto reference = dgemm_reference(order, iterations, scale);
+  double checksum(0);
+  for (const auto c : C) {
+    checksum += static_cast<double>(c);
+  }
 
-  const auto epsilon = 1.0e-8;
+  const auto epsilon = prk::precision_traits<T>::epsilon;
   const auto residuum = std::abs(checksum-reference)/reference;
   if (residuum < epsilon) {
 #if VERBOSE
@@ -200,19 +165,22 @@ int main(int argc, char * argv[])
     auto nflops = 2.0 * std::pow(forder,3);
     std::cout << "Rate (MF/s): " << 1.0e-6 * nflops/avgtime
               << " Avg time (s): " << avgtime << std::endl;
+    const prk::work_model work{nflops, 4.0*forder*forder*sizeof(T)};
+    counters.print(iterations*work.bytes, iterations*work.flops);
+    prk::roofline::print(work, avgtime);
   } else {
     std::cout << "Reference checksum = " << reference << "\n"
               << "Actual checksum = " << checksum << std::endl;
 #if VERBOSE
-    for (auto i=0; i<order; ++i)
-      for (auto j=0; j<order; ++j)
-        std::cout << "A(" << i << "," << j << ") = " << A[i*order+j] << "\n";
-    for (auto i=0; i<order; ++i)
-      for (auto j=0; j<order; ++j)
-        std::cout << "B(" << i << "," << j << ") = " << B[i*order+j] << "\n";
-    for (auto i=0; i<order; ++i)
-      for (auto j=0; j<order; ++j)
-        std::cout << "C(" << i << "," << j << ") = " << C[i*order+j] << "\n";
+    for (int64_t i=0; i<order; ++i)
+      for (int64_t j=0; j<order; ++j)
+        std::cout << "A(" << i << "," << j << ") = " << static_cast<double>(A[i*order+j]) << "\n";
+    for (int64_t i=0; i<order; ++i)
+      for (int64_t j=0; j<order; ++j)
+        std::cout << "B(" << i << "," << j << ") = " << static_cast<double>(B[i*order+j]) << "\n";
+    for (int64_t i=0; i<order; ++i)
+      for (int64_t j=0; j<order; ++j)
+        std::cout << "C(" << i << "," << j << ") = " << static_cast<double>(C[i*order+j]) << "\n";
     std::cout << std::endl;
 #endif
     return 1;
@@ -221,4 +189,61 @@ int main(int argc, char * argv[])
   return 0;
 }
 
+int main(int argc, char * argv[])
+{
+  //////////////////////////////////////////////////////////////////////
+  /// Read and test input parameters
+  //////////////////////////////////////////////////////////////////////
+
+  std::cout << "Parallel Research Kernels version " << PRKVERSION << std::endl;
+  std::cout << "C++11 Dense matrix-matrix multiplication: C += A x B" << std::endl;
+
+  int iterations;
+  int64_t order;
+  int64_t tile_size;
+  bool autotune = false;
+  prk::precision precision;
+  try {
+      prk::cold::parse(argc, argv);
+
+      if (argc < 3) {
+        throw "Usage: <# iterations> <matrix order> [tile size|auto]";
+      }
+
+      iterations  = std::atoi(argv[1]);
+      if (iterations < 1) {
+        throw "ERROR: iterations must be >= 1";
+      }
+
+      order = std::atoll(argv[2]);
+      if (order <= 0) {
+        throw "ERROR: Matrix Order must be greater than 0";
+      } else if (order > std::floor(std::sqrt(INT64_MAX))) {
+        throw "ERROR: matrix dimension too large - overflow risk";
+      }
+
+      autotune = (argc>3) && std::string(argv[3]) == "auto";
+      tile_size = (argc>3 && !autotune) ? std::atoll(argv[3]) : 32;
+      if (tile_size <= 0) tile_size = order;
+
+      precision = prk::get_precision();
+  }
+  catch (const char * e) {
+    std::cout << e << std::endl;
+    return 1;
+  }
+
+  std::cout << "Number of iterations = " << iterations << std::endl;
+  prk::cold::print();
+  std::cout << "Matrix order         = " << order << std::endl;
+
+  switch (precision) {
+      case prk::precision::fp32: return dgemm<float>(iterations, order, tile_size, autotune);
+      case prk::precision::bf16: return dgemm<prk::bf16>(iterations, order, tile_size, autotune);
+      case prk::precision::fp16: return dgemm<prk::fp16>(iterations, order, tile_size, autotune);
+      default:                   return dgemm<double>(iterations, order, tile_size, autotune);
+  }
+}
+
+
 
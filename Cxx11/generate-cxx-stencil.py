@@ -33,17 +33,20 @@ def bodygen(src,pattern,stencil_size,radius,W,model):
                 if (model=='kokkos' or model=='rajaview'):
                     src.write('+in(i'+ir+',j'+jr+') * '+str(W[j][i]))
                 else:
-                    src.write('+in[(i'+ir+')*n+(j'+jr+')] * '+str(W[j][i]))
+                    if (model=='seq'):
+                        src.write('+in[(i'+ir+')*n+(j'+jr+')] * U('+str(W[j][i])+')')
+                    else:
+                        src.write('+in[(i'+ir+')*n+(j'+jr+')] * '+str(W[j][i]))
                 if (k<kmax): src.write('\n')
                 if (k>0 and k<kmax): src.write('                          ')
     src.write(';\n')
 
 def codegen(src,pattern,stencil_size,radius,W,model):
     if (model=='openmp'):
-        src.write('void '+pattern+str(radius)+'(const int n, const int t, const double * RESTRICT in, double * RESTRICT out) {\n')
+        src.write('void '+pattern+str(radius)+'(const int64_t n, const int64_t t, const double * RESTRICT in, double * RESTRICT out) {\n')
         src.write('    OMP_FOR(collapse(2))\n')
-        src.write('    for (auto it='+str(radius)+'; it<n-'+str(radius)+'; it+=t) {\n')
-        src.write('      for (auto jt='+str(radius)+'; jt<n-'+str(radius)+'; jt+=t) {\n')
+        src.write('    for (int64_t it='+str(radius)+'; it<n-'+str(radius)+'; it+=t) {\n')
+        src.write('      for (int64_t jt='+str(radius)+'; jt<n-'+str(radius)+'; jt+=t) {\n')
         src.write('        for (auto i=it; i<std::min(n-'+str(radius)+',it+t); ++i) {\n')
         src.write('          OMP_SIMD\n')
         src.write('          for (auto j=jt; j<std::min(n-'+str(radius)+',jt+t); ++j) {\n')
@@ -53,10 +56,11 @@ def codegen(src,pattern,stencil_size,radius,W,model):
         src.write('       }\n')
         src.write('     }\n')
     elif (model=='taskloop'):
-        src.write('void '+pattern+str(radius)+'(const int n, const int t, std::vector<double> & in, std::vector<double> & out, const int gs) {\n')
+        src.write('void '+pattern+str(radius)+'(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out, const int gs) {\n')
         src.write('    OMP_TASKLOOP_COLLAPSE(2, firstprivate(n) shared(in,out) grainsize(gs) )\n')
-        src.write('    for (auto it='+str(radius)+'; it<n-'+str(radius)+'; it+=t) {\n')
-        src.write('      for (auto jt='+str(radius)+'; jt<n-'+str(radius)+'; jt+=t) {\n')
+        src.write('    for (int64_t it='+str(radius)+'; it<n-'+str(radius)+'; it+=t) {\n')
+        src.write('      for (int64_t jt='+str(radius)+'; jt<n-'+str(radius)+'; jt+=t) {\n')
+        src.write('        PRK_TRACE_SCOPE("'+pattern+str(radius)+'", it, jt);\n')
         src.write('        for (auto i=it; i<std::min(n-'+str(radius)+',it+t); ++i) {\n')
         src.write('          OMP_SIMD\n')
         src.write('          for (auto j=jt; j<std::min(n-'+str(radius)+',jt+t); ++j) {\n')
@@ -66,15 +70,15 @@ def codegen(src,pattern,stencil_size,radius,W,model):
         src.write('       }\n')
         src.write('     }\n')
     elif (model=='target'):
-        src.write('void '+pattern+str(radius)+'(const int n, const int t, const double * RESTRICT in, double * RESTRICT out) {\n')
+        src.write('void '+pattern+str(radius)+'(const int64_t n, const int64_t t, const double * RESTRICT in, double * RESTRICT out) {\n')
         src.write('    OMP_TARGET( teams distribute parallel for simd collapse(2) schedule(static,1) )\n')
-        src.write('    for (auto i='+str(radius)+'; i<n-'+str(radius)+'; ++i) {\n')
-        src.write('      for (auto j='+str(radius)+'; j<n-'+str(radius)+'; ++j) {\n')
+        src.write('    for (int64_t i='+str(radius)+'; i<n-'+str(radius)+'; ++i) {\n')
+        src.write('      for (int64_t j='+str(radius)+'; j<n-'+str(radius)+'; ++j) {\n')
         bodygen(src,pattern,stencil_size,radius,W,model)
         src.write('       }\n')
         src.write('     }\n')
     elif (model=='rangefor'):
-        src.write('void '+pattern+str(radius)+'(const int n, const int t, std::vector<double> & in, std::vector<double> & out) {\n')
+        src.write('void '+pattern+str(radius)+'(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out) {\n')
         src.write('    auto inside = prk::range('+str(radius)+',n-'+str(radius)+');\n')
         src.write('    for (auto i : inside) {\n')
         src.write('      PRAGMA_SIMD\n')
@@ -85,32 +89,32 @@ def codegen(src,pattern,stencil_size,radius,W,model):
         src.write('       }\n')
         src.write('     }\n')
     elif (model=='stl'):
-        src.write('void '+pattern+str(radius)+'(const int n, const int t, std::vector<double> & in, std::vector<double> & out) {\n')
+        src.write('void '+pattern+str(radius)+'(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out) {\n')
         src.write('    auto inside = prk::range('+str(radius)+',n-'+str(radius)+');\n')
-        src.write('    std::for_each( std::begin(inside), std::end(inside), [&] (int i) {\n')
+        src.write('    std::for_each( std::begin(inside), std::end(inside), [&] (int64_t i) {\n')
         #src.write('      PRAGMA_SIMD\n')
-        src.write('      std::for_each( std::begin(inside), std::end(inside), [&] (int j) {\n')
+        src.write('      std::for_each( std::begin(inside), std::end(inside), [&] (int64_t j) {\n')
         bodygen(src,pattern,stencil_size,radius,W,model)
         src.write('      });\n')
         src.write('    });\n')
     elif (model=='pgnu'):
-        src.write('void '+pattern+str(radius)+'(const int n, const int t, std::vector<double> & in, std::vector<double> & out) {\n')
+        src.write('void '+pattern+str(radius)+'(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out) {\n')
         src.write('    auto inside = prk::range('+str(radius)+',n-'+str(radius)+');\n')
-        src.write('    __gnu_parallel::for_each( std::begin(inside), std::end(inside), [&] (int i) {\n')
-        src.write('      std::for_each( std::begin(inside), std::end(inside), [&] (int j) {\n')
+        src.write('    __gnu_parallel::for_each( std::begin(inside), std::end(inside), [&] (int64_t i) {\n')
+        src.write('      std::for_each( std::begin(inside), std::end(inside), [&] (int64_t j) {\n')
         bodygen(src,pattern,stencil_size,radius,W,model)
         src.write('      });\n')
         src.write('    });\n')
     elif (model=='pstl'):
-        src.write('void '+pattern+str(radius)+'(const int n, const int t, std::vector<double> & in, std::vector<double> & out) {\n')
+        src.write('void '+pattern+str(radius)+'(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out) {\n')
         src.write('    auto inside = prk::range('+str(radius)+',n-'+str(radius)+');\n')
-        src.write('    std::for_each( exec::par, std::begin(inside), std::end(inside), [&] (int i) {\n')
-        src.write('      std::for_each( exec::unseq, std::begin(inside), std::end(inside), [&] (int j) {\n')
+        src.write('    std::for_each( exec::par, std::begin(inside), std::end(inside), [&] (int64_t i) {\n')
+        src.write('      std::for_each( exec::unseq, std::begin(inside), std::end(inside), [&] (int64_t j) {\n')
         bodygen(src,pattern,stencil_size,radius,W,model)
         src.write('      });\n')
         src.write('    });\n')
     elif (model=='raja'):
-        src.write('void '+pattern+str(radius)+'(const int n, const int t, std::vector<double> & in, std::vector<double> & out) {\n')
+        src.write('void '+pattern+str(radius)+'(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out) {\n')
         #src.write('    RAJA::forallN<RAJA::NestedPolicy<RAJA::ExecList<thread_exec, RAJA::simd_exec>>>\n')
         #src.write('            ( RAJA::RangeSegment('+str(radius)+',n-'+str(radius)+'),'
         #                        'RAJA::RangeSegment('+str(radius)+',n-'+str(radius)+'),\n')
@@ -121,15 +125,15 @@ def codegen(src,pattern,stencil_size,radius,W,model):
         src.write('      });\n')
         src.write('    });\n')
     elif (model=='rajaview'):
-        src.write('void '+pattern+str(radius)+'(const int n, const int t, matrix & in, matrix & out) {\n')
+        src.write('void '+pattern+str(radius)+'(const int64_t n, const int64_t t, matrix & in, matrix & out) {\n')
         src.write('    RAJA::RangeSegment inner1('+str(radius)+',n-'+str(radius)+');\n')
         src.write('    auto inner2 = RAJA::make_tuple(inner1, inner1);\n')
-        src.write('    RAJA::kernel<regular_policy>(inner2, [=](int i, int j) {\n')
+        src.write('    RAJA::kernel<regular_policy>(inner2, [=](RAJA::Index_type i, RAJA::Index_type j) {\n')
         bodygen(src,pattern,stencil_size,radius,W,model)
         src.write('    });\n')
     elif (model=='tbb'):
-        src.write('void '+pattern+str(radius)+'(const int n, const int t, std::vector<double> & in, std::vector<double> & out) {\n')
-        src.write('  tbb::blocked_range2d<int> range('+str(radius)+', n-'+str(radius)+', t, '+str(radius)+', n-'+str(radius)+', t);\n')
+        src.write('void '+pattern+str(radius)+'(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out) {\n')
+        src.write('  tbb::blocked_range2d<int64_t> range('+str(radius)+', n-'+str(radius)+', t, '+str(radius)+', n-'+str(radius)+', t);\n')
         src.write('  tbb::parallel_for( range, [&](decltype(range)& r ) {\n')
         src.write('    for (auto i=r.rows().begin(); i!=r.rows().end(); ++i ) {\n')
         src.write('      PRAGMA_SIMD\n')
@@ -139,25 +143,28 @@ def codegen(src,pattern,stencil_size,radius,W,model):
         src.write('    }\n')
         src.write('  }, tbb_partitioner );\n')
     elif (model=='kokkos'):
-        src.write('void '+pattern+str(radius)+'(const int n, const int t, matrix & in, matrix & out) {\n')
+        src.write('void '+pattern+str(radius)+'(const int64_t n, const int64_t t, matrix & in, matrix & out) {\n')
         src.write('    auto inside = Kokkos::MDRangePolicy<Kokkos::Rank<2>>({'+str(radius)+','+str(radius)+'},{n-'+str(radius)+',n-'+str(radius)+'},{t,t});\n')
-        src.write('    Kokkos::parallel_for(inside, KOKKOS_LAMBDA(int i, int j) {\n')
+        src.write('    Kokkos::parallel_for(inside, KOKKOS_LAMBDA(int64_t i, int64_t j) {\n')
         bodygen(src,pattern,stencil_size,radius,W,model)
         src.write('    });\n')
     elif (model=='cuda'):
-        src.write('__global__ void '+pattern+str(radius)+'(const int n, const prk_float * in, prk_float * out) {\n')
+        src.write('__global__ void '+pattern+str(radius)+'(const int64_t n, const prk_float * in, prk_float * out) {\n')
         src.write('    const int i = blockIdx.x * blockDim.x + threadIdx.x;\n')
         src.write('    const int j = blockIdx.y * blockDim.y + threadIdx.y;\n')
         src.write('    if ( ('+str(radius)+' <= i) && (i < n-'+str(radius)+') && ('+str(radius)+' <= j) && (j < n-'+str(radius)+') ) {\n')
         bodygen(src,pattern,stencil_size,radius,W,model)
         src.write('     }\n')
     else:
-        src.write('void '+pattern+str(radius)+'(const int n, const int t, std::vector<double> & in, std::vector<double> & out) {\n')
-        src.write('    for (auto it='+str(radius)+'; it<n-'+str(radius)+'; it+=t) {\n')
-        src.write('      for (auto jt='+str(radius)+'; jt<n-'+str(radius)+'; jt+=t) {\n')
+        src.write('template <typename T>\n')
+        src.write('void '+pattern+str(radius)+'(const int64_t n, const int64_t t, std::vector<T> & in, std::vector<T> & out) {\n')
+        src.write('    using U = typename prk::precision_traits<T>::compute;\n')
+        src.write('    for (int64_t it='+str(radius)+'; it<n-'+str(radius)+'; it+=t) {\n')
+        src.write('      for (int64_t jt='+str(radius)+'; jt<n-'+str(radius)+'; jt+=t) {\n')
         src.write('        for (auto i=it; i<std::min(n-'+str(radius)+',it+t); ++i) {\n')
+        src.write('          const auto jend = std::min(n-'+str(radius)+',jt+t);\n')
         src.write('          PRAGMA_SIMD\n')
-        src.write('          for (auto j=jt; j<std::min(n-'+str(radius)+',jt+t); ++j) {\n')
+        src.write('          for (auto j=jt; j<jend; ++j) {\n')
         bodygen(src,pattern,stencil_size,radius,W,model)
         src.write('           }\n')
         src.write('         }\n')
@@ -57,10 +57,10 @@ def main(precision):
         t = 'double'
         src = open(pattern+str(r)+'.cl','a')
         src.write('#pragma OPENCL EXTENSION cl_khr_fp64 : enable\n\n')
-    src.write('__kernel void '+pattern+str(r)+'_'+str(precision)+'(const int n, __global const '+t+' * in, __global '+t+' * out)\n')
+    src.write('__kernel void '+pattern+str(r)+'_'+str(precision)+'(const long n, __global const '+t+' * in, __global '+t+' * out)\n')
     src.write('{\n')
-    src.write('    const int i = get_global_id(0);\n')
-    src.write('    const int j = get_global_id(1);\n')
+    src.write('    const long i = get_global_id(0);\n')
+    src.write('    const long j = get_global_id(1);\n')
     src.write('    if ( ('+str(r)+' <= i) && (i < n-'+str(r)+') && ('+str(r)+' <= j) && (j < n-'+str(r)+') ) {\n')
     src.write('        out[i*n+j] += ')
     k = 0
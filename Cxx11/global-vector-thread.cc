@@ -0,0 +1,256 @@
+///
+/// Copyright (c) 2013, Intel Corporation
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions
+/// are met:
+///
+/// * Redistributions of source code must retain the above copyright
+///       notice, this list of conditions and the following disclaimer.
+/// * Redistributions in binary form must reproduce the above
+///       copyright notice, this list of conditions and the following
+///       disclaimer in the documentation and/or other materials provided
+///       with the distribution.
+/// * Neither the name of Intel Corporation nor the names of its
+///       contributors may be used to endorse or promote products
+///       derived from this software without specific prior written
+///       permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+/// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+/// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+/// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+/// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+/// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+/// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+/// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+/// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+/// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+
+//////////////////////////////////////////////////////////////////////
+///
+/// NAME:    StopNGo
+///
+/// PURPOSE: This program tests the efficiency of a global synchronization
+///          on the target system.
+///
+/// USAGE:   The program takes as input the maximum number of threads, the
+///          number of times the test of string manipulation involving a
+///          global synchronization is carried out, the length of the
+///          string, and optionally the barrier algorithm:
+///
+///          <progname> <# threads> <# iterations> <length of numerical string>
+///                     [<barrier>]
+///
+///          central       - centralized sense-reversing barrier.
+///          dissemination - dissemination barrier.
+///          tournament    - tournament barrier.
+///          futex         - blocking barrier that sleeps in the kernel.
+///          all           - run all of the above in turn (default).
+///
+///          The test is run with 1, 2, 4, ... threads up to the maximum.
+///          The string length must be a multiple of every thread count.
+///
+///          The output consists of diagnostics to make sure the
+///          algorithm worked, and of timing statistics, including the
+///          latency of one barrier for each algorithm and thread count.
+///
+/// FUNCTIONS CALLED:
+///
+///          Other than standard C functions, the following functions are used in
+///          this program:
+///          wtime()
+///          chartoi()
+///
+/// HISTORY: Written by Rob Van der Wijngaart, December 2005.
+///          C++11-ification with pluggable prk:: barriers, 2018.
+///
+//////////////////////////////////////////////////////////////////////
+
+#include "prk_util.h"
+#include "prk_barrier.h"
+#include "prk_affinity.h"
+
+#include <thread>
+
+static int chartoi(char c)
+{
+    return c - '0';
+}
+
+// Run the StopNGo test on nthread threads; returns the elapsed time and
+// leaves the concatenated string in catstring.
+template <typename Barrier>
+double stopngo(int nthread, int iterations, const std::string & basestring, std::string & catstring,
+               const prk::affinity & affinity)
+{
+    const size_t length = catstring.size();
+    const size_t thread_length = length/nthread;
+
+    Barrier barrier(nthread);
+    double stopngo_time = 0.0;
+
+    std::vector<std::thread> pool;
+    for (int my_ID=0; my_ID<nthread; my_ID++) {
+      pool.push_back(std::thread([=,&barrier,&catstring,&basestring,&stopngo_time,&affinity] {
+
+        affinity.pin(my_ID);
+
+        // everybody receives a private copy of the part of the base string
+        std::string iterstring(basestring, 0, thread_length);
+
+        barrier.wait(my_ID);
+        if (my_ID==0) stopngo_time = prk::wtime();
+
+        for (int iter=0; iter<iterations; iter++) {
+          // we need a barrier to avoid reading catstring before it is complete
+          barrier.wait(my_ID);
+          // glue all private strings together
+          std::copy(iterstring.begin(), iterstring.end(), catstring.begin()+my_ID*thread_length);
+          // synchronize so we can read the consistent concatenated string
+          barrier.wait(my_ID);
+          // now all threads select different, nonoverlapping substring
+          for (size_t i=0; i<thread_length; i++) iterstring[i] = catstring[my_ID+i*nthread];
+        }
+
+        barrier.wait(my_ID);
+        if (my_ID==0) stopngo_time = prk::wtime() - stopngo_time;
+      }));
+    }
+    std::for_each(pool.begin(), pool.end(), [](std::thread & t) { t.join(); });
+
+    return stopngo_time;
+}
+
+int main(int argc, char * argv[])
+{
+  std::cout << "Parallel Research Kernels version " << PRKVERSION << std::endl;
+  std::cout << "C++11/Threads global synchronization test" << std::endl;
+
+  //////////////////////////////////////////////////////////////////////
+  // Read and test input parameters
+  //////////////////////////////////////////////////////////////////////
+
+  int max_threads;
+  int iterations;
+  size_t length;
+  std::string barrier("all");
+  prk::affinity affinity;
+  try {
+      if (argc < 4) {
+        throw "Usage: <# threads> <# iterations> <scramble string length> "
+              "[<central/dissemination/tournament/futex/all>]";
+      }
+
+      max_threads = std::atoi(argv[1]);
+      if (max_threads < 1) {
+        throw "ERROR: number of threads must be positive";
+      }
+
+      iterations = std::atoi(argv[2]);
+      if (iterations < 1) {
+        throw "ERROR: iterations must be >= 1";
+      }
+
+      length = std::atol(argv[3]);
+      if (std::atol(argv[3]) < max_threads || length%max_threads != 0) {
+        throw "ERROR: length of string must be multiple of # threads";
+      }
+
+      if (argc > 4) {
+        barrier = std::string(argv[4]);
+        if (barrier != "central" && barrier != "dissemination" &&
+            barrier != "tournament" && barrier != "futex" && barrier != "all") {
+          throw "ERROR: barrier must be one of central, dissemination, tournament, futex or all";
+        }
+      }
+
+      affinity = prk::get_affinity();
+  }
+  catch (const char * e) {
+    std::cout << e << std::endl;
+    return 1;
+  }
+
+  std::cout << "Number of threads (max)   = " << max_threads << std::endl;
+  std::cout << "Length of scramble string = " << length << std::endl;
+  std::cout << "Number of iterations      = " << iterations << std::endl;
+  std::cout << "Barrier type              = " << barrier << std::endl;
+  affinity.print(max_threads);
+
+  //////////////////////////////////////////////////////////////////////
+  // Allocate space and perform the computation
+  //////////////////////////////////////////////////////////////////////
+
+  // fill the base string with copies (truncated) of scramble string
+  const std::string scramble("27638472638746283742712311207892");
+  std::string basestring(length,'0');
+  for (size_t i=0; i<length; i++) basestring[i] = scramble[i%32];
+
+  std::vector<std::string> barriers;
+  if (barrier == "all") {
+    barriers = {"central", "dissemination", "tournament", "futex"};
+  } else {
+    barriers.push_back(barrier);
+  }
+
+  std::vector<int> thread_counts;
+  for (int t=1; t<max_threads; t*=2) {
+    if (length%t == 0) thread_counts.push_back(t);
+  }
+  thread_counts.push_back(max_threads);
+
+  bool validate = true;
+
+  for (auto & b : barriers) {
+    for (auto nthread : thread_counts) {
+
+      // initialize concatenation string with nonsense
+      std::string catstring(length,'9');
+
+      double stopngo_time = 0.0;
+      if (b == "central") {
+        stopngo_time = stopngo<prk::central_barrier>(nthread, iterations, basestring, catstring, affinity);
+      } else if (b == "dissemination") {
+        stopngo_time = stopngo<prk::dissemination_barrier>(nthread, iterations, basestring, catstring, affinity);
+      } else if (b == "tournament") {
+        stopngo_time = stopngo<prk::tournament_barrier>(nthread, iterations, basestring, catstring, affinity);
+      } else if (b == "futex") {
+        stopngo_time = stopngo<prk::futex_barrier>(nthread, iterations, basestring, catstring, affinity);
+      }
+
+      //////////////////////////////////////////////////////////////////////
+      /// Analyze and output results
+      //////////////////////////////////////////////////////////////////////
+
+      // compute checksum on obtained result, adding all digits in the string
+      const size_t thread_length = length/nthread;
+      int basesum = 0;
+      for (size_t i=0; i<thread_length; i++) basesum += chartoi(basestring[i]);
+      int checksum = 0;
+      for (auto c : catstring) checksum += chartoi(c);
+
+      if (checksum != basesum*nthread) {
+        std::cout << "ERROR: " << b << " threads=" << nthread << " incorrect checksum: "
+                  << checksum << " instead of " << basesum*nthread << std::endl;
+        validate = false;
+      } else {
+        // two barriers per iteration
+        const double latency = stopngo_time/(2.0*iterations);
+        std::cout << "Rate (synch/s) " << b << " threads=" << nthread << ": "
+                  << iterations/stopngo_time << " time (s): " << stopngo_time
+                  << " barrier latency (us): " << 1.0e6*latency << std::endl;
+      }
+    }
+  }
+
+  if (!validate) {
+    std::cout << "Solution does not validate" << std::endl;
+    return 1;
+  }
+  std::cout << "Solution validates" << std::endl;
+
+  return 0;
+}
@@ -77,7 +77,7 @@ int main(int argc, char * argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations, offset;
-  int length;
+  size_t length;
   try {
       if (argc < 3) {
         throw "Usage: <# iterations> <vector length> [<offset>]";
@@ -88,9 +88,11 @@ int main(int argc, char * argv[])
         throw "ERROR: iterations must be >= 1";
       }
 
-      length = std::atoi(argv[2]);
+      length = std::atol(argv[2]);
       if (length <= 0) {
         throw "ERROR: vector length must be positive";
+      } else if (length > INT_MAX) {
+        throw "ERROR: vector length exceeds the BLAS integer range";
       }
 
       offset = (argc>3) ? std::atoi(argv[3]) : 0;
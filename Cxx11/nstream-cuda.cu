@@ -64,9 +64,9 @@
 #include "prk_util.h"
 #include "prk_cuda.h"
 
-__global__ void nstream(const unsigned n, const prk_float scalar, prk_float * A, const prk_float * B, const prk_float * C)
+__global__ void nstream(const size_t n, const prk_float scalar, prk_float * A, const prk_float * B, const prk_float * C)
 {
-    unsigned i = blockIdx.x * blockDim.x + threadIdx.x;
+    size_t i = blockIdx.x * blockDim.x + threadIdx.x;
     if (i < n) {
         A[i] += B[i] + scalar * C[i];
     }
@@ -85,7 +85,7 @@ int main(int argc, char * argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations, offset;
-  int length;
+  size_t length;
   try {
       if (argc < 3) {
         throw "Usage: <# iterations> <vector length> [<offset>]";
@@ -96,7 +96,7 @@ int main(int argc, char * argv[])
         throw "ERROR: iterations must be >= 1";
       }
 
-      length = std::atoi(argv[2]);
+      length = std::atol(argv[2]);
       if (length <= 0) {
         throw "ERROR: vector length must be positive";
       }
@@ -140,7 +140,7 @@ int main(int argc, char * argv[])
   h_B = new prk_float[length];
   h_C = new prk_float[length];
 #endif
-  for (auto i=0; i<length; ++i) {
+  for (size_t i=0; i<length; ++i) {
     h_A[i] = static_cast<prk_float>(0);
     h_B[i] = static_cast<prk_float>(2);
     h_C[i] = static_cast<prk_float>(2);
@@ -162,7 +162,7 @@ int main(int argc, char * argv[])
 
       if (iter==1) nstream_time = prk::wtime();
 
-      nstream<<<dimGrid, dimBlock>>>(static_cast<unsigned>(length), scalar, d_A, d_B, d_C);
+      nstream<<<dimGrid, dimBlock>>>(length, scalar, d_A, d_B, d_C);
 #ifndef __CORIANDERCC__
       // silence "ignoring cudaDeviceSynchronize for now" warning
       prk::CUDA::check( cudaDeviceSynchronize() );
@@ -196,7 +196,7 @@ int main(int argc, char * argv[])
   ar *= length;
 
   double asum(0);
-  for (auto i=0; i<length; i++) {
+  for (size_t i=0; i<length; i++) {
       asum += std::fabs(h_A[i]);
   }
 
@@ -0,0 +1,86 @@
+///
+/// Copyright (c) 2018, Intel Corporation
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions
+/// are met:
+///
+/// * Redistributions of source code must retain the above copyright
+///       notice, this list of conditions and the following disclaimer.
+/// * Redistributions in binary form must reproduce the above
+///       copyright notice, this list of conditions and the following
+///       disclaimer in the documentation and/or other materials provided
+///       with the distribution.
+/// * Neither the name of Intel Corporation nor the names of its
+///       contributors may be used to endorse or promote products
+///       derived from this software without specific prior written
+///       permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+/// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+/// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+/// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+/// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+/// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+/// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+/// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+/// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+/// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef NSTREAM_KERNEL_H
+#define NSTREAM_KERNEL_H
+
+#include "prk_openmp.h"
+
+#define RESTRICT __restrict__
+
+// The STREAM triad of nstream-openmp and prk-suite.  The loops are
+// orphaned worksharing constructs, like the stencils in stencil_openmp.hpp,
+// so they are called from inside a parallel region.
+
+inline void nstream_init(size_t length, double * RESTRICT A, double * RESTRICT B, double * RESTRICT C)
+{
+    OMP_FOR_SIMD
+    for (size_t i=0; i<length; i++) {
+      A[i] = 0.0;
+      B[i] = 2.0;
+      C[i] = 2.0;
+    }
+}
+
+inline void nstream_triad(size_t length, double scalar,
+                          double * RESTRICT A, const double * RESTRICT B, const double * RESTRICT C)
+{
+    OMP_FOR_SIMD
+    for (size_t i=0; i<length; i++) {
+        A[i] += B[i] + scalar * C[i];
+    }
+}
+
+// The sum of |A| after iterations+1 triads, and what it should be.
+// These are called outside of a parallel region.
+
+inline double nstream_reference(int iterations, size_t length, double scalar)
+{
+    double ar(0);
+    double br(2);
+    double cr(2);
+    for (auto i=0; i<=iterations; i++) {
+        ar += br + scalar * cr;
+    }
+    return ar * length;
+}
+
+inline double nstream_checksum(size_t length, const double * RESTRICT A)
+{
+    double asum(0);
+    OMP_PARALLEL_FOR_REDUCE( +:asum )
+    for (size_t i=0; i<length; i++) {
+        asum += std::fabs(A[i]);
+    }
+    return asum;
+}
+
+#endif /* NSTREAM_KERNEL_H */
@@ -63,6 +63,7 @@
 //////////////////////////////////////////////////////////////////////
 
 #include "prk_util.h"
+#include "nstream-kernel.h"
 
 int main(int argc, char * argv[])
 {
@@ -116,6 +117,7 @@ int main(int argc, char * argv[])
   //////////////////////////////////////////////////////////////////////
 
   auto nstream_time = 0.0;
+  prk::counters counters;
 
   double * RESTRICT A = new double[length];
   double * RESTRICT B = new double[length];
@@ -125,12 +127,9 @@ int main(int argc, char * argv[])
 
   OMP_PARALLEL()
   {
-    OMP_FOR_SIMD
-    for (size_t i=0; i<length; i++) {
-      A[i] = 0.0;
-      B[i] = 2.0;
-      C[i] = 2.0;
-    }
+    prk::counters mine;
+
+    nstream_init(length, A, B, C);
 
     for (auto iter = 0; iter<=iterations; iter++) {
 
@@ -138,36 +137,25 @@ int main(int argc, char * argv[])
           OMP_BARRIER
           OMP_MASTER
           nstream_time = prk::wtime();
+          mine.start();
       }
 
-      OMP_FOR_SIMD
-      for (size_t i=0; i<length; i++) {
-          A[i] += B[i] + scalar * C[i];
-      }
+      nstream_triad(length, scalar, A, B, C);
     }
     OMP_BARRIER
+    mine.stop();
     OMP_MASTER
     nstream_time = prk::wtime() - nstream_time;
+    OMP(critical)
+    counters += mine;
   }
 
   //////////////////////////////////////////////////////////////////////
   /// Analyze and output results
   //////////////////////////////////////////////////////////////////////
 
-  double ar(0);
-  double br(2);
-  double cr(2);
-  for (auto i=0; i<=iterations; i++) {
-      ar += br + scalar * cr;
-  }
-
-  ar *= length;
-
-  double asum(0);
-  OMP_PARALLEL_FOR_REDUCE( +:asum )
-  for (size_t i=0; i<length; i++) {
-      asum += std::fabs(A[i]);
-  }
+  const double ar = nstream_reference(iterations, length, scalar);
+  const double asum = nstream_checksum(length, A);
 
   double epsilon=1.e-8;
   if (std::fabs(ar-asum)/asum > epsilon) {
@@ -182,6 +170,9 @@ int main(int argc, char * argv[])
       double nbytes = 4.0 * length * sizeof(double);
       std::cout << "Rate (MB/s): " << 1.e-6*nbytes/avgtime
                 << " Avg time (s): " << avgtime << std::endl;
+      const prk::work_model work{2.0*length, nbytes};
+      counters.print(iterations*work.bytes, iterations*work.flops);
+      prk::roofline::print(work, avgtime);
   }
 
   return 0;
@@ -157,6 +157,8 @@ int main(int argc, char * argv[])
       double nbytes = 4.0 * length * sizeof(double);
       std::cout << "Rate (MB/s): " << 1.e-6*nbytes/avgtime
                 << " Avg time (s): " << avgtime << std::endl;
+      const prk::work_model work{2.0*length, nbytes};
+      prk::roofline::print(work, avgtime);
   }
 
   return 0;
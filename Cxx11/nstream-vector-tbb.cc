@@ -64,6 +64,7 @@
 
 #include "prk_util.h"
 #include "prk_tbb.h"
+#include "prk_affinity.h"
 
 int main(int argc, char * argv[])
 {
@@ -76,6 +77,7 @@ int main(int argc, char * argv[])
 
   int iterations, offset;
   size_t length;
+  prk::affinity affinity;
   try {
       if (argc < 3) {
         throw "Usage: <# iterations> <vector length>";
@@ -95,6 +97,8 @@ int main(int argc, char * argv[])
       if (length <= 0) {
         throw "ERROR: offset must be nonnegative";
       }
+
+      affinity = prk::get_affinity();
   }
   catch (const char * e) {
     std::cout << e << std::endl;
@@ -104,8 +108,10 @@ int main(int argc, char * argv[])
   const char* envvar = std::getenv("TBB_NUM_THREADS");
   int num_threads = (envvar!=NULL) ? std::atoi(envvar) : tbb::task_scheduler_init::default_num_threads();
   tbb::task_scheduler_init init(num_threads);
+  prk::affinity_observer observer(affinity);
 
   std::cout << "Number of threads    = " << num_threads << std::endl;
+  affinity.print(num_threads);
   std::cout << "Number of iterations = " << iterations << std::endl;
   std::cout << "Vector length        = " << length << std::endl;
   std::cout << "Offset               = " << offset << std::endl;
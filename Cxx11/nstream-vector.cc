@@ -51,6 +51,8 @@
 ///          number of words written, times the size of the words, divided
 ///          by the execution time. For a vector length of N, the total
 ///          number of words read and written is 4*N*sizeof(double).
+///          The element type is chosen with PRK_PRECISION (see prk_types.h),
+///          and the word size is that of the element type.
 ///
 /// HISTORY: This code is loosely based on the Stream benchmark by John
 ///          McCalpin, but does not follow all the Stream rules. Hence,
@@ -63,68 +65,51 @@
 
 #include "prk_util.h"
 
-int main(int argc, char * argv[])
+template <typename T>
+int nstream(int iterations, size_t length)
 {
-  std::cout << "Parallel Research Kernels version " << PRKVERSION << std::endl;
-  std::cout << "C++11 STREAM triad: A = B + scalar * C" << std::endl;
-
-  //////////////////////////////////////////////////////////////////////
-  /// Read and test input parameters
-  //////////////////////////////////////////////////////////////////////
-
-  int iterations, offset;
-  size_t length;
-  try {
-      if (argc < 3) {
-        throw "Usage: <# iterations> <vector length> [<offset>]";
-      }
-
-      iterations  = std::atoi(argv[1]);
-      if (iterations < 1) {
-        throw "ERROR: iterations must be >= 1";
-      }
+  using U = typename prk::precision_traits<T>::compute;
 
-      length = std::atol(argv[2]);
-      if (length <= 0) {
-        throw "ERROR: vector length must be positive";
-      }
+  std::cout << "Precision            = " << prk::precision_traits<T>::description << std::endl;
 
-      offset = (argc>3) ? std::atoi(argv[3]) : 0;
-      if (length <= 0) {
-        throw "ERROR: offset must be nonnegative";
-      }
-  }
-  catch (const char * e) {
-    std::cout << e << std::endl;
+  // A gains 2+3*2 per iteration; once that stops being exact, narrow types
+  // round the increment away and A stalls instead of failing gracefully
+  if ((iterations+1.)*(2.+3.*2.) > prk::precision_traits<T>::exact) {
+    std::cout << "ERROR: too many iterations for exact arithmetic in "
+              << prk::precision_traits<T>::name << std::endl;
     return 1;
   }
 
-  std::cout << "Number of iterations = " << iterations << std::endl;
-  std::cout << "Vector length        = " << length << std::endl;
-  std::cout << "Offset               = " << offset << std::endl;
-
   //////////////////////////////////////////////////////////////////////
   // Allocate space and perform the computation
   //////////////////////////////////////////////////////////////////////
 
   auto nstream_time = 0.0;
+  prk::counters counters;
 
-  std::vector<double> A(length,0.0);
-  std::vector<double> B(length,2.0);
-  std::vector<double> C(length,2.0);
+  std::vector<T> A(length,U(0));
+  std::vector<T> B(length,U(2));
+  std::vector<T> C(length,U(2));
 
-  double scalar = 3.0;
+  const U scalar(3);
 
   {
     for (auto iter = 0; iter<=iterations; iter++) {
 
-      if (iter==1) nstream_time = prk::wtime();
+      prk::cold::flush(counters, {A, B, C});
+
+      if (iter==1) {
+        nstream_time = prk::wtime();
+        counters.start();
+        prk::cold::start();
+      }
 
       for (size_t i=0; i<length; i++) {
           A[i] += B[i] + scalar * C[i];
       }
     }
-    nstream_time = prk::wtime() - nstream_time;
+    nstream_time = prk::wtime() - nstream_time - prk::cold::elapsed();
+    counters.stop();
   }
 
   //////////////////////////////////////////////////////////////////////
@@ -142,10 +127,10 @@ int main(int argc, char * argv[])
 
   double asum(0);
   for (size_t i=0; i<length; i++) {
-      asum += std::fabs(A[i]);
+      asum += std::fabs(static_cast<double>(A[i]));
   }
 
-  double epsilon=1.e-8;
+  double epsilon = prk::precision_traits<T>::epsilon;
   if (std::fabs(ar-asum)/asum > epsilon) {
       std::cout << "Failed Validation on output array\n"
                 << "       Expected checksum: " << ar << "\n"
@@ -155,12 +140,67 @@ int main(int argc, char * argv[])
   } else {
       std::cout << "Solution validates" << std::endl;
       double avgtime = nstream_time/iterations;
-      double nbytes = 4.0 * length * sizeof(double);
+      double nbytes = 4.0 * length * sizeof(T);
       std::cout << "Rate (MB/s): " << 1.e-6*nbytes/avgtime
                 << " Avg time (s): " << avgtime << std::endl;
+      const prk::work_model work{2.0*length, nbytes};
+      counters.print(iterations*work.bytes, iterations*work.flops);
+      prk::roofline::print(work, avgtime);
   }
 
   return 0;
 }
 
+int main(int argc, char * argv[])
+{
+  std::cout << "Parallel Research Kernels version " << PRKVERSION << std::endl;
+  std::cout << "C++11 STREAM triad: A = B + scalar * C" << std::endl;
 
+  //////////////////////////////////////////////////////////////////////
+  /// Read and test input parameters
+  //////////////////////////////////////////////////////////////////////
+
+  int iterations, offset;
+  size_t length;
+  prk::precision precision;
+  try {
+      prk::cold::parse(argc, argv);
+
+      if (argc < 3) {
+        throw "Usage: <# iterations> <vector length> [<offset>]";
+      }
+
+      iterations  = std::atoi(argv[1]);
+      if (iterations < 1) {
+        throw "ERROR: iterations must be >= 1";
+      }
+
+      length = std::atol(argv[2]);
+      if (length <= 0) {
+        throw "ERROR: vector length must be positive";
+      }
+
+      offset = (argc>3) ? std::atoi(argv[3]) : 0;
+      if (length <= 0) {
+        throw "ERROR: offset must be nonnegative";
+      }
+
+      precision = prk::get_precision();
+  }
+  catch (const char * e) {
+    std::cout << e << std::endl;
+    return 1;
+  }
+
+  std::cout << "Number of iterations = " << iterations << std::endl;
+  prk::cold::print();
+  std::cout << "Vector length        = " << length << std::endl;
+  std::cout << "Offset               = " << offset << std::endl;
+
+  switch (precision) {
+      case prk::precision::fp32: return nstream<float>(iterations, length);
+      case prk::precision::bf16: return nstream<prk::bf16>(iterations, length);
+      case prk::precision::fp16: return nstream<prk::fp16>(iterations, length);
+      default:                   return nstream<double>(iterations, length);
+  }
+}
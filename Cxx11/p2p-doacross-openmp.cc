@@ -76,8 +76,8 @@ int main(int argc, char* argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int m, n;
-  int mc, nc;
+  int64_t m, n;
+  int64_t mc, nc;
   try {
       if (argc < 4){
         throw " <# iterations> <first array dimension> <second array dimension> [<first chunk dimension> <second chunk dimension>]";
@@ -90,17 +90,17 @@ int main(int argc, char* argv[])
       }
 
       // grid dimensions
-      m = std::atoi(argv[2]);
-      n = std::atoi(argv[3]);
+      m = std::atoll(argv[2]);
+      n = std::atoll(argv[3]);
       if (m < 1 || n < 1) {
         throw "ERROR: grid dimensions must be positive";
-      } else if ( static_cast<size_t>(m)*static_cast<size_t>(n) > INT_MAX) {
+      } else if ( static_cast<double>(m)*static_cast<double>(n) > INT64_MAX) {
         throw "ERROR: grid dimension too large - overflow risk";
       }
 
       // grid chunk dimensions
-      mc = (argc > 4) ? std::atoi(argv[4]) : m;
-      nc = (argc > 5) ? std::atoi(argv[5]) : n;
+      mc = (argc > 4) ? std::atoll(argv[4]) : m;
+      nc = (argc > 5) ? std::atoll(argv[5]) : n;
       if (mc < 1 || mc > m || nc < 1 || nc > n) {
         std::cout << "WARNING: grid chunk dimensions invalid: " << mc <<  nc << " (ignoring)" << std::endl;
         mc = m;
@@ -130,25 +130,25 @@ int main(int argc, char* argv[])
   OMP_PARALLEL()
   {
     OMP_FOR()
-    for (int i=0; i<n; i++) {
-      for (int j=0; j<n; j++) {
+    for (int64_t i=0; i<m; i++) {
+      for (int64_t j=0; j<n; j++) {
         grid[i*n+j] = 0.0;
       }
     }
 
     OMP_MASTER
     {
-      for (auto j=0; j<n; j++) {
+      for (int64_t j=0; j<n; j++) {
         grid[0*n+j] = static_cast<double>(j);
       }
-      for (auto i=0; i<m; i++) {
+      for (int64_t i=0; i<m; i++) {
         grid[i*n+0] = static_cast<double>(i);
       }
     }
     OMP_BARRIER
 
-    int const ib = prk::divceil(m,mc);
-    int const jb = prk::divceil(n,nc);
+    int64_t const ib = prk::divceil(m,mc);
+    int64_t const jb = prk::divceil(n,nc);
 
     for (int iter = 0; iter<=iterations; iter++) {
 
@@ -160,8 +160,8 @@ int main(int argc, char* argv[])
 
       if (mc==m && nc==n) {
         OMP_FOR( collapse(2) ordered(2) )
-        for (int i=1; i<m; i++) {
-          for (int j=1; j<n; j++) {
+        for (int64_t i=1; i<m; i++) {
+          for (int64_t j=1; j<n; j++) {
             OMP_ORDERED( depend(sink: i-1,j) depend(sink: i,j-1) )
             grid[i*n+j] = grid[(i-1)*n+j] + grid[i*n+(j-1)] - grid[(i-1)*n+(j-1)];
             OMP_ORDERED( depend (source) )
@@ -169,8 +169,8 @@ int main(int argc, char* argv[])
         }
       } else {
         OMP_FOR( collapse(2) ordered(2) )
-        for (int i=0; i<ib; i++) {
-          for (int j=0; j<jb; j++) {
+        for (int64_t i=0; i<ib; i++) {
+          for (int64_t j=0; j<jb; j++) {
             OMP_ORDERED( depend(sink: i-1,j) depend(sink: i,j-1) )
             sweep_tile(i*mc+1, std::min(m,(i+1)*mc+1), j*nc+1, std::min(n,(j+1)*nc+1), n, grid);
             OMP_ORDERED( depend (source) )
@@ -206,6 +206,8 @@ int main(int argc, char* argv[])
   std::cout << "Rate (MFlops/s): "
             << 2.0e-6 * ( (m-1.)*(n-1.) )/avgtime
             << " Avg time (s): " << avgtime << std::endl;
+  const prk::work_model work{2.0*(m-1.)*(n-1.), 2.0*m*n*sizeof(double)};
+  prk::roofline::print(work, avgtime);
 
   return 0;
 }
@@ -77,7 +77,7 @@ int main(int argc, char* argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int n, nc, nb;
+  int64_t n, nc, nb;
   try {
       if (argc < 3) {
         throw " <# iterations> <array dimension> [<chunk dimension>]";
@@ -90,16 +90,16 @@ int main(int argc, char* argv[])
       }
 
       // grid dimensions
-      n = std::atoi(argv[2]);
+      n = std::atoll(argv[2]);
       if (n < 1) {
         throw "ERROR: grid dimensions must be positive";
-      } else if ( static_cast<size_t>(n)*static_cast<size_t>(n) > INT_MAX) {
+      } else if ( static_cast<double>(n)*static_cast<double>(n) > INT64_MAX) {
         throw "ERROR: grid dimension too large - overflow risk";
       }
 
       // grid chunk dimensions
-      nc = (argc > 3) ? std::atoi(argv[3]) : 1;
-      nc = std::max(1,nc);
+      nc = (argc > 3) ? std::atoll(argv[3]) : 1;
+      nc = std::max<int64_t>(1,nc);
       nc = std::min(n,nc);
 
       // number of grid blocks
@@ -133,8 +133,8 @@ int main(int argc, char* argv[])
   {
     // TODO block this
     OMP_FOR_SIMD
-    for (auto i=0; i<n; i++) {
-      for (auto j=0; j<n; j++) {
+    for (int64_t i=0; i<n; i++) {
+      for (int64_t j=0; j<n; j++) {
         grid[i*n+j] = 0.0;
       }
     }
@@ -142,10 +142,10 @@ int main(int argc, char* argv[])
     // set boundary values (bottom and left side of grid)
     OMP_MASTER
     {
-      for (auto j=0; j<n; j++) {
+      for (int64_t j=0; j<n; j++) {
         grid[0*n+j] = static_cast<double>(j);
       }
-      for (auto i=0; i<n; i++) {
+      for (int64_t i=0; i<n; i++) {
         grid[i*n+0] = static_cast<double>(i);
       }
     }
@@ -160,20 +160,20 @@ int main(int argc, char* argv[])
       }
 
       if (nc==1) {
-        for (auto i=2; i<=2*n-2; i++) {
+        for (int64_t i=2; i<=2*n-2; i++) {
           OMP_FOR_SIMD
-          for (auto j=std::max(2,i-n+2); j<=std::min(i,n); j++) {
+          for (int64_t j=std::max<int64_t>(2,i-n+2); j<=std::min(i,n); j++) {
             const auto x = i-j+1;
             const auto y = j-1;
             grid[x*n+y] = grid[(x-1)*n+y] + grid[x*n+(y-1)] - grid[(x-1)*n+(y-1)];
           }
         }
       } else {
-        for (int i=2; i<=2*(nb+1)-2; i++) {
+        for (int64_t i=2; i<=2*(nb+1)-2; i++) {
           OMP_FOR()
-          for (int j=std::max(2,i-(nb+1)+2); j<=std::min(i,nb+1); j++) {
-            const int ib = nc*(i-j+1-1)+1;
-            const int jb = nc*(j-1-1)+1;
+          for (int64_t j=std::max<int64_t>(2,i-(nb+1)+2); j<=std::min(i,nb+1); j++) {
+            const int64_t ib = nc*(i-j+1-1)+1;
+            const int64_t jb = nc*(j-1-1)+1;
             sweep_tile(ib, std::min(n,ib+nc), jb, std::min(n,jb+nc), n, grid);
           }
         }
@@ -207,6 +207,8 @@ int main(int argc, char* argv[])
   std::cout << "Rate (MFlops/s): "
             << 2.0e-6 * ( (n-1.)*(n-1.) )/avgtime
             << " Avg time (s): " << avgtime << std::endl;
+  const prk::work_model work{2.0*(n-1.)*(n-1.), 2.0*n*n*sizeof(double)};
+  prk::roofline::print(work, avgtime);
 
   return 0;
 }
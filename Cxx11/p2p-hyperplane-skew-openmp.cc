@@ -0,0 +1,229 @@
+///
+/// Copyright (c) 2013, Intel Corporation
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions
+/// are met:
+///
+/// * Redistributions of source code must retain the above copyright
+///       notice, this list of conditions and the following disclaimer.
+/// * Redistributions in binary form must reproduce the above
+///       copyright notice, this list of conditions and the following
+///       disclaimer in the documentation and/or other materials provided
+///       with the distribution.
+/// * Neither the name of Intel Corporation nor the names of its
+///       contributors may be used to endorse or promote products
+///       derived from this software without specific prior written
+///       permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+/// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+/// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+/// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+/// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+/// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+/// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+/// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+/// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+/// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+
+
+//////////////////////////////////////////////////////////////////////
+///
+/// NAME:    Pipeline
+///
+/// PURPOSE: This program tests the efficiency with which point-to-point
+///          synchronization can be carried out. It does so by executing
+///          a pipelined algorithm on an n^2 grid. The grid is swept one
+///          hyperplane (anti-diagonal) at a time, and the points of a
+///          hyperplane are distributed among the threads.
+///
+/// USAGE:   The program takes as input the
+///          dimensions of the grid, and the number of iterations on the grid
+///
+///                <progname> <iterations> <n>
+///
+///          The output consists of diagnostics to make sure the
+///          algorithm worked, and of timing statistics.
+///
+/// NOTES:   In row-major storage, the points of a hyperplane are n-1
+///          elements apart, so the point-wise hyperplane sweep of
+///          p2p-hyperplane-openmp does not vectorize.  Here the grid is
+///          stored skewed: anti-diagonal d = x+y occupies a contiguous
+///          segment, indexed by x.  Point (x,y) then depends on elements
+///          x-1 and x of diagonal d-1 and on element x-1 of diagonal d-2,
+///          so every hyperplane is a unit-stride loop.  The conversion from
+///          and to row-major storage is not timed.
+///
+/// FUNCTIONS CALLED:
+///
+///          Other than standard C functions, the following
+///          functions are used in this program:
+///
+///          wtime()
+///
+/// HISTORY: - Written by Rob Van der Wijngaart, February 2009.
+///            C99-ification by Jeff Hammond, February 2016.
+///            C++11-ification by Jeff Hammond, May 2017.
+///            Skewed storage, 2018.
+///
+//////////////////////////////////////////////////////////////////////
+
+#include "prk_util.h"
+#include "prk_openmp.h"
+
+int main(int argc, char* argv[])
+{
+  std::cout << "Parallel Research Kernels version " << PRKVERSION << std::endl;
+#ifdef _OPENMP
+  std::cout << "C++11/OpenMP SKEWED HYPERPLANE pipeline execution on 2D grid" << std::endl;
+#else
+  std::cout << "C++11/Serial SKEWED HYPERPLANE pipeline execution on 2D grid" << std::endl;
+#endif
+
+  //////////////////////////////////////////////////////////////////////
+  // Process and test input parameters
+  //////////////////////////////////////////////////////////////////////
+
+  int iterations;
+  int64_t n;
+  try {
+      if (argc < 3) {
+        throw " <# iterations> <array dimension>";
+      }
+
+      // number of times to run the pipeline algorithm
+      iterations  = std::atoi(argv[1]);
+      if (iterations < 1) {
+        throw "ERROR: iterations must be >= 1";
+      }
+
+      // grid dimensions
+      n = std::atoll(argv[2]);
+      if (n < 2) {
+        throw "ERROR: grid dimensions must be at least 2";
+      } else if ( static_cast<double>(n)*static_cast<double>(n) > INT64_MAX) {
+        throw "ERROR: grid dimension too large - overflow risk";
+      }
+  }
+  catch (const char * e) {
+    std::cout << e << std::endl;
+    return 1;
+  }
+
+#ifdef _OPENMP
+  std::cout << "Number of threads (max)   = " << omp_get_max_threads() << std::endl;
+#endif
+  std::cout << "Number of iterations = " << iterations << std::endl;
+  std::cout << "Grid sizes           = " << n << ", " << n << std::endl;
+
+  //////////////////////////////////////////////////////////////////////
+  // Allocate space and perform the computation
+  //////////////////////////////////////////////////////////////////////
+
+  auto pipeline_time = 0.0; // silence compiler warning
+
+  std::vector<double> grid(n*n,0.0);
+
+  // set boundary values (bottom and left side of grid)
+  for (int64_t j=0; j<n; j++) {
+    grid[0*n+j] = static_cast<double>(j);
+  }
+  for (int64_t i=0; i<n; i++) {
+    grid[i*n+0] = static_cast<double>(i);
+  }
+
+  // Diagonal d holds the points with x+y=d, for x in [xlo(d),xhi(d)].
+  // Element x of diagonal d is skew[base[d]+x], i.e. base[d] is the start
+  // of the diagonal minus xlo(d).
+  const int64_t ndiag = 2*n-1;
+  auto xlo = [=] (int64_t d) { return std::max<int64_t>(0,d-n+1); };
+  auto xhi = [=] (int64_t d) { return std::min(d,n-1); };
+  std::vector<int64_t> base(ndiag);
+  {
+    int64_t start = 0;
+    for (int64_t d=0; d<ndiag; d++) {
+      base[d] = start - xlo(d);
+      start += xhi(d)-xlo(d)+1;
+    }
+  }
+
+  double * RESTRICT skew = new double[n*n];
+
+  // convert from row-major to skewed storage
+  OMP_PARALLEL(for)
+  for (int64_t d=0; d<ndiag; d++) {
+    for (int64_t x=xlo(d); x<=xhi(d); x++) {
+      skew[base[d]+x] = grid[x*n+(d-x)];
+    }
+  }
+
+  const int64_t last = base[ndiag-1]+(n-1);
+
+  OMP_PARALLEL()
+  {
+    for (auto iter = 0; iter<=iterations; iter++) {
+
+      if (iter==1) {
+          OMP_BARRIER
+          OMP_MASTER
+          pipeline_time = prk::wtime();
+      }
+
+      for (int64_t d=2; d<ndiag; d++) {
+        // interior points of diagonal d: 1 <= x <= n-1 and 1 <= d-x <= n-1
+        const int64_t first = std::max<int64_t>(1,d-n+1);
+        const int64_t end   = std::min(d-1,n-1);
+        double       * RESTRICT a = skew + base[d];
+        const double * RESTRICT b = skew + base[d-1];
+        const double * RESTRICT c = skew + base[d-2];
+        OMP_FOR_SIMD
+        for (int64_t x=first; x<=end; x++) {
+          a[x] = b[x-1] + b[x] - c[x-1];
+        }
+      }
+      OMP_MASTER
+      skew[0] = -skew[last];
+    }
+    OMP_BARRIER
+    OMP_MASTER
+    pipeline_time = prk::wtime() - pipeline_time;
+  }
+
+  // convert back to row-major storage
+  OMP_PARALLEL(for)
+  for (int64_t d=0; d<ndiag; d++) {
+    for (int64_t x=xlo(d); x<=xhi(d); x++) {
+      grid[x*n+(d-x)] = skew[base[d]+x];
+    }
+  }
+  delete[] skew;
+
+  //////////////////////////////////////////////////////////////////////
+  // Analyze and output results.
+  //////////////////////////////////////////////////////////////////////
+
+  const double epsilon = 1.e-8;
+  auto corner_val = ((iterations+1.)*(2.*n-2.));
+  if ( (std::fabs(grid[(n-1)*n+(n-1)] - corner_val)/corner_val) > epsilon) {
+    std::cout << "ERROR: checksum " << grid[(n-1)*n+(n-1)]
+              << " does not match verification value " << corner_val << std::endl;
+    return 1;
+  }
+
+#ifdef VERBOSE
+  std::cout << "Solution validates; verification value = " << corner_val << std::endl;
+#else
+  std::cout << "Solution validates" << std::endl;
+#endif
+  auto avgtime = pipeline_time/iterations;
+  std::cout << "Rate (MFlops/s): "
+            << 2.0e-6 * ( (n-1.)*(n-1.) )/avgtime
+            << " Avg time (s): " << avgtime << std::endl;
+  const prk::work_model work{2.0*(n-1.)*(n-1.), 2.0*n*n*sizeof(double)};
+  prk::roofline::print(work, avgtime);
+
+  return 0;
+}
@@ -74,9 +74,9 @@ int main(int argc, char* argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int n;
+  int64_t n;
 #if 0
-  int nc, nb;
+  int64_t nc, nb;
 #endif
   try {
       if (argc < 3) {
@@ -90,17 +90,17 @@ int main(int argc, char* argv[])
       }
 
       // grid dimensions
-      n = std::atoi(argv[2]);
+      n = std::atoll(argv[2]);
       if (n < 1) {
         throw "ERROR: grid dimensions must be positive";
-      } else if ( static_cast<size_t>(n)*static_cast<size_t>(n) > static_cast<size_t>(INT_MAX)) {
+      } else if ( static_cast<double>(n)*static_cast<double>(n) > INT64_MAX) {
         throw "ERROR: grid dimension too large - overflow risk";
       }
 
 #if 0
       // grid chunk dimensions
-      nc = (argc > 3) ? std::atoi(argv[3]) : 1;
-      nc = std::max(1,nc);
+      nc = (argc > 3) ? std::atoll(argv[3]) : 1;
+      nc = std::max<int64_t>(1,nc);
       nc = std::min(n,nc);
 
       // number of grid blocks
@@ -126,7 +126,7 @@ int main(int argc, char* argv[])
   auto pipeline_time = 0.0; // silence compiler warning
 
   std::vector<double> h_grid(n*n,0.0);
-  for (int j=0; j<n; j++) {
+  for (int64_t j=0; j<n; j++) {
     h_grid[0*n+j] = static_cast<double>(j);
     h_grid[j*n+0] = static_cast<double>(j);
   }
@@ -139,22 +139,22 @@ int main(int argc, char* argv[])
 
       if (iter==1) pipeline_time = prk::wtime();
 
-      for (int i=2; i<=2*n-2; i++) {
+      for (int64_t i=2; i<=2*n-2; i++) {
 
-        cl::sycl::id<1> I{unsigned(i)};
+        cl::sycl::id<1> I{static_cast<size_t>(i)};
         cl::sycl::id<1> One{1};
 
         q.submit([&](cl::sycl::handler& h) {
 
           auto grid = d_grid.get_access<cl::sycl::access::mode::read_write>(h);
 
-          unsigned begin = std::max(2,i-n+2);
-          unsigned end   = std::min(i,n)+1;
-          unsigned range = end-begin;
+          size_t begin = std::max<int64_t>(2,i-n+2);
+          size_t end   = std::min(i,n)+1;
+          size_t range = end-begin;
 
           h.parallel_for<class sweep>(cl::sycl::range<1>{range}, cl::sycl::id<1>{begin}, [=] (cl::sycl::item<1> j) {
             auto J = j.get_id();
-            cl::sycl::id<1> N{unsigned(n)};
+            cl::sycl::id<1> N{static_cast<size_t>(n)};
             cl::sycl::id<1> X{I-J+One};
             cl::sycl::id<1> Y{J-One};
             cl::sycl::id<1> Xold{X-One}; // x-1
@@ -183,8 +183,8 @@ int main(int argc, char* argv[])
   }
 
 #if 0
-  for (int i=0; i<n; ++i) {
-      for (int j=0; j<n; ++j) {
+  for (int64_t i=0; i<n; ++i) {
+      for (int64_t j=0; j<n; ++j) {
           std::cout << i << "," << j << "=" << h_grid[i*n+j] << "\n";
       }
   }
@@ -72,7 +72,7 @@ int main(int argc, char* argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int n, nc, nb;
+  int64_t n, nc, nb;
   try {
       if (argc < 3) {
         throw " <# iterations> <array dimension> [<chunk dimension>]";
@@ -85,16 +85,16 @@ int main(int argc, char* argv[])
       }
 
       // grid dimensions
-      n = std::atoi(argv[2]);
+      n = std::atoll(argv[2]);
       if (n < 1) {
         throw "ERROR: grid dimensions must be positive";
-      } else if ( static_cast<size_t>(n)*static_cast<size_t>(n) > INT_MAX) {
+      } else if ( static_cast<double>(n)*static_cast<double>(n) > INT64_MAX) {
         throw "ERROR: grid dimension too large - overflow risk";
       }
 
       // grid chunk dimensions
-      nc = (argc > 3) ? std::atoi(argv[3]) : 1;
-      nc = std::max(1,nc);
+      nc = (argc > 3) ? std::atoll(argv[3]) : 1;
+      nc = std::max<int64_t>(1,nc);
       nc = std::min(n,nc);
 
       // number of grid blocks
@@ -121,15 +121,15 @@ int main(int argc, char* argv[])
 
   double * grid = new double[n*n];
 
-  for (int i=0; i<n; i++) {
-    for (int j=0; j<n; j++) {
+  for (int64_t i=0; i<n; i++) {
+    for (int64_t j=0; j<n; j++) {
       grid[i*n+j] = 0.0;
     }
   }
-  for (int j=0; j<n; j++) {
+  for (int64_t j=0; j<n; j++) {
     grid[0*n+j] = static_cast<double>(j);
   }
-  for (int i=0; i<n; i++) {
+  for (int64_t i=0; i<n; i++) {
     grid[i*n+0] = static_cast<double>(i);
   }
 
@@ -140,24 +140,24 @@ int main(int argc, char* argv[])
       if (iter==1) pipeline_time = prk::wtime();
 
       if (nc==1) {
-        for (int i=2; i<=2*n-2; i++) {
+        for (int64_t i=2; i<=2*n-2; i++) {
           #pragma acc parallel loop independent
-          for (int j=std::max(2,i-n+2); j<=std::min(i,n); j++) {
-            const int x = i-j+1;
-            const int y = j-1;
+          for (int64_t j=std::max<int64_t>(2,i-n+2); j<=std::min(i,n); j++) {
+            const int64_t x = i-j+1;
+            const int64_t y = j-1;
             grid[x*n+y] = grid[(x-1)*n+y] + grid[x*n+(y-1)] - grid[(x-1)*n+(y-1)];
           }
         }
       } else {
-        for (int i=2; i<=2*(nb+1)-2; i++) {
+        for (int64_t i=2; i<=2*(nb+1)-2; i++) {
           #pragma acc parallel loop gang
-          for (int j=std::max(2,i-(nb+1)+2); j<=std::min(i,nb+1); j++) {
-            const int ib = nc*(i-j)+1;
-            const int jb = nc*(j-2)+1;
+          for (int64_t j=std::max<int64_t>(2,i-(nb+1)+2); j<=std::min(i,nb+1); j++) {
+            const int64_t ib = nc*(i-j)+1;
+            const int64_t jb = nc*(j-2)+1;
             //sweep_tile(ib, std::min(n,ib+nc), jb, std::min(n,jb+nc), n, grid);
             #pragma acc loop vector
-            for (int i=ib; i<std::min(n,ib+nc); i++) {
-              for (int j=jb; j<std::min(n,jb+nc); j++) {
+            for (int64_t i=ib; i<std::min(n,ib+nc); i++) {
+              for (int64_t j=jb; j<std::min(n,jb+nc); j++) {
                 grid[i*n+j] = grid[(i-1)*n+j] + grid[i*n+(j-1)] - grid[(i-1)*n+(j-1)];
               }
             }
@@ -77,7 +77,7 @@ int main(int argc, char* argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int n, nc, nb;
+  int64_t n, nc, nb;
   try {
       if (argc < 3) {
         throw " <# iterations> <array dimension> [<chunk dimension>]";
@@ -90,16 +90,16 @@ int main(int argc, char* argv[])
       }
 
       // grid dimensions
-      n = std::atoi(argv[2]);
+      n = std::atoll(argv[2]);
       if (n < 1) {
         throw "ERROR: grid dimensions must be positive";
-      } else if ( static_cast<size_t>(n)*static_cast<size_t>(n) > static_cast<size_t>(INT_MAX)) {
+      } else if ( static_cast<double>(n)*static_cast<double>(n) > INT64_MAX) {
         throw "ERROR: grid dimension too large - overflow risk";
       }
 
       // grid chunk dimensions
-      nc = (argc > 3) ? std::atoi(argv[3]) : 1;
-      nc = std::max(1,nc);
+      nc = (argc > 3) ? std::atoll(argv[3]) : 1;
+      nc = std::max<int64_t>(1,nc);
       nc = std::min(n,nc);
 
       // number of grid blocks
@@ -124,7 +124,7 @@ int main(int argc, char* argv[])
   std::vector<double> grid(n*n,0.0);
 
   // set boundary values (bottom and left side of grid)
-  for (auto j=0; j<n; j++) {
+  for (int64_t j=0; j<n; j++) {
     grid[0*n+j] = static_cast<double>(j);
     grid[j*n+0] = static_cast<double>(j);
   }
@@ -134,8 +134,8 @@ int main(int argc, char* argv[])
     if (iter==1) pipeline_time = prk::wtime();
 
     if (nc==1) {
-      for (auto i=2; i<=2*n-2; i++) {
-        const auto begin = std::max(2,i-n+2);
+      for (int64_t i=2; i<=2*n-2; i++) {
+        const auto begin = std::max<int64_t>(2,i-n+2);
         const auto end   = std::min(i,n)+1;
         auto range = prk::range(begin,end);
 #if defined(USE_PSTL) && defined(USE_INTEL_PSTL)
@@ -152,8 +152,8 @@ int main(int argc, char* argv[])
         });
       }
     } else {
-      for (int i=2; i<=2*(nb+1)-2; i++) {
-        const auto begin = std::max(2,i-(nb+1)+2);
+      for (int64_t i=2; i<=2*(nb+1)-2; i++) {
+        const auto begin = std::max<int64_t>(2,i-(nb+1)+2);
         const auto end   = std::min(i,nb+1)+1;
         auto range = prk::range(begin,end);
 #if defined(USE_PSTL) && defined(USE_INTEL_PSTL)
@@ -164,8 +164,8 @@ int main(int argc, char* argv[])
 #else
         std::for_each( std::begin(range), std::end(range), [&] (auto j) {
 #endif
-          const int ib = nc*(i-j)+1;
-          const int jb = nc*(j-2)+1;
+          const int64_t ib = nc*(i-j)+1;
+          const int64_t jb = nc*(j-2)+1;
           sweep_tile(ib, std::min(n,ib+nc), jb, std::min(n,jb+nc), n, grid);
         });
       }
@@ -61,6 +61,7 @@
 
 #include "prk_util.h"
 #include "prk_tbb.h"
+#include "prk_affinity.h"
 #include "p2p-kernel.h"
 
 int main(int argc, char* argv[])
@@ -73,7 +74,8 @@ int main(int argc, char* argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int n, nc, nb;
+  int64_t n, nc, nb;
+  prk::affinity affinity;
   try {
       if (argc < 3) {
         throw " <# iterations> <array dimension> [<chunk dimension>]";
@@ -86,21 +88,23 @@ int main(int argc, char* argv[])
       }
 
       // grid dimensions
-      n = std::atoi(argv[2]);
+      n = std::atoll(argv[2]);
       if (n < 1) {
         throw "ERROR: grid dimensions must be positive";
-      } else if ( static_cast<size_t>(n)*static_cast<size_t>(n) > static_cast<size_t>(INT_MAX)) {
+      } else if ( static_cast<double>(n)*static_cast<double>(n) > INT64_MAX) {
         throw "ERROR: grid dimension too large - overflow risk";
       }
 
       // grid chunk dimensions
-      nc = (argc > 3) ? std::atoi(argv[3]) : 1;
-      nc = std::max(1,nc);
+      nc = (argc > 3) ? std::atoll(argv[3]) : 1;
+      nc = std::max<int64_t>(1,nc);
       nc = std::min(n,nc);
 
       // number of grid blocks
       nb = (n-1)/nc;
       if ((n-1)%nc) nb++;
+
+      affinity = prk::get_affinity();
   }
   catch (const char * e) {
     std::cout << e << std::endl;
@@ -110,8 +114,10 @@ int main(int argc, char* argv[])
   const char* envvar = std::getenv("TBB_NUM_THREADS");
   int num_threads = (envvar!=NULL) ? std::atoi(envvar) : tbb::task_scheduler_init::default_num_threads();
   tbb::task_scheduler_init init(num_threads);
+  prk::affinity_observer observer(affinity);
 
   std::cout << "Number of threads    = " << num_threads << std::endl;
+  affinity.print(num_threads);
   std::cout << "Number of iterations = " << iterations << std::endl;
   std::cout << "Grid sizes           = " << n << ", " << n << std::endl;
   std::cout << "Grid chunk sizes     = " << nc << std::endl;
@@ -126,7 +132,7 @@ int main(int argc, char* argv[])
   std::vector<double> grid(n*n,0.0);
 
   // set boundary values (bottom and left side of grid)
-  for (auto j=0; j<n; j++) {
+  for (int64_t j=0; j<n; j++) {
     grid[0*n+j] = static_cast<double>(j);
     grid[j*n+0] = static_cast<double>(j);
   }
@@ -136,22 +142,22 @@ int main(int argc, char* argv[])
     if (iter==1) pipeline_time = prk::wtime();
 
     if (nc==1) {
-      for (auto i=2; i<=2*n-2; i++) {
+      for (int64_t i=2; i<=2*n-2; i++) {
         //OMP_FOR_SIMD
-        //for (auto j=std::max(2,i-n+2); j<=std::min(i,n); j++) {
-        tbb::parallel_for( std::max(2,i-n+2), std::min(i,n)+1, [=,&grid](int j) {
+        //for (auto j=std::max<int64_t>(2,i-n+2); j<=std::min(i,n); j++) {
+        tbb::parallel_for( std::max<int64_t>(2,i-n+2), std::min(i,n)+1, [=,&grid](int64_t j) {
           const auto x = i-j+1;
           const auto y = j-1;
           grid[x*n+y] = grid[(x-1)*n+y] + grid[x*n+(y-1)] - grid[(x-1)*n+(y-1)];
         });
       }
     } else {
-      for (int i=2; i<=2*(nb+1)-2; i++) {
+      for (int64_t i=2; i<=2*(nb+1)-2; i++) {
         //OMP_FOR()
-        //for (int j=std::max(2,i-(nb+1)+2); j<=std::min(i,nb+1); j++) {
-        tbb::parallel_for( std::max(2,i-(nb+1)+2), std::min(i,nb+1)+1, [=,&grid](int j) {
-          const int ib = nc*(i-j)+1;
-          const int jb = nc*(j-2)+1;
+        //for (int64_t j=std::max<int64_t>(2,i-(nb+1)+2); j<=std::min(i,nb+1); j++) {
+        tbb::parallel_for( std::max<int64_t>(2,i-(nb+1)+2), std::min(i,nb+1)+1, [=,&grid](int64_t j) {
+          const int64_t ib = nc*(i-j)+1;
+          const int64_t jb = nc*(j-2)+1;
           sweep_tile(ib, std::min(n,ib+nc), jb, std::min(n,jb+nc), n, grid);
         });
       }
@@ -63,7 +63,7 @@
 #include "prk_opencl.h"
 
 template <typename T>
-void run(cl::Context context, int iterations, int n)
+void run(cl::Context context, int iterations, int64_t n)
 {
   auto precision = (sizeof(T)==8) ? 64 : 32;
 
@@ -72,7 +72,7 @@ void run(cl::Context context, int iterations, int n)
   auto function = (precision==64) ? "p2p64" : "p2p32";
 
   cl_int err;
-  auto kernel = cl::make_kernel<int, cl::Buffer>(program, function, &err);
+  auto kernel = cl::make_kernel<cl_long, cl::Buffer>(program, function, &err);
   if(err != CL_SUCCESS){
     std::vector<cl::Device> devices = context.getInfo<CL_CONTEXT_DEVICES>();
     std::cout << program.getBuildInfo<CL_PROGRAM_BUILD_LOG>(devices[0]) << std::endl;
@@ -85,10 +85,10 @@ void run(cl::Context context, int iterations, int n)
   //////////////////////////////////////////////////////////////////////
 
   std::vector<T> h_grid(n*n, T(0));
-  for (auto j=0; j<n; j++) {
+  for (int64_t j=0; j<n; j++) {
     h_grid[0*n+j] = static_cast<double>(j);
   }
-  for (auto i=0; i<n; i++) {
+  for (int64_t i=0; i<n; i++) {
     h_grid[i*n+0] = static_cast<double>(i);
   }
 
@@ -148,7 +148,7 @@ int main(int argc, char* argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int n;
+  int64_t n;
   try {
       if (argc < 3) {
         throw " <# iterations> <array dimension>";
@@ -161,10 +161,10 @@ int main(int argc, char* argv[])
       }
 
       // grid dimensions
-      n = std::atoi(argv[2]);
+      n = std::atoll(argv[2]);
       if (n < 1) {
         throw "ERROR: grid dimensions must be positive";
-      } else if ( static_cast<size_t>(n)*static_cast<size_t>(n) > INT_MAX) {
+      } else if ( static_cast<double>(n)*static_cast<double>(n) > INT64_MAX) {
         throw "ERROR: grid dimension too large - overflow risk";
       }
   }
@@ -61,6 +61,7 @@
 
 #include "prk_util.h"
 #include "prk_tbb.h"
+#include "prk_affinity.h"
 
 int main(int argc, char* argv[])
 {
@@ -72,7 +73,8 @@ int main(int argc, char* argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int n;
+  int64_t n;
+  prk::affinity affinity;
   try {
       if (argc < 3) {
         throw " <# iterations> <array dimension>";
@@ -85,12 +87,14 @@ int main(int argc, char* argv[])
       }
 
       // grid dimensions
-      n = std::atoi(argv[2]);
+      n = std::atoll(argv[2]);
       if (n < 1) {
         throw "ERROR: grid dimensions must be positive";
-      } else if ( static_cast<size_t>(n)*static_cast<size_t>(n) > static_cast<size_t>(INT_MAX)) {
+      } else if ( static_cast<double>(n)*static_cast<double>(n) > INT64_MAX) {
         throw "ERROR: grid dimension too large - overflow risk";
       }
+
+      affinity = prk::get_affinity();
   }
   catch (const char * e) {
     std::cout << e << std::endl;
@@ -100,8 +104,10 @@ int main(int argc, char* argv[])
   const char* envvar = std::getenv("TBB_NUM_THREADS");
   int num_threads = (envvar!=NULL) ? std::atoi(envvar) : tbb::task_scheduler_init::default_num_threads();
   tbb::task_scheduler_init init(num_threads);
+  prk::affinity_observer observer(affinity);
 
   std::cout << "Number of threads    = " << num_threads << std::endl;
+  affinity.print(num_threads);
   std::cout << "Number of iterations = " << iterations << std::endl;
   std::cout << "Grid sizes           = " << n << ", " << n << std::endl;
   std::cout << "TBB partitioner: " << typeid(tbb_partitioner).name() << std::endl;
@@ -115,7 +121,7 @@ int main(int argc, char* argv[])
   std::vector<double> grid(n*n,0.0);
 
   // set boundary values (bottom and left side of grid)
-  for (auto j=0; j<n; j++) {
+  for (int64_t j=0; j<n; j++) {
     grid[0*n+j] = static_cast<double>(j);
     grid[j*n+0] = static_cast<double>(j);
   }
@@ -124,8 +130,8 @@ int main(int argc, char* argv[])
 
     if (iter == 1) pipeline_time = prk::wtime();
 
-    for (auto i=2; i<=2*n-2; i++) {
-      tbb::parallel_for( std::max(2,i-n+2), std::min(i,n)+1, [=,&grid](int j) {
+    for (int64_t i=2; i<=2*n-2; i++) {
+      tbb::parallel_for( std::max<int64_t>(2,i-n+2), std::min(i,n)+1, [=,&grid](int64_t j) {
                const auto x = i-j+2-1;
                const auto y = j-1;
                grid[x*n+y] = grid[(x-1)*n+y] + grid[x*n+(y-1)] - grid[(x-1)*n+(y-1)];
@@ -1,63 +1,240 @@
 #define RESTRICT __restrict__
 
-#if 1
+#if defined(__GNUC__) && defined(__x86_64__)
+#define PRK_P2P_X86 1
+#include <immintrin.h>
+#endif
+
+// The reference sweep: one row at a time.  Every point depends on its left
+// neighbor, so the inner loop is a serial chain of dependent adds.
 
-inline void sweep_tile(int startm, int endm,
-                       int startn, int endn,
-                       int n, double * RESTRICT grid)
+inline void sweep_tile_scalar(int64_t startm, int64_t endm,
+                              int64_t startn, int64_t endn,
+                              int64_t n, double * RESTRICT grid)
 {
-  for (int i=startm; i<endm; i++) {
-    for (int j=startn; j<endn; j++) {
+  for (int64_t i=startm; i<endm; i++) {
+    for (int64_t j=startn; j<endn; j++) {
       grid[i*n+j] = grid[(i-1)*n+j] + grid[i*n+(j-1)] - grid[(i-1)*n+(j-1)];
     }
   }
 }
 
-inline void sweep_tile(int startm, int endm,
-                       int startn, int endn,
-                       int n, std::vector<double> & grid)
+// Register-blocked sweeps over W rows at once, one SIMD lane per row.
+// Row i0+r runs L*r columns behind row i0 (L=SWEEP_LAG), so at step s lane
+// r updates point (i0+r,s-L*r).  Its left neighbor is what lane r produced
+// at step s-1, and its upper and upper-left neighbors are what lane r-1
+// produced at steps s-L and s-L-1.  Only lane 0 reads from memory (row
+// i0-1); the other lanes get their input by shifting an older result up one
+// lane.  With a lag of several steps, the shift is off the critical path,
+// which is then the one add per step of each lane, so the W chains advance
+// in parallel.  The register history (a1..a3) below assumes L=3.
+// The triangles at the start and end of the block, where not all lanes have
+// work, are done by the scalar code.
+
+#define SWEEP_LAG 3
+
+// point of lane r at step s, clamped to the left boundary of the tile for
+// history that is only ever shifted out of the register
+#define SWEEP_AT(r,s) grid[(i0+(r))*n+std::max(startn-1,(s)-SWEEP_LAG*(r))]
+
+template <int W>
+inline void sweep_block_prologue(int64_t i0, int64_t startn, int64_t n, double * RESTRICT grid)
 {
-  for (auto i=startm; i<endm; i++) {
-    for (auto j=startn; j<endn; j++) {
-      grid[i*n+j] = grid[(i-1)*n+j] + grid[i*n+(j-1)] - grid[(i-1)*n+(j-1)];
-    }
+  for (int r=0; r<W; r++) {
+    sweep_tile_scalar(i0+r, i0+r+1, startn, startn+SWEEP_LAG*(W-1-r), n, grid);
+  }
+}
+
+template <int W>
+inline void sweep_block_epilogue(int64_t i0, int64_t endn, int64_t n, double * RESTRICT grid)
+{
+  for (int r=1; r<W; r++) {
+    sweep_tile_scalar(i0+r, i0+r+1, endn-SWEEP_LAG*r, endn, n, grid);
+  }
+}
+
+#ifdef PRK_P2P_X86
+
+// { x[0], a[0] }
+__attribute__((target("sse2")))
+inline __m128d sweep_shift_sse2(__m128d a, const double * x)
+{
+  return _mm_unpacklo_pd(_mm_load_sd(x), a);
+}
+
+__attribute__((target("sse2")))
+inline void sweep_block_sse2(int64_t i0, int64_t startn, int64_t endn, int64_t n, double * RESTRICT grid)
+{
+  const int64_t s0 = startn+SWEEP_LAG;
+  const double * RESTRICT above = &grid[(i0-1)*n];
+  double * RESTRICT row0 = &grid[ i0   *n];
+  double * RESTRICT row1 = &grid[(i0+1)*n-SWEEP_LAG];
+  // a1 = result of step s-1, a2 = of s-2, ...
+  __m128d a1 = _mm_set_pd(SWEEP_AT(1,s0-1), SWEEP_AT(0,s0-1));
+  __m128d a2 = _mm_set_pd(SWEEP_AT(1,s0-2), SWEEP_AT(0,s0-2));
+  __m128d a3 = _mm_set_pd(SWEEP_AT(1,s0-3), SWEEP_AT(0,s0-3));
+  __m128d u  = _mm_set_pd(SWEEP_AT(0,s0-4), above[s0-1]);
+  int64_t s = s0;
+  // two steps at a time, so that each row gets one store of two points
+  for (; s+1<endn; s+=2) {
+    const __m128d v0 = sweep_shift_sse2(a3, &above[s+0]);
+    const __m128d b0 = _mm_add_pd(_mm_sub_pd(v0, u),  a1);
+    const __m128d v1 = sweep_shift_sse2(a2, &above[s+1]);
+    const __m128d b1 = _mm_add_pd(_mm_sub_pd(v1, v0), b0);
+    u = v1; a3 = a1; a2 = b0; a1 = b1;
+    _mm_storeu_pd(&row0[s], _mm_unpacklo_pd(b0, b1));
+    _mm_storeu_pd(&row1[s], _mm_unpackhi_pd(b0, b1));
+  }
+  for (; s<endn; s++) {
+    const __m128d v = sweep_shift_sse2(a3, &above[s]);
+    const __m128d a0 = _mm_add_pd(_mm_sub_pd(v, u), a1);
+    _mm_storel_pd(&row0[s], a0);
+    _mm_storeh_pd(&row1[s], a0);
+    u = v; a3 = a2; a2 = a1; a1 = a0;
   }
 }
 
-#else
+// { x[0], a[0], a[1], a[2] }
+__attribute__((target("avx2")))
+inline __m256d sweep_shift_avx2(__m256d a, const double * x)
+{
+  const __m256d t = _mm256_permute4x64_pd(a, _MM_SHUFFLE(2,1,0,3));
+  return _mm256_blend_pd(t, _mm256_broadcast_sd(x), 0x1);
+}
 
-inline void sweep_tile(int startm, int endm,
-                       int startn, int endn,
-                       int n, double * RESTRICT grid)
+__attribute__((target("avx2")))
+inline void sweep_block_avx2(int64_t i0, int64_t startn, int64_t endn, int64_t n, double * RESTRICT grid)
 {
-    for (int i=startm; i<endm; i++) {
-        double olda = grid[  i  *n+(startn-1)];
-        double oldb = grid[(i-1)*n+(startn-1)];
-        for (int j=startn; j<endn; j++) {
-            double const newb = grid[(i-1)*n+j];
-            double const newa = newb - oldb + olda;
-            grid[i*n+j] = newa;
-            olda = newa;
-            oldb = newb;
-        }
+  const int64_t s0 = startn+3*SWEEP_LAG;
+  const double * RESTRICT above = &grid[(i0-1)*n];
+  double * RESTRICT row0 = &grid[ i0   *n];
+  double * RESTRICT row1 = &grid[(i0+1)*n-1*SWEEP_LAG];
+  double * RESTRICT row2 = &grid[(i0+2)*n-2*SWEEP_LAG];
+  double * RESTRICT row3 = &grid[(i0+3)*n-3*SWEEP_LAG];
+  __m256d a1 = _mm256_set_pd(SWEEP_AT(3,s0-1), SWEEP_AT(2,s0-1), SWEEP_AT(1,s0-1), SWEEP_AT(0,s0-1));
+  __m256d a2 = _mm256_set_pd(SWEEP_AT(3,s0-2), SWEEP_AT(2,s0-2), SWEEP_AT(1,s0-2), SWEEP_AT(0,s0-2));
+  __m256d a3 = _mm256_set_pd(SWEEP_AT(3,s0-3), SWEEP_AT(2,s0-3), SWEEP_AT(1,s0-3), SWEEP_AT(0,s0-3));
+  __m256d u  = _mm256_set_pd(SWEEP_AT(2,s0-4), SWEEP_AT(1,s0-4), SWEEP_AT(0,s0-4), above[s0-1]);
+  int64_t s = s0;
+  // Four steps at a time: lane r writes four consecutive points of its
+  // row, so a 4x4 transpose turns the four results into one store per row
+  // instead of one store per point.
+  for (; s+3<endn; s+=4) {
+    const __m256d v0 = sweep_shift_avx2(a3, &above[s+0]);
+    const __m256d b0 = _mm256_add_pd(_mm256_sub_pd(v0, u),  a1);
+    const __m256d v1 = sweep_shift_avx2(a2, &above[s+1]);
+    const __m256d b1 = _mm256_add_pd(_mm256_sub_pd(v1, v0), b0);
+    const __m256d v2 = sweep_shift_avx2(a1, &above[s+2]);
+    const __m256d b2 = _mm256_add_pd(_mm256_sub_pd(v2, v1), b1);
+    const __m256d v3 = sweep_shift_avx2(b0, &above[s+3]);
+    const __m256d b3 = _mm256_add_pd(_mm256_sub_pd(v3, v2), b2);
+    u = v3; a3 = b1; a2 = b2; a1 = b3;
+    const __m256d t0 = _mm256_unpacklo_pd(b0, b1);
+    const __m256d t1 = _mm256_unpackhi_pd(b0, b1);
+    const __m256d t2 = _mm256_unpacklo_pd(b2, b3);
+    const __m256d t3 = _mm256_unpackhi_pd(b2, b3);
+    _mm256_storeu_pd(&row0[s], _mm256_permute2f128_pd(t0, t2, 0x20));
+    _mm256_storeu_pd(&row1[s], _mm256_permute2f128_pd(t1, t3, 0x20));
+    _mm256_storeu_pd(&row2[s], _mm256_permute2f128_pd(t0, t2, 0x31));
+    _mm256_storeu_pd(&row3[s], _mm256_permute2f128_pd(t1, t3, 0x31));
+  }
+  for (; s<endn; s++) {
+    const __m256d v = sweep_shift_avx2(a3, &above[s]);
+    const __m256d a0 = _mm256_add_pd(_mm256_sub_pd(v, u), a1);
+    const __m128d lo = _mm256_castpd256_pd128(a0);
+    const __m128d hi = _mm256_extractf128_pd(a0, 1);
+    _mm_storel_pd(&row0[s], lo);
+    _mm_storeh_pd(&row1[s], lo);
+    _mm_storel_pd(&row2[s], hi);
+    _mm_storeh_pd(&row3[s], hi);
+    u = v; a3 = a2; a2 = a1; a1 = a0;
+  }
+}
+
+#endif /* PRK_P2P_X86 */
+
+#undef SWEEP_AT
+
+typedef void (*sweep_block_fn)(int64_t i0, int64_t startn, int64_t endn, int64_t n, double * RESTRICT grid);
+
+// Below min_cols columns a tile is swept by the scalar code: a block sets
+// up its registers from scattered loads and leaves the triangles at either
+// end to the scalar code, and on narrow tiles that costs more than the
+// parallel lanes gain.  The cutoffs are where the SIMD sweep overtook the
+// scalar one for square tiles of p2p-vector 10 4000 4000 on an AVX2 core.
+struct sweep_isa {
+  const char *   name;
+  int            rows;
+  int64_t        min_cols;
+  sweep_block_fn block;
+};
+
+// Pick the widest implementation the processor supports, once.
+// PRK_P2P_ISA=scalar|sse2|avx2 overrides the choice.
+inline const sweep_isa & sweep_tile_isa()
+{
+  static const sweep_isa isa = [] {
+    const char * env = std::getenv("PRK_P2P_ISA");
+    const std::string want = (env != nullptr) ? std::string(env) : std::string("");
+#ifdef PRK_P2P_X86
+    __builtin_cpu_init();
+    if ((want == "" || want == "avx2") && __builtin_cpu_supports("avx2")) {
+      return sweep_isa{"avx2", 4, 256, sweep_block_avx2};
+    }
+    if ((want == "" || want == "sse2") && __builtin_cpu_supports("sse2")) {
+      return sweep_isa{"sse2", 2, 320, sweep_block_sse2};
     }
+#endif
+    return sweep_isa{"scalar", 1, 0, nullptr};
+  }();
+  return isa;
 }
 
-inline void sweep_tile(int startm, int endm,
-                       int startn, int endn,
-                       int n, std::vector<double> & grid)
-{
-    for (int i=startm; i<endm; i++) {
-        double olda = grid[  i  *n+(startn-1)];
-        double oldb = grid[(i-1)*n+(startn-1)];
-        for (int j=startn; j<endn; j++) {
-            double const newb = grid[(i-1)*n+j];
-            double const newa = newb - oldb + olda;
-            grid[i*n+j] = newa;
-            olda = newa;
-            oldb = newb;
-        }
+template <int W>
+inline void sweep_tile_blocked(int64_t startm, int64_t endm,
+                               int64_t startn, int64_t endn,
+                               int64_t n, double * RESTRICT grid,
+                               const sweep_isa & isa)
+{
+  int64_t i = startm;
+  // a block needs steps in which all lanes are busy, and enough of them to
+  // pay for its setup and the scalar triangles at either end
+  if (endn-startn >= std::max<int64_t>(isa.min_cols, 4*SWEEP_LAG*(W-1))) {
+    for (; i+W<=endm; i+=W) {
+      sweep_block_prologue<W>(i, startn, n, grid);
+      isa.block(i, startn, endn, n, grid);
+      sweep_block_epilogue<W>(i, endn, n, grid);
     }
+  }
+  sweep_tile_scalar(i, endm, startn, endn, n, grid);
 }
 
-#endif
+inline void sweep_tile(int64_t startm, int64_t endm,
+                       int64_t startn, int64_t endn,
+                       int64_t n, double * RESTRICT grid)
+{
+  const sweep_isa & isa = sweep_tile_isa();
+  switch (isa.rows) {
+    case 4:  sweep_tile_blocked<4>(startm, endm, startn, endn, n, grid, isa); break;
+    case 2:  sweep_tile_blocked<2>(startm, endm, startn, endn, n, grid, isa); break;
+    default: sweep_tile_scalar(startm, endm, startn, endn, n, grid); break;
+  }
+}
+
+inline void sweep_tile(int64_t startm, int64_t endm,
+                       int64_t startn, int64_t endn,
+                       int64_t n, std::vector<double> & grid)
+{
+  sweep_tile(startm, endm, startn, endn, n, grid.data());
+}
+
+// One sweep of the whole grid, a tile of mc x nc points at a time, in the
+// order of p2p-vector.
+inline void sweep_tiles(int64_t m, int64_t n, int64_t mc, int64_t nc, double * RESTRICT grid)
+{
+  for (int64_t i=1; i<m; i+=mc) {
+    for (int64_t j=1; j<n; j+=nc) {
+      sweep_tile(i, std::min(m,i+mc), j, std::min(n,j+nc), n, grid);
+    }
+  }
+}
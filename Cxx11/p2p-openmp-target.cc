@@ -71,7 +71,7 @@ int main(int argc, char* argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int m, n;
+  int64_t m, n;
   try {
       if (argc < 4){
         throw " <# iterations> <first array dimension> <second array dimension>";
@@ -84,11 +84,11 @@ int main(int argc, char* argv[])
       }
 
       // grid dimensions
-      m = std::atoi(argv[2]);
-      n = std::atoi(argv[3]);
+      m = std::atoll(argv[2]);
+      n = std::atoll(argv[3]);
       if (m < 1 || n < 1) {
         throw "ERROR: grid dimensions must be positive";
-      } else if ( static_cast<size_t>(m)*static_cast<size_t>(n) > INT_MAX) {
+      } else if ( static_cast<double>(m)*static_cast<double>(n) > INT64_MAX) {
         throw "ERROR: grid dimension too large - overflow risk";
       }
   }
@@ -113,8 +113,8 @@ int main(int argc, char* argv[])
   OMP_PARALLEL()
   {
     OMP_FOR()
-    for (auto i=0; i<n; i++) {
-      for (auto j=0; j<n; j++) {
+    for (int64_t i=0; i<m; i++) {
+      for (int64_t j=0; j<n; j++) {
         grid[i*n+j] = 0.0;
       }
     }
@@ -122,10 +122,10 @@ int main(int argc, char* argv[])
     // set boundary values (bottom and left side of grid)
     OMP_MASTER
     {
-      for (auto j=0; j<n; j++) {
+      for (int64_t j=0; j<n; j++) {
         grid[0*n+j] = static_cast<double>(j);
       }
-      for (auto i=0; i<m; i++) {
+      for (int64_t i=0; i<m; i++) {
         grid[i*n+0] = static_cast<double>(i);
       }
     }
@@ -140,8 +140,8 @@ int main(int argc, char* argv[])
 
       OMP_PARALLEL() {
         OMP_FOR( collapse(2) ordered(2) )
-        for (auto i=1; i<m; i++) {
-          for (auto j=1; j<n; j++) {
+        for (int64_t i=1; i<m; i++) {
+          for (int64_t j=1; j<n; j++) {
             OMP_ORDERED( depend(sink: i-1,j) depend(sink: i,j-1) depend(sink: i-1,j-1) )
             grid[i*n+j] = grid[(i-1)*n+j] + grid[i*n+(j-1)] - grid[(i-1)*n+(j-1)];
             OMP_ORDERED( depend (source) )
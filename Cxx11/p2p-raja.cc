@@ -72,8 +72,8 @@ int main(int argc, char* argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int m, n;
-  int mc, nc;
+  int64_t m, n;
+  int64_t mc, nc;
   try {
       if (argc < 4){
         throw " <# iterations> <first array dimension> <second array dimension> [<first chunk dimension> <second chunk dimension>]";
@@ -86,17 +86,17 @@ int main(int argc, char* argv[])
       }
 
       // grid dimensions
-      m = std::atoi(argv[2]);
-      n = std::atoi(argv[3]);
+      m = std::atoll(argv[2]);
+      n = std::atoll(argv[3]);
       if (m < 1 || n < 1) {
         throw "ERROR: grid dimensions must be positive";
-      } else if ( static_cast<size_t>(m)*static_cast<size_t>(n) > INT_MAX) {
+      } else if ( static_cast<double>(m)*static_cast<double>(n) > INT64_MAX) {
         throw "ERROR: grid dimension too large - overflow risk";
       }
 
       // grid chunk dimensions
-      mc = (argc > 4) ? std::atoi(argv[4]) : m;
-      nc = (argc > 5) ? std::atoi(argv[5]) : n;
+      mc = (argc > 4) ? std::atoll(argv[4]) : m;
+      nc = (argc > 5) ? std::atoll(argv[5]) : n;
       if (mc < 1 || mc > m || nc < 1 || nc > n) {
         std::cout << "WARNING: grid chunk dimensions invalid: " << mc <<  nc << " (ignoring)" << std::endl;
         mc = m;
@@ -121,16 +121,16 @@ int main(int argc, char* argv[])
   double * RESTRICT Amem = new double[m*n];
   matrix grid(Amem, m, n);
 
-  for (int i=0; i<m; i++) {
-    for (int j=0; j<n; j++) {
+  for (int64_t i=0; i<m; i++) {
+    for (int64_t j=0; j<n; j++) {
       grid(i,j) = 0.0;
     }
   }
   // set boundary values (bottom and left side of grid)
-  for (int j=0; j<n; j++) {
+  for (int64_t j=0; j<n; j++) {
     grid(0,j) = static_cast<double>(j);
   }
-  for (int i=0; i<m; i++) {
+  for (int64_t i=0; i<m; i++) {
     grid(i,0) = static_cast<double>(i);
   }
 
@@ -138,7 +138,7 @@ int main(int argc, char* argv[])
 
     if (iter==1) pipeline_time = prk::wtime();
 
-    for (int j=1; j<n; j++) {
+    for (int64_t j=1; j<n; j++) {
       RAJA::RangeSegment range(1, j+1);
       RAJA::forall<thread_exec>(range, [=](RAJA::Index_type i) {
         auto x = i;
@@ -146,7 +146,7 @@ int main(int argc, char* argv[])
         grid(x,y) = grid(x-1,y) + grid(x,y-1) - grid(x-1,y-1);
       });
     }
-    for (int j=n-2; j>=1; j--) {
+    for (int64_t j=n-2; j>=1; j--) {
       RAJA::RangeSegment range(1, j+1);
       RAJA::forall<thread_exec>(range, [=](RAJA::Index_type i) {
         auto x = n+i-j-1;
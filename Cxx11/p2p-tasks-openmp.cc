@@ -39,19 +39,35 @@
 ///          is distributed among the threads (stripwise decomposition).
 ///
 /// USAGE:   The program takes as input the
-///          dimensions of the grid, and the number of iterations on the grid
+///          dimensions of the grid, and the number of iterations on the grid,
+///          and optionally the tile dimensions and the number of independent
+///          grids that are swept together:
 ///
-///                <progname> <iterations> <m> <n>
+///                <progname> <iterations> <m> <n> [<mc|auto> <nc> [<batch>]]
+///
+///          With mc "auto", the tile dimensions are found together by
+///          prk::autotune and cached (nc is then ignored).
 ///
 ///          The output consists of diagnostics to make sure the
 ///          algorithm worked, and of timing statistics.
 ///
+/// NOTES:   Every tile is a task, ordered by depend clauses.  The corner
+///          update that feeds one iteration into the next is a task too,
+///          so there is no taskwait between iterations.  Each of the
+///          grids of a batch is a separate stream of tasks, which the
+///          runtime can use to fill the pipeline stages that one grid
+///          leaves idle while its wavefront fills and drains.  The rate is
+///          the aggregate over all grids.
+///
 /// FUNCTIONS CALLED:
 ///
 ///          Other than standard C functions, the following
 ///          functions are used in this program:
 ///
 ///          wtime()
+///          sweep_tile()
+///          sweep_grid()
+///          initialize_grid()
 ///
 /// HISTORY: - Written by Rob Van der Wijngaart, February 2009.
 ///            C99-ification by Jeff Hammond, February 2016.
@@ -61,6 +77,59 @@
 
 #include "prk_util.h"
 #include "p2p-kernel.h"
+#include "prk_trace.h"
+#include "prk_autotune.h"
+
+// creates the tasks for one sweep of grid in mc*nc tiles, including the
+// corner update that feeds the next sweep; call from a single thread
+void sweep_grid(int64_t m, int64_t n, int64_t mc, int64_t nc, double * grid)
+{
+    for (int64_t i=1; i<m; i+=mc) {
+      for (int64_t j=1; j<n; j+=nc) {
+        if (i==1 && j==1) {
+          // the first tile reads the corner written by the previous iteration
+          OMP_TASK( firstprivate(m,n,mc,nc,grid) depend(in:grid[0]) depend(out:grid[i*n+j]) )
+          {
+            PRK_TRACE_SCOPE("sweep_tile", i, j);
+            sweep_tile(i, std::min(m,i+mc), j, std::min(n,j+nc), n, grid);
+          }
+        } else {
+          OMP_TASK( firstprivate(m,n,mc,nc,grid) depend(in:grid[(i-mc)*n+j],grid[i*n+(j-nc)]) depend(out:grid[i*n+j]) )
+          {
+            PRK_TRACE_SCOPE("sweep_tile", i, j);
+            sweep_tile(i, std::min(m,i+mc), j, std::min(n,j+nc), n, grid);
+          }
+        }
+      }
+    }
+    // the last tile is the one that starts at the corner's block
+    const int64_t il = 1 + ((m-2)/mc)*mc;
+    const int64_t jl = 1 + ((n-2)/nc)*nc;
+    OMP_TASK( firstprivate(m,n,grid) depend(in:grid[il*n+jl]) depend(out:grid[0]) )
+    {
+      PRK_TRACE_SCOPE("corner", 0, 0);
+      grid[0*n+0] = -grid[(m-1)*n+(n-1)];
+    }
+}
+
+// zeroes grid with a taskloop, so that pages are first touched by the
+// threads that sweep them, and sets the boundaries; call from a single thread
+void initialize_grid(int64_t m, int64_t n, double * grid)
+{
+    OMP_TASKLOOP( firstprivate(m,n,grid) )
+    for (int64_t i=0; i<m; i++) {
+      for (int64_t j=0; j<n; j++) {
+        grid[i*n+j] = 0.0;
+      }
+    }
+    OMP_TASKWAIT
+    for (int64_t j=0; j<n; j++) {
+      grid[0*n+j] = static_cast<double>(j);
+    }
+    for (int64_t i=0; i<m; i++) {
+      grid[i*n+0] = static_cast<double>(i);
+    }
+}
 
 int main(int argc, char* argv[])
 {
@@ -76,11 +145,13 @@ int main(int argc, char* argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int m, n;
-  int mc, nc;
+  int64_t m, n;
+  int64_t mc, nc;
+  int batch;
+  bool autotune = false;
   try {
       if (argc < 4){
-        throw " <# iterations> <first array dimension> <second array dimension> [<first chunk dimension> <second chunk dimension>]";
+        throw " <# iterations> <first array dimension> <second array dimension> [<first chunk dimension> <second chunk dimension> [<batch size>]]";
       }
 
       // number of times to run the pipeline algorithm
@@ -90,22 +161,29 @@ int main(int argc, char* argv[])
       }
 
       // grid dimensions
-      m = std::atoi(argv[2]);
-      n = std::atoi(argv[3]);
+      m = std::atoll(argv[2]);
+      n = std::atoll(argv[3]);
       if (m < 1 || n < 1) {
         throw "ERROR: grid dimensions must be positive";
-      } else if ( static_cast<size_t>(m)*static_cast<size_t>(n) > INT_MAX) {
+      } else if ( static_cast<double>(m)*static_cast<double>(n) > INT64_MAX) {
         throw "ERROR: grid dimension too large - overflow risk";
       }
 
       // grid chunk dimensions
-      mc = (argc > 4) ? std::atoi(argv[4]) : m;
-      nc = (argc > 5) ? std::atoi(argv[5]) : n;
+      autotune = (argc > 4) && std::string(argv[4]) == "auto";
+      mc = (argc > 4 && !autotune) ? std::atoll(argv[4]) : m;
+      nc = (argc > 5 && !autotune) ? std::atoll(argv[5]) : n;
       if (mc < 1 || mc > m || nc < 1 || nc > n) {
         std::cout << "WARNING: grid chunk dimensions invalid: " << mc <<  nc << " (ignoring)" << std::endl;
         mc = m;
         nc = n;
       }
+
+      // number of independent grids
+      batch = (argc > 6) ? std::atoi(argv[6]) : 1;
+      if (batch < 1) {
+        throw "ERROR: batch size must be positive";
+      }
   }
   catch (const char * e) {
     std::cout << e << std::endl;
@@ -117,7 +195,8 @@ int main(int argc, char* argv[])
 #endif
   std::cout << "Number of iterations = " << iterations << std::endl;
   std::cout << "Grid sizes           = " << m << ", " << n << std::endl;
-  std::cout << "Grid chunk sizes     = " << mc << ", " << nc << std::endl;
+  std::cout << "Batch size           = " << batch << std::endl;
+  std::cout << "Sweep ISA            = " << sweep_tile_isa().name << std::endl;
 
   //////////////////////////////////////////////////////////////////////
   // Allocate space and perform the computation
@@ -125,39 +204,55 @@ int main(int argc, char* argv[])
 
   auto pipeline_time = 0.0; // silence compiler warning
 
-  double * RESTRICT grid = new double[m*n];
+  std::vector<double*> grids(batch);
+  for (auto & g : grids) {
+    g = new double[m*n];
+  }
+
+  // trials sweep the first grid, which is initialized first and again before
+  // the timed run; tiles of at least 1/32 of each dimension bound the number
+  // of tasks
+  if (autotune) {
+    OMP_PARALLEL()
+    OMP_MASTER
+    initialize_grid(m, n, grids[0]);
+
+    std::ostringstream problem;
+    problem << "m=" << m << ",n=" << n << ",threads=" << omp_get_max_threads();
+    prk::autotune tuner("p2p-tasks-openmp", problem.str(),
+                        {{"mc", std::max<int64_t>(1,(m-1)/32), std::max<int64_t>(1,m-1)},
+                         {"nc", std::max<int64_t>(1,(n-1)/32), std::max<int64_t>(1,n-1)}});
+    auto best = tuner.tune([&] (const prk::autotune::point & p) {
+                             double t = prk::wtime();
+                             OMP_PARALLEL()
+                             OMP_MASTER
+                             sweep_grid(m, n, p[0], p[1], grids[0]);
+                             return prk::wtime() - t;
+                           });
+    mc = best[0];
+    nc = best[1];
+  }
+  std::cout << "Grid chunk sizes     = " << mc << ", " << nc << std::endl;
 
   OMP_PARALLEL()
   OMP_MASTER
   {
-    OMP_TASKLOOP( firstprivate(m,n) shared(grid) )
-    for (int i=0; i<m; i++) {
-      for (int j=0; j<n; j++) {
-        grid[i*n+j] = 0.0;
-      }
-    }
-    OMP_TASKWAIT
-
-    for (int j=0; j<n; j++) {
-      grid[0*n+j] = static_cast<double>(j);
-    }
-    for (int i=0; i<m; i++) {
-      grid[i*n+0] = static_cast<double>(i);
+    for (auto grid : grids) {
+      initialize_grid(m, n, grid);
     }
 
     for (int iter = 0; iter<=iterations; iter++) {
 
-      if (iter==1) pipeline_time = prk::wtime();
+      if (iter==1) {
+        OMP_TASKWAIT
+        pipeline_time = prk::wtime();
+      }
 
-      for (int i=1; i<m; i+=mc) {
-        for (int j=1; j<n; j+=nc) {
-          OMP_TASK( firstprivate(m,n) shared(grid) depend(in:grid[(i-mc)*n+j],grid[i*n+(j-nc)]) depend(out:grid[i*n+j]) )
-          sweep_tile(i, std::min(m,i+mc), j, std::min(n,j+nc), n, grid);
-        }
+      for (auto grid : grids) {
+        sweep_grid(m, n, mc, nc, grid);
       }
-      OMP_TASKWAIT
-      grid[0*n+0] = -grid[(m-1)*n+(n-1)];
     }
+    OMP_TASKWAIT
     pipeline_time = prk::wtime() - pipeline_time;
   }
 
@@ -167,10 +262,13 @@ int main(int argc, char* argv[])
 
   const double epsilon = 1.e-8;
   auto corner_val = ((iterations+1.)*(n+m-2.));
-  if ( (std::fabs(grid[(m-1)*n+(n-1)] - corner_val)/corner_val) > epsilon) {
-    std::cout << "ERROR: checksum " << grid[(m-1)*n+(n-1)]
-              << " does not match verification value " << corner_val << std::endl;
-    return 1;
+  for (auto grid : grids) {
+    if ( (std::fabs(grid[(m-1)*n+(n-1)] - corner_val)/corner_val) > epsilon) {
+      std::cout << "ERROR: checksum " << grid[(m-1)*n+(n-1)]
+                << " does not match verification value " << corner_val << std::endl;
+      return 1;
+    }
+    delete[] grid;
   }
 
 #ifdef VERBOSE
@@ -180,8 +278,10 @@ int main(int argc, char* argv[])
 #endif
   auto avgtime = pipeline_time/iterations;
   std::cout << "Rate (MFlops/s): "
-            << 2.0e-6 * ( (m-1.)*(n-1.) )/avgtime
+            << 2.0e-6 * batch * ( (m-1.)*(n-1.) )/avgtime
             << " Avg time (s): " << avgtime << std::endl;
+  const prk::work_model work{batch*2.0*(m-1.)*(n-1.), batch*2.0*m*n*sizeof(double)};
+  prk::roofline::print(work, avgtime);
 
   return 0;
 }
@@ -46,6 +46,13 @@
 ///          The output consists of diagnostics to make sure the
 ///          algorithm worked, and of timing statistics.
 ///
+/// NOTES:   The flow graph has one node per tile and is built once.  Every
+///          iteration replays it by sending one message to the first node,
+///          so the sweep does no heap allocation of its own.  The time to
+///          build the graph is reported separately from the sweep time; at
+///          small tile sizes, the difference between the rate here and that
+///          of p2p-vector is the per-node scheduling cost of TBB.
+///
 /// FUNCTIONS CALLED:
 ///
 ///          Other than standard C functions, the following
@@ -57,12 +64,17 @@
 ///            C99-ification by Jeff Hammond, February 2016.
 ///            C++11-ification by Jeff Hammond, May 2017.
 ///            TBB implementation by Pablo Reble, April 2018.
+///            Graph built once and replayed, 2018.
 ///
 //////////////////////////////////////////////////////////////////////
 
 #include "prk_util.h"
 #include "prk_tbb.h"
+#include "prk_affinity.h"
 #include "p2p-kernel.h"
+#include "prk_trace.h"
+
+#include <deque>
 
 int main(int argc, char* argv[])
 {
@@ -74,11 +86,11 @@ int main(int argc, char* argv[])
   //////////////////////////////////////////////////////////////////////
 
   using namespace tbb::flow;
-  //graph g;
 
   int iterations;
-  int m, n;
-  int mc, nc;
+  int64_t m, n;
+  int64_t mc, nc;
+  prk::affinity affinity;
   try {
       if (argc < 4){
         throw " <# iterations> <first array dimension> <second array dimension> [<first chunk dimension> <second chunk dimension>]";
@@ -91,22 +103,24 @@ int main(int argc, char* argv[])
       }
 
       // grid dimensions
-      m = std::atoi(argv[2]);
-      n = std::atoi(argv[3]);
+      m = std::atoll(argv[2]);
+      n = std::atoll(argv[3]);
       if (m < 1 || n < 1) {
         throw "ERROR: grid dimensions must be positive";
-      } else if ( static_cast<size_t>(m)*static_cast<size_t>(n) > INT_MAX) {
+      } else if ( static_cast<double>(m)*static_cast<double>(n) > INT64_MAX) {
         throw "ERROR: grid dimension too large - overflow risk";
       }
 
       // grid chunk dimensions
-      mc = (argc > 4) ? std::atoi(argv[4]) : m;
-      nc = (argc > 5) ? std::atoi(argv[5]) : n;
+      mc = (argc > 4) ? std::atoll(argv[4]) : m;
+      nc = (argc > 5) ? std::atoll(argv[5]) : n;
       if (mc < 1 || mc > m || nc < 1 || nc > n) {
         std::cout << "WARNING: grid chunk dimensions invalid: " << mc <<  nc << " (ignoring)" << std::endl;
         mc = m;
         nc = n;
       }
+
+      affinity = prk::get_affinity();
   }
   catch (const char * e) {
     std::cout << e << std::endl;
@@ -116,8 +130,10 @@ int main(int argc, char* argv[])
   const char* envvar = std::getenv("TBB_NUM_THREADS");
   int num_threads = (envvar!=NULL) ? std::atoi(envvar) : tbb::task_scheduler_init::default_num_threads();
   tbb::task_scheduler_init init(num_threads);
+  prk::affinity_observer observer(affinity);
 
   std::cout << "Number of threads    = " << num_threads << std::endl;
+  affinity.print(num_threads);
   std::cout << "Number of iterations = " << iterations << std::endl;
   std::cout << "Grid sizes           = " << m << ", " << n << std::endl;
   std::cout << "Grid chunk sizes     = " << mc << ", " << nc << std::endl;
@@ -126,19 +142,30 @@ int main(int argc, char* argv[])
   // Create Grid and allocate space
   //////////////////////////////////////////////////////////////////////
   // calculate number of tiles in n and m direction to create grid.
-  int num_blocks_n = (n / nc);
+  int64_t num_blocks_n = (n / nc);
   if(n%nc != 0) num_blocks_n++;
-  int num_blocks_m = (m / mc);
+  int64_t num_blocks_m = (m / mc);
   if(m%mc != 0) num_blocks_m++;
+  const int64_t num_blocks = num_blocks_m * num_blocks_n;
+
+  std::cout << "Number of blocks     = " << num_blocks_m << ", " << num_blocks_n << std::endl;
 
   auto pipeline_time = 0.0; // silence compiler warning
 
   double * grid = new double[m*n];
 
+  //////////////////////////////////////////////////////////////////////
+  // Build the Flow Graph once; every iteration replays it
+  //////////////////////////////////////////////////////////////////////
+
   typedef tbb::flow::continue_node< tbb::flow::continue_msg > block_node_t;
 
+  auto graph_time = prk::wtime();
+
   graph g;
-  block_node_t *nodes[ num_blocks_n * num_blocks_m ];
+  // a deque constructs the nodes in place and never moves them, so the
+  // edges stay valid and all of the allocation happens here
+  std::deque<block_node_t> nodes;
   // To enable tracing support for Flow Graph Analyzer
   // set following MACRO and link against TBB preview library (-ltbb_preview)
 #if TBB_PREVIEW_FLOW_GRAPH_TRACE
@@ -146,54 +173,33 @@ int main(int argc, char* argv[])
   g.set_name("Pipeline");
 #endif
 
-  bool first_iter=true;
-  block_node_t b(g, [&](const tbb::flow::continue_msg &){
-    grid[0*n+0] = -grid[(m-1)*n+(n-1)];
-    if(first_iter) pipeline_time = prk::wtime();
-      first_iter = false;
-  });
-  for (int i=0; i<num_blocks_m; i+=1) {
-    for (int j=0; j<num_blocks_n; j+=1) {
-        block_node_t *tmp = new block_node_t(g, [=](const tbb::flow::continue_msg &){
-            sweep_tile((i*mc)+1, std::min(m,(i*mc)+mc+1), (j*nc)+1, std::min(n,(j*nc)+nc+1), n, grid);
+  for (int64_t i=0; i<num_blocks_m; i+=1) {
+    for (int64_t j=0; j<num_blocks_n; j+=1) {
+        // bind the tile to the node body
+        const int64_t startm = (i*mc)+1;
+        const int64_t endm   = std::min(m,(i*mc)+mc+1);
+        const int64_t startn = (j*nc)+1;
+        const int64_t endn   = std::min(n,(j*nc)+nc+1);
+        nodes.emplace_back(g, [=](const tbb::flow::continue_msg &){
+            PRK_TRACE_SCOPE("sweep_tile", startm, startn);
+            sweep_tile(startm, endm, startn, endn, n, grid);
         });
+        block_node_t & tmp = nodes.back();
 #if TBB_PREVIEW_FLOW_GRAPH_TRACE
-        sprintf(buffer, "block [ %d, %d ]", i, j );
-        tmp->set_name( buffer );
+        sprintf(buffer, "block [ %lld, %lld ]", static_cast<long long>(i), static_cast<long long>(j) );
+        tmp.set_name( buffer );
 #endif
-        nodes[i*num_blocks_n + j] = tmp;
         if (i>0)
-          make_edge(*nodes[(i-1)*num_blocks_n + j ], *tmp );
+          make_edge(nodes[(i-1)*num_blocks_n + j ], tmp );
         if (j>0)
-          make_edge(*nodes[ i   *num_blocks_n + j-1], *tmp );
+          make_edge(nodes[ i   *num_blocks_n + j-1], tmp );
         // Transitive dependencies from OpenMP task version:
-        //make_edge( *tmp, b );
         //if (i>0 && j>0)
-        //  make_edge(*nodes[(i-1)*num_blocks_n + j-1], *tmp );
+        //  make_edge(nodes[(i-1)*num_blocks_n + j-1], tmp );
     }
   }
-  auto start = true;
-  source_node<continue_msg> s(g, [&](continue_msg &v) -> bool {
-    if(start) { 
-      v = continue_msg();
-      start = false;
-      return true;
-    }
-    return false;
-  }, false);
-  
-  limiter_node<continue_msg> l(g, iterations+1, 1);
-
-  make_edge( s, l );
-  make_edge( l, *nodes[0] );
-  make_edge( *nodes[(num_blocks_n * num_blocks_m) - 1], b);
-  make_edge( b, l );
 
-#if TBB_PREVIEW_FLOW_GRAPH_TRACE
-  s.set_name("Source");
-  b.set_name("Iteration Barrier");
-  l.set_name("Limiter");
-#endif
+  graph_time = prk::wtime() - graph_time;
 
   //////////////////////////////////////////////////////////////////////
   // Perform the computation
@@ -201,7 +207,7 @@ int main(int argc, char* argv[])
 
   {
 
-    tbb::blocked_range2d<int> range(0, m, mc, 0, n, nc);
+    tbb::blocked_range2d<int64_t> range(0, m, mc, 0, n, nc);
     tbb::parallel_for( range, [&](decltype(range)& r) {
       for (auto i=r.rows().begin(); i!=r.rows().end(); ++i ) {
         for (auto j=r.cols().begin(); j!=r.cols().end(); ++j ) {
@@ -209,28 +215,29 @@ int main(int argc, char* argv[])
         }
       }
     }, tbb_partitioner);
-    for (auto j=0; j<n; j++) {
+    for (int64_t j=0; j<n; j++) {
       grid[0*n+j] = static_cast<double>(j);
     }
-    for (auto i=0; i<m; i++) {
+    for (int64_t i=0; i<m; i++) {
       grid[i*n+0] = static_cast<double>(i);
     }
 
-    s.activate();
-    g.wait_for_all();
-    
-    pipeline_time = prk::wtime() - pipeline_time;
+    block_node_t & first = nodes.front();
 
-  }
+    for (int iter = 0; iter<=iterations; iter++) {
 
-  //////////////////////////////////////////////////////////////////////
-  // Cleanup Flow Graph
-  //////////////////////////////////////////////////////////////////////
+      if (iter==1) pipeline_time = prk::wtime();
+
+      // the first block has no predecessors, so one message fires the
+      // whole sweep; every node resets itself after it has run
+      first.try_put(continue_msg());
+      g.wait_for_all();
 
-  for (int i=0; i<num_blocks_m; i+=1) {
-    for (int j=0; j<num_blocks_n; j+=1) {
-      delete nodes[i*num_blocks_n + j];
+      grid[0*n+0] = -grid[(m-1)*n+(n-1)];
     }
+
+    pipeline_time = prk::wtime() - pipeline_time;
+
   }
 
   //////////////////////////////////////////////////////////////////////
@@ -250,6 +257,8 @@ int main(int argc, char* argv[])
 #else
   std::cout << "Solution validates" << std::endl;
 #endif
+  std::cout << "Graph construction time (s): " << graph_time
+            << " per node (us): " << 1.e6*graph_time/num_blocks << std::endl;
   auto avgtime = pipeline_time/iterations;
   std::cout << "Rate (MFlops/s): "
             << 2.0e-6 * ( (m-1.)*(n-1.) )/avgtime
@@ -61,11 +61,12 @@
 
 #include "prk_util.h"
 #include "prk_tbb.h"
+#include "prk_affinity.h"
 
-void SequentialSweep(int m, int n, std::vector<double> & grid)
+void SequentialSweep(int64_t m, int64_t n, std::vector<double> & grid)
 {
-  for (auto i=1; i<m; i++) {
-    for (auto j=1; j<n; j++) {
+  for (int64_t i=1; i<m; i++) {
+    for (int64_t j=1; j<n; j++) {
       grid[i*n+j] = grid[(i-1)*n+j] + grid[i*n+(j-1)] - grid[(i-1)*n+(j-1)];
     }
   }
@@ -80,8 +81,8 @@ void ParallelSweep( const char* x, int xlen, const char* y, int ylen ) {
    // Initialize predecessor counts for blocks.
    int m = (xlen+N-1)/N;
    int n = (ylen+N-1)/N;
-   for( int i=0; i<m; ++i ) {
-       for( int j=0; j<n; ++j ) {
+   for (int64_t i=0; i<m; ++i ) {
+       for (int64_t j=0; j<n; ++j ) {
            Count[i][j] = (i>0)+(j>0);
        }
    }
@@ -124,8 +125,9 @@ int main(int argc, char* argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int m, n;
-  int mc, nc;
+  int64_t m, n;
+  int64_t mc, nc;
+  prk::affinity affinity;
   try {
       if (argc < 4){
         throw " <# iterations> <first array dimension> <second array dimension> [<first chunk dimension> <second chunk dimension>]";
@@ -138,22 +140,24 @@ int main(int argc, char* argv[])
       }
 
       // grid dimensions
-      m = std::atoi(argv[2]);
-      n = std::atoi(argv[3]);
+      m = std::atoll(argv[2]);
+      n = std::atoll(argv[3]);
       if (m < 1 || n < 1) {
         throw "ERROR: grid dimensions must be positive";
-      } else if ( static_cast<size_t>(m)*static_cast<size_t>(n) > INT_MAX) {
+      } else if ( static_cast<double>(m)*static_cast<double>(n) > INT64_MAX) {
         throw "ERROR: grid dimension too large - overflow risk";
       }
 
       // grid chunk dimensions
-      mc = (argc > 4) ? std::atoi(argv[4]) : m;
-      nc = (argc > 5) ? std::atoi(argv[5]) : n;
+      mc = (argc > 4) ? std::atoll(argv[4]) : m;
+      nc = (argc > 5) ? std::atoll(argv[5]) : n;
       if (mc < 1 || mc > m || nc < 1 || nc > n) {
         std::cout << "WARNING: grid chunk dimensions invalid: " << mc <<  nc << " (ignoring)" << std::endl;
         mc = m;
         nc = n;
       }
+
+      affinity = prk::get_affinity();
   }
   catch (const char * e) {
     std::cout << e << std::endl;
@@ -163,8 +167,10 @@ int main(int argc, char* argv[])
   const char* envvar = std::getenv("TBB_NUM_THREADS");
   int num_threads = (envvar!=NULL) ? std::atoi(envvar) : tbb::task_scheduler_init::default_num_threads();
   tbb::task_scheduler_init init(num_threads);
+  prk::affinity_observer observer(affinity);
 
   std::cout << "Number of threads    = " << num_threads << std::endl;
+  affinity.print(num_threads);
   std::cout << "Number of iterations = " << iterations << std::endl;
   std::cout << "Grid sizes           = " << m << ", " << n << std::endl;
   std::cout << "Grid chunk sizes     = " << mc << ", " << nc << std::endl;
@@ -179,10 +185,10 @@ int main(int argc, char* argv[])
   std::vector<double> grid(m*n,0.0);
 
   // set boundary values (bottom and left side of grid)
-  for (auto j=0; j<n; j++) {
+  for (int64_t j=0; j<n; j++) {
     grid[0*n+j] = static_cast<double>(j);
   }
-  for (auto i=0; i<m; i++) {
+  for (int64_t i=0; i<m; i++) {
     grid[i*n+0] = static_cast<double>(i);
   }
 
@@ -0,0 +1,269 @@
+///
+/// Copyright (c) 2013, Intel Corporation
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions
+/// are met:
+///
+/// * Redistributions of source code must retain the above copyright
+///       notice, this list of conditions and the following disclaimer.
+/// * Redistributions in binary form must reproduce the above
+///       copyright notice, this list of conditions and the following
+///       disclaimer in the documentation and/or other materials provided
+///       with the distribution.
+/// * Neither the name of Intel Corporation nor the names of its
+///       contributors may be used to endorse or promote products
+///       derived from this software without specific prior written
+///       permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+/// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+/// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+/// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+/// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+/// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+/// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+/// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+/// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+/// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+
+//////////////////////////////////////////////////////////////////////
+///
+/// NAME:    Pipeline
+///
+/// PURPOSE: This program tests the efficiency with which point-to-point
+///          synchronization can be carried out. It does so by executing
+///          a pipelined algorithm on an m*n grid. The first array dimension
+///          is distributed among the threads (stripwise decomposition).
+///
+/// USAGE:   The program takes as input the number of threads, the
+///          dimensions of the grid, the number of iterations on the grid,
+///          and optionally the width of the column chunks that are passed
+///          down the pipeline and the number of independent grids that are
+///          swept together:
+///
+///                <progname> <# threads> <iterations> <m> <n> [<chunk width> [<batch>]]
+///
+///          The output consists of diagnostics to make sure the
+///          algorithm worked, and of timing statistics.
+///
+/// NOTES:   Each thread owns a band of rows.  After finishing a column
+///          chunk of its band, a thread publishes the number of chunks it
+///          has completed in a cache-line-padded std::atomic counter
+///          (release), which its successor polls (acquire) before it
+///          starts on the same chunk.  Counters increase monotonically
+///          across iterations, so they never need to be reset.  The corner
+///          update that starts the next iteration is ordered the same way,
+///          through the counter of the last thread.
+///          In batch mode, every thread sweeps its band of all grids in
+///          turn, each grid with its own counters.  The corner update of
+///          one grid then overlaps with the sweeps of the others, so the
+///          pipeline does not drain between iterations.  The rate is the
+///          aggregate over all grids.
+///
+/// FUNCTIONS CALLED:
+///
+///          Other than standard C functions, the following
+///          functions are used in this program:
+///
+///          wtime()
+///          sweep_tile()
+///
+/// HISTORY: - Written by Rob Van der Wijngaart, February 2009.
+///            C99-ification by Jeff Hammond, February 2016.
+///            C++11-ification by Jeff Hammond, May 2017.
+///            std::thread pipeline with atomic flags, 2018.
+///
+//////////////////////////////////////////////////////////////////////
+
+#include "prk_util.h"
+#include "prk_barrier.h"
+#include "prk_affinity.h"
+#include "p2p-kernel.h"
+
+#include <mutex>
+#include <thread>
+
+int main(int argc, char* argv[])
+{
+  std::cout << "Parallel Research Kernels version " << PRKVERSION << std::endl;
+  std::cout << "C++11/Threads pipeline execution on 2D grid" << std::endl;
+
+  //////////////////////////////////////////////////////////////////////
+  // Process and test input parameters
+  //////////////////////////////////////////////////////////////////////
+
+  int nthread;
+  int iterations;
+  int64_t m, n;
+  int64_t nc;
+  int batch;
+  prk::affinity affinity;
+  try {
+      if (argc < 5){
+        throw " <# threads> <# iterations> <first array dimension> <second array dimension> [<chunk width> [<batch size>]]";
+      }
+
+      nthread = std::atoi(argv[1]);
+      if (nthread < 1) {
+        throw "ERROR: number of threads must be positive";
+      }
+
+      // number of times to run the pipeline algorithm
+      iterations  = std::atoi(argv[2]);
+      if (iterations < 1) {
+        throw "ERROR: iterations must be >= 1";
+      }
+
+      // grid dimensions
+      m = std::atoll(argv[3]);
+      n = std::atoll(argv[4]);
+      if (m < 1 || n < 1) {
+        throw "ERROR: grid dimensions must be positive";
+      } else if ( static_cast<double>(m)*static_cast<double>(n) > INT64_MAX) {
+        throw "ERROR: grid dimension too large - overflow risk";
+      }
+
+      if (nthread > m-1) {
+        throw "ERROR: each thread needs at least one row";
+      }
+
+      // width of the column chunks passed down the pipeline
+      nc = (argc > 5) ? std::atoll(argv[5]) : std::max<int64_t>(1,(n-1)/(4*nthread));
+      if (nc < 1 || nc > n) {
+        std::cout << "WARNING: grid chunk width invalid: " << nc << " (ignoring)" << std::endl;
+        nc = std::max<int64_t>(1,n-1);
+      }
+
+      // number of independent grids
+      batch = (argc > 6) ? std::atoi(argv[6]) : 1;
+      if (batch < 1) {
+        throw "ERROR: batch size must be positive";
+      }
+
+      affinity = prk::get_affinity();
+  }
+  catch (const char * e) {
+    std::cout << e << std::endl;
+    return 1;
+  }
+
+  std::cout << "Number of threads    = " << nthread << std::endl;
+  affinity.print(nthread);
+  std::cout << "Number of iterations = " << iterations << std::endl;
+  std::cout << "Grid sizes           = " << m << ", " << n << std::endl;
+  std::cout << "Grid chunk width     = " << nc << std::endl;
+  std::cout << "Batch size           = " << batch << std::endl;
+  std::cout << "Sweep ISA            = " << sweep_tile_isa().name << std::endl;
+
+  //////////////////////////////////////////////////////////////////////
+  // Allocate space and perform the computation
+  //////////////////////////////////////////////////////////////////////
+
+  std::vector<std::vector<double>> grids(batch, std::vector<double>(m*n,0.0));
+
+  // set boundary values (bottom and left side of grid)
+  for (auto & grid : grids) {
+    for (int64_t j=0; j<n; j++) {
+      grid[0*n+j] = static_cast<double>(j);
+    }
+    for (int64_t i=0; i<m; i++) {
+      grid[i*n+0] = static_cast<double>(i);
+    }
+  }
+
+  const int64_t nchunks = prk::divceil(n-1,nc);
+
+  // progress[b*nthread+t] = number of chunks of grid b thread t has completed,
+  // over all iterations
+  std::vector<prk::padded<std::atomic<int64_t>>> progress(batch*nthread);
+  for (auto & p : progress) p.value.store(0);
+
+  double start_time = 0.0;
+  double stop_time  = 0.0;
+
+  prk::counters counters;
+  std::mutex counters_mutex;
+
+  std::vector<std::thread> pool;
+  for (int t=0; t<nthread; t++) {
+    pool.push_back(std::thread([=,&grids,&progress,&start_time,&stop_time,&counters,&counters_mutex,&affinity] {
+
+      affinity.pin(t);
+      prk::counters mine;
+
+      // rows [first,last) of the interior belong to me
+      const int64_t first = 1 + ((m-1)*t)/nthread;
+      const int64_t last  = 1 + ((m-1)*(t+1))/nthread;
+
+      for (int iter = 0; iter<=iterations; iter++) {
+        if (iter==1) mine.start();
+        for (int b=0; b<batch; b++) {
+
+          double * RESTRICT pgrid = grids[b].data();
+          auto & done = progress[b*nthread+t].value;
+
+          // the first thread needs the corner value written by the last one
+          if (t==0) {
+            auto & corner = progress[b*nthread+nthread-1].value;
+            const int64_t needed = iter*nchunks;
+            prk::spin_wait([&] { return corner.load(std::memory_order_acquire) >= needed; });
+            if (iter==1 && b==0) start_time = prk::wtime();
+          }
+
+          for (int64_t c=0; c<nchunks; c++) {
+            const int64_t j = 1 + c*nc;
+            if (t>0) {
+              auto & above = progress[b*nthread+t-1].value;
+              const int64_t ready = iter*nchunks + c + 1;
+              prk::spin_wait([&] { return above.load(std::memory_order_acquire) >= ready; });
+            }
+            sweep_tile(first, last, j, std::min(n,j+nc), n, pgrid);
+            if (t==nthread-1 && c==nchunks-1) {
+              pgrid[0*n+0] = -pgrid[(m-1)*n+(n-1)];
+              if (iter==iterations && b==batch-1) stop_time = prk::wtime();
+            }
+            done.store(iter*nchunks + c + 1, std::memory_order_release);
+          }
+        }
+      }
+      mine.stop();
+      std::lock_guard<std::mutex> lock(counters_mutex);
+      counters += mine;
+    }));
+  }
+  std::for_each(pool.begin(), pool.end(), [](std::thread & t) { t.join(); });
+
+  auto pipeline_time = stop_time - start_time;
+
+  //////////////////////////////////////////////////////////////////////
+  // Analyze and output results.
+  //////////////////////////////////////////////////////////////////////
+
+  const double epsilon = 1.e-8;
+  auto corner_val = ((iterations+1.)*(n+m-2.));
+  for (auto & grid : grids) {
+    if ( (std::fabs(grid[(m-1)*n+(n-1)] - corner_val)/corner_val) > epsilon) {
+      std::cout << "ERROR: checksum " << grid[(m-1)*n+(n-1)]
+                << " does not match verification value " << corner_val << std::endl;
+      return 1;
+    }
+  }
+
+#ifdef VERBOSE
+  std::cout << "Solution validates; verification value = " << corner_val << std::endl;
+#else
+  std::cout << "Solution validates" << std::endl;
+#endif
+  auto avgtime = pipeline_time/iterations;
+  std::cout << "Rate (MFlops/s): "
+            << 2.0e-6 * batch * ( (m-1.)*(n-1.) )/avgtime
+            << " Avg time (s): " << avgtime << std::endl;
+  const prk::work_model work{batch*2.0*(m-1.)*(n-1.), batch*2.0*m*n*sizeof(double)};
+  counters.print(iterations*work.bytes, iterations*work.flops);
+  prk::roofline::print(work, avgtime, nthread);
+
+  return 0;
+}
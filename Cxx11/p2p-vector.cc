@@ -72,9 +72,11 @@ int main(int argc, char* argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int m, n;
-  int mc, nc;
+  int64_t m, n;
+  int64_t mc, nc;
   try {
+      prk::cold::parse(argc, argv);
+
       if (argc < 4){
         throw " <# iterations> <first array dimension> <second array dimension> [<first chunk dimension> <second chunk dimension>]";
       }
@@ -86,17 +88,17 @@ int main(int argc, char* argv[])
       }
 
       // grid dimensions
-      m = std::atoi(argv[2]);
-      n = std::atoi(argv[3]);
+      m = std::atoll(argv[2]);
+      n = std::atoll(argv[3]);
       if (m < 1 || n < 1) {
         throw "ERROR: grid dimensions must be positive";
-      } else if ( static_cast<size_t>(m)*static_cast<size_t>(n) > INT_MAX) {
+      } else if ( static_cast<double>(m)*static_cast<double>(n) > INT64_MAX) {
         throw "ERROR: grid dimension too large - overflow risk";
       }
 
       // grid chunk dimensions
-      mc = (argc > 4) ? std::atoi(argv[4]) : m;
-      nc = (argc > 5) ? std::atoi(argv[5]) : n;
+      mc = (argc > 4) ? std::atoll(argv[4]) : m;
+      nc = (argc > 5) ? std::atoll(argv[5]) : n;
       if (mc < 1 || mc > m || nc < 1 || nc > n) {
         std::cout << "WARNING: grid chunk dimensions invalid: " << mc <<  nc << " (ignoring)" << std::endl;
         mc = m;
@@ -109,54 +111,46 @@ int main(int argc, char* argv[])
   }
 
   std::cout << "Number of iterations = " << iterations << std::endl;
+  prk::cold::print();
   std::cout << "Grid sizes           = " << m << ", " << n << std::endl;
   std::cout << "Grid chunk sizes     = " << mc << ", " << nc << std::endl;
+  std::cout << "Sweep ISA            = " << sweep_tile_isa().name << std::endl;
 
   //////////////////////////////////////////////////////////////////////
   // Allocate space and perform the computation
   //////////////////////////////////////////////////////////////////////
 
   auto pipeline_time = 0.0; // silence compiler warning
+  prk::counters counters;
 
   std::vector<double> grid(m*n,0.0);;
 
   {
     // set boundary values (bottom and left side of grid)
-    for (int j=0; j<n; j++) {
+    for (int64_t j=0; j<n; j++) {
       grid[0*n+j] = static_cast<double>(j);
     }
-    for (int i=0; i<m; i++) {
+    for (int64_t i=0; i<m; i++) {
       grid[i*n+0] = static_cast<double>(i);
     }
 
     for (int iter = 0; iter<=iterations; iter++) {
 
-      if (iter==1) pipeline_time = prk::wtime();
+      prk::cold::flush(counters, {grid});
+
+      if (iter==1) {
+        pipeline_time = prk::wtime();
+        counters.start();
+        prk::cold::start();
+      }
 
       double * RESTRICT pgrid = grid.data();
 
-      if (mc==m && nc==n) {
-        for (int i=1; i<m; i++) {
-          double olda = grid[  i  *n];
-          double oldb = grid[(i-1)*n];
-          for (int j=1; j<n; j++) {
-            double const newb = grid[(i-1)*n+j];
-            double const newa = newb - oldb + olda;
-            grid[i*n+j] = newa;
-            olda = newa;
-            oldb = newb;
-          }
-        }
-      } else {
-        for (int i=1; i<m; i+=mc) {
-          for (int j=1; j<n; j+=nc) {
-            sweep_tile(i, std::min(m,i+mc), j, std::min(n,j+nc), n, pgrid);
-          }
-        }
-      }
+      sweep_tiles(m, n, mc, nc, pgrid);
       pgrid[0*n+0] = -pgrid[(m-1)*n+(n-1)];
     }
-    pipeline_time = prk::wtime() - pipeline_time;
+    pipeline_time = prk::wtime() - pipeline_time - prk::cold::elapsed();
+    counters.stop();
   }
 
   //////////////////////////////////////////////////////////////////////
@@ -180,6 +174,9 @@ int main(int argc, char* argv[])
   std::cout << "Rate (MFlops/s): "
             << 2.0e-6 * ( (m-1.)*(n-1.) )/avgtime
             << " Avg time (s): " << avgtime << std::endl;
+  const prk::work_model work{2.0*(m-1.)*(n-1.), 2.0*m*n*sizeof(double)};
+  counters.print(iterations*work.bytes, iterations*work.flops);
+  prk::roofline::print(work, avgtime);
 
   return 0;
 }
@@ -0,0 +1,332 @@
+///
+/// Copyright (c) 2018, Intel Corporation
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions
+/// are met:
+///
+/// * Redistributions of source code must retain the above copyright
+///       notice, this list of conditions and the following disclaimer.
+/// * Redistributions in binary form must reproduce the above
+///       copyright notice, this list of conditions and the following
+///       disclaimer in the documentation and/or other materials provided
+///       with the distribution.
+/// * Neither the name of Intel Corporation nor the names of its
+///       contributors may be used to endorse or promote products
+///       derived from this software without specific prior written
+///       permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+/// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+/// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+/// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+/// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+/// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+/// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+/// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+/// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+/// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef PIC_KERNEL_H
+#define PIC_KERNEL_H
+
+#include "prk_openmp.h"
+#include "prk_random_draw.h"
+
+#define RESTRICT __restrict__
+
+// M_PI is not defined in strict C++
+#ifdef M_PI
+#define PRK_M_PI M_PI
+#else
+#define PRK_M_PI 3.14159265358979323846264338327950288419716939937510
+#endif
+
+// The physical constants and the particle placement follow SERIAL/PIC/pic.c,
+// so that the C++ drivers place the same particles and verify the same way.
+
+const double MASS_INV = 1.0;
+const double Q        = 1.0;
+const double DT       = 1.0;
+const double REL_X    = 0.5;
+const double REL_Y    = 0.5;
+
+enum pic_mode { GEOMETRIC, SINUSOIDAL, LINEAR, PATCH, UNDEFINED };
+
+struct bbox_t {
+    uint64_t left;
+    uint64_t right;
+    uint64_t bottom;
+    uint64_t top;
+};
+
+inline bool bad_patch(const bbox_t & patch, const bbox_t & patch_contain)
+{
+    if (patch.left>=patch.right || patch.bottom>=patch.top) return true;
+    if (patch.left  <patch_contain.left   || patch.right>patch_contain.right) return true;
+    if (patch.bottom<patch_contain.bottom || patch.top  >patch_contain.top)   return true;
+    return false;
+}
+
+// Structure-of-arrays particle store.  The fields that are read and written
+// every time step are kept apart from the ones used only for verification,
+// so the push streams through five dense arrays.
+struct particles_t {
+    // hot
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> v_x;
+    std::vector<double> v_y;
+    std::vector<double> q;
+    // verification only
+    std::vector<double> x0;
+    std::vector<double> y0;
+    std::vector<int64_t> k; // determines how many cells particles move per time step in the x direction
+    std::vector<int64_t> m; // determines how many cells particles move per time step in the y direction
+
+    size_t size() const { return x.size(); }
+
+    void resize(size_t n) {
+        x.resize(n); y.resize(n); v_x.resize(n); v_y.resize(n); q.resize(n);
+        x0.resize(n); y0.resize(n); k.resize(n); m.resize(n);
+    }
+};
+
+// The grid of charges is stored column by column: Qgrid[x*(L+1)+y].
+inline std::vector<double> initialize_grid(uint64_t L)
+{
+    std::vector<double> Qgrid((L+1)*(L+1));
+    // initialization with dipoles
+    for (uint64_t x=0; x<=L; x++) {
+        for (uint64_t y=0; y<=L; y++) {
+            Qgrid[x*(L+1)+y] = (x%2 == 0) ? Q : -Q;
+        }
+    }
+    return Qgrid;
+}
+
+inline void finish_distribution(particles_t & p)
+{
+    const size_t n = p.size();
+    OMP_FOR()
+    for (size_t i=0; i<n; i++) {
+        const double x_coord = p.x[i];
+        const double y_coord = p.y[i];
+        const double rel_x = std::fmod(x_coord,1.0);
+        const double rel_y = std::fmod(y_coord,1.0);
+        const uint64_t x = static_cast<uint64_t>(x_coord);
+        const double r1_sq = rel_y * rel_y + rel_x * rel_x;
+        const double r2_sq = rel_y * rel_y + (1.0-rel_x) * (1.0-rel_x);
+        const double cos_theta = rel_x/std::sqrt(r1_sq);
+        const double cos_phi = (1.0-rel_x)/std::sqrt(r2_sq);
+        const double base_charge = 1.0 / ((DT*DT) * Q * (cos_theta/r1_sq + cos_phi/r2_sq));
+
+        p.v_x[i] = 0.0;
+        p.v_y[i] = static_cast<double>(p.m[i]) / DT;
+        // this particle charge assures movement in positive x-direction
+        p.q[i] = (x%2 == 0) ? (2*p.k[i]+1) * base_charge : -1.0 * (2*p.k[i]+1) * base_charge;
+        p.x0[i] = x_coord;
+        p.y0[i] = y_coord;
+    }
+}
+
+// Like the C version, the generator is run twice over the cells: once to
+// count the particles and once, from the same seed, to place them.
+// draw_cell(dice,x,y) returns the number of particles in cell (x,y).
+// Every draw consumes exactly two numbers, so the draw for cell x*L+y
+// starts at position 2*(x*L+y) of the sequence.  Each thread jumps there
+// for its own range of cells, which places the same particles as the
+// serial code in parallel.
+template <typename F>
+void place_particles(uint64_t L, int64_t k, int64_t m, particles_t & p, F draw_cell)
+{
+    const uint64_t ncells = L*L;
+    std::vector<size_t> offset;
+
+    OMP_PARALLEL()
+    {
+#ifdef _OPENMP
+        const int me = omp_get_thread_num();
+        const int nt = omp_get_num_threads();
+#else
+        const int me = 0;
+        const int nt = 1;
+#endif
+        OMP_MASTER
+        offset.assign(nt+1,0);
+        OMP_BARRIER
+
+        const uint64_t first = (ncells*me)/nt;
+        const uint64_t last  = (ncells*(me+1))/nt;
+
+        prk::random_draw dice;
+        dice.jump(2*first);
+        size_t n_placed(0);
+        for (uint64_t c=first; c<last; c++) {
+            n_placed += draw_cell(dice, c/L, c%L);
+        }
+        offset[me+1] = n_placed;
+        OMP_BARRIER
+
+        OMP_MASTER
+        {
+            std::partial_sum(offset.begin(), offset.end(), offset.begin());
+            p.resize(offset[nt]);
+        }
+        OMP_BARRIER
+
+        dice.jump(2*first);
+        size_t pi = offset[me];
+        for (uint64_t c=first; c<last; c++) {
+            const uint64_t x = c/L;
+            const uint64_t y = c%L;
+            const uint64_t actual_particles = draw_cell(dice, x, y);
+            for (uint64_t j=0; j<actual_particles; j++,pi++) {
+                p.x[pi] = x + REL_X;
+                p.y[pi] = y + REL_Y;
+                p.k[pi] = k;
+                p.m[pi] = m;
+            }
+        }
+        OMP_BARRIER
+
+        finish_distribution(p);
+    }
+}
+
+// Each cell in the i-th column of cells contains p(i) = A * rho^i particles
+inline void initialize_geometric(uint64_t n_input, uint64_t L, double rho, int64_t k, int64_t m,
+                                 particles_t & p)
+{
+    const double A = n_input * ((1.0-rho) / (1.0-std::pow(rho,L))) / static_cast<double>(L);
+    place_particles(L, k, m, p, [&](prk::random_draw & dice, uint64_t x, uint64_t) {
+        return dice.draw(A * std::pow(rho, x));
+    });
+}
+
+// number of particles in a column of cells is proportional to a sinusoidal weight
+inline void initialize_sinusoidal(uint64_t n_input, uint64_t L, int64_t k, int64_t m,
+                                  particles_t & p)
+{
+    const double step = PRK_M_PI/L;
+    place_particles(L, k, m, p, [&](prk::random_draw & dice, uint64_t x, uint64_t) {
+        return dice.draw(2.0*std::cos(x*step)*std::cos(x*step)*n_input/(L*L));
+    });
+}
+
+// The linear function is f(x) = -alpha * x + beta , x in [0,1]
+inline void initialize_linear(uint64_t n_input, uint64_t L, double alpha, double beta,
+                              int64_t k, int64_t m, particles_t & p)
+{
+    const double step = 1.0/L;
+    // sum of all weights, to normalize the number of particles
+    const double total_weight = beta*L-alpha*0.5*step*L*(L-1);
+    place_particles(L, k, m, p, [&](prk::random_draw & dice, uint64_t x, uint64_t) {
+        const double current_weight = (beta - alpha * step * static_cast<double>(x));
+        return dice.draw(n_input * (current_weight/total_weight)/L);
+    });
+}
+
+// uniform number of particles per cell within the patch, none elsewhere
+inline void initialize_patch(uint64_t n_input, uint64_t L, bbox_t patch, int64_t k, int64_t m,
+                             particles_t & p)
+{
+    const uint64_t total_cells  = (patch.right - patch.left+1)*(patch.top - patch.bottom+1);
+    const double particles_per_cell = static_cast<double>(n_input)/total_cells;
+    place_particles(L, k, m, p, [&](prk::random_draw & dice, uint64_t x, uint64_t y) {
+        // the draw is made for every cell, so the sequence matches the C version
+        const uint64_t actual_particles = dice.draw(particles_per_cell);
+        const bool outside = (x<patch.left || x>patch.right || y<patch.bottom || y>patch.top);
+        return outside ? 0 : actual_particles;
+    });
+}
+
+// Moves particles [first,last) by one time step.  The body is branch-free
+// and works on the SoA arrays directly, so that it can be vectorized; only
+// the four charges of the enclosing cell are gathered.
+inline void push_particles(size_t first, size_t last, uint64_t L,
+                           const double * RESTRICT Qgrid, particles_t & p)
+{
+    double * RESTRICT px  = p.x.data();
+    double * RESTRICT py  = p.y.data();
+    double * RESTRICT pvx = p.v_x.data();
+    double * RESTRICT pvy = p.v_y.data();
+    const double * RESTRICT pq = p.q.data();
+    const double fL = static_cast<double>(L);
+
+    PRAGMA_SIMD
+    for (size_t i=first; i<last; i++) {
+        const double x = px[i];
+        const double y = py[i];
+        const double q = pq[i];
+
+        // coordinates of the cell containing the particle
+        const uint64_t ix = static_cast<uint64_t>(x);
+        const uint64_t iy = static_cast<uint64_t>(y);
+        const double rel_x = x - ix;
+        const double rel_y = y - iy;
+
+        const double q00 = Qgrid[ ix   *(L+1)+iy  ];
+        const double q01 = Qgrid[ ix   *(L+1)+iy+1];
+        const double q10 = Qgrid[(ix+1)*(L+1)+iy  ];
+        const double q11 = Qgrid[(ix+1)*(L+1)+iy+1];
+
+        // Coulomb forces from the four charges at the corners of the cell
+        const double r2_00 = rel_x*rel_x + rel_y*rel_y;
+        const double r2_01 = rel_x*rel_x + (1.0-rel_y)*(1.0-rel_y);
+        const double r2_10 = (1.0-rel_x)*(1.0-rel_x) + rel_y*rel_y;
+        const double r2_11 = (1.0-rel_x)*(1.0-rel_x) + (1.0-rel_y)*(1.0-rel_y);
+        const double f_00 = q * q00 / (r2_00 * std::sqrt(r2_00));
+        const double f_01 = q * q01 / (r2_01 * std::sqrt(r2_01));
+        const double f_10 = q * q10 / (r2_10 * std::sqrt(r2_10));
+        const double f_11 = q * q11 / (r2_11 * std::sqrt(r2_11));
+
+        const double fx = f_00 * rel_x + f_01 * rel_x
+                        - f_10 * (1.0-rel_x) - f_11 * (1.0-rel_x);
+        const double fy = f_00 * rel_y - f_01 * (1.0-rel_y)
+                        + f_10 * rel_y - f_11 * (1.0-rel_y);
+
+        const double ax = fx * MASS_INV;
+        const double ay = fy * MASS_INV;
+
+        // update particle positions, taking into account periodic boundaries
+        px[i] = std::fmod(x + pvx[i]*DT + 0.5*ax*DT*DT + fL, fL);
+        py[i] = std::fmod(y + pvy[i]*DT + 0.5*ay*DT*DT + fL, fL);
+
+        // update velocities
+        pvx[i] += ax * DT;
+        pvy[i] += ay * DT;
+    }
+}
+
+// Verifies the final position of particles [first,last)
+inline bool verify_particles(size_t first, size_t last, uint64_t iterations,
+                             const std::vector<double> & Qgrid, uint64_t L,
+                             const particles_t & p)
+{
+    const double epsilon = 0.000001;
+    bool correct = true;
+    for (size_t i=first; i<last; i++) {
+        // coordinates of the cell containing the particle initially
+        const uint64_t y = static_cast<uint64_t>(p.y0[i]);
+        const uint64_t x = static_cast<uint64_t>(p.x0[i]);
+
+        // according to initial location and charge determine the direction of displacements
+        const double disp = static_cast<double>(iterations+1)*(2*p.k[i]+1);
+        const double x_final = ( (p.q[i] * Qgrid[x*(L+1)+y]) > 0) ? p.x0[i]+disp : p.x0[i]-disp;
+        const double y_final = p.y0[i] + p.m[i] * static_cast<double>(iterations+1);
+
+        // apply periodicity, making sure we never mod a negative value
+        const double x_periodic = std::fmod(x_final+static_cast<double>(iterations+1) *(2*p.k[i]+1)*L, L);
+        const double y_periodic = std::fmod(y_final+static_cast<double>(iterations+1) *std::llabs(p.m[i])*L, L);
+
+        if ( std::fabs(p.x[i] - x_periodic) > epsilon || std::fabs(p.y[i] - y_periodic) > epsilon) {
+            correct = false;
+        }
+    }
+    return correct;
+}
+
+#endif /* PIC_KERNEL_H */
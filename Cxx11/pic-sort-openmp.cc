@@ -0,0 +1,415 @@
+///
+/// Copyright (c) 2015, Intel Corporation
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions
+/// are met:
+///
+/// * Redistributions of source code must retain the above copyright
+///       notice, this list of conditions and the following disclaimer.
+/// * Redistributions in binary form must reproduce the above
+///       copyright notice, this list of conditions and the following
+///       disclaimer in the documentation and/or other materials provided
+///       with the distribution.
+/// * Neither the name of Intel Corporation nor the names of its
+///       contributors may be used to endorse or promote products
+///       derived from this software without specific prior written
+///       permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+/// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+/// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+/// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+/// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+/// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+/// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+/// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+/// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+/// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+
+//////////////////////////////////////////////////////////////////////
+///
+/// NAME:    PIC
+///
+/// PURPOSE: This program tests the efficiency with which a cloud of
+///          charged particles can be moved through a spatially fixed
+///          collection of charges located at the vertices of a square
+///          equi-spaced grid. It is a proxy for a component of a
+///          particle-in-cell method
+///
+///          In this version the particles are kept binned by the cell
+///          they occupy, so that particles sharing the same four charges
+///          are pushed together.  Every <sort period> steps the bins are
+///          rebuilt with a parallel counting sort (0 means never).  Threads
+///          push contiguous ranges of bins with equal numbers of particles.
+///
+/// USAGE:   <progname> <#simulation steps> <grid size> <#particles>
+///                     <k (particle charge semi-increment)>
+///                     <m (vertical particle velocity)>
+///                     <sort period> <init mode> <init parameters>
+///
+///          The output consists of diagnostics to make sure the
+///          algorithm worked, and of timing statistics.  The time spent
+///          sorting and the time spent pushing are reported separately.
+///
+/// FUNCTIONS CALLED:
+///
+///          Other than standard C functions, the following functions are used in
+///          this program:
+///          wtime()
+///          bad_patch()
+///          prk::random_draw
+///
+/// HISTORY: - Written by Evangelos Georganas, August 2015.
+///          - RvdW: Refactored to make the code PRK conforming, December 2015
+///            C++11-ification with structure-of-arrays particles, 2018.
+///            Cell-sorted particle bins and OpenMP push, 2018.
+///
+//////////////////////////////////////////////////////////////////////
+
+#include "prk_util.h"
+#include "prk_openmp.h"
+#include "pic-kernel.h"
+
+// Copies all the fields of particle i of src into slot j of dst.
+static inline void move_particle(const particles_t & src, size_t i, particles_t & dst, size_t j)
+{
+    dst.x[j]   = src.x[i];
+    dst.y[j]   = src.y[i];
+    dst.v_x[j] = src.v_x[i];
+    dst.v_y[j] = src.v_y[i];
+    dst.q[j]   = src.q[i];
+    dst.x0[j]  = src.x0[i];
+    dst.y0[j]  = src.y0[i];
+    dst.k[j]   = src.k[i];
+    dst.m[j]   = src.m[i];
+}
+
+// Stable parallel counting sort of the particles by cell.  Must be called by
+// all threads of the enclosing parallel region.  Cell x*L+y lies in row x of
+// the grid, and the sort has two passes so that no thread needs a histogram
+// of all L*L cells:
+//
+// 1. A counting sort by row from p into scratch.  Each thread counts and
+//    later scatters the same static chunk of particles, so the per-thread
+//    offsets into each row preserve the original order.  row_counts holds
+//    one histogram of the L rows per thread.
+// 2. A counting sort by cell of each row from scratch back into p, one row
+//    per thread at a time.  cell_counts holds one histogram of the L cells
+//    of a row per thread.
+//
+// The cost is O(n + L*L + threads*L) per sort.
+static void bin_particles(uint64_t L, particles_t & p, particles_t & scratch,
+                          std::vector<size_t> & row_counts, std::vector<size_t> & row_start,
+                          std::vector<size_t> & cell_counts, std::vector<size_t> & bin_start)
+{
+#ifdef _OPENMP
+    const int nt = omp_get_num_threads();
+    const int me = omp_get_thread_num();
+#else
+    const int nt = 1;
+    const int me = 0;
+#endif
+    const size_t n = p.size();
+    const size_t first = me*n/nt;
+    const size_t last  = (me+1)*n/nt;
+
+    size_t * RESTRICT mine = &row_counts[me*L];
+    std::fill(mine, mine+L, 0);
+    for (size_t i=first; i<last; i++) {
+        mine[static_cast<uint64_t>(p.x[i])]++;
+    }
+    OMP_BARRIER
+
+    // per-thread offsets within each row; row_start temporarily holds row sizes
+    OMP_FOR()
+    for (uint64_t x=0; x<L; x++) {
+        size_t s(0);
+        for (int t=0; t<nt; t++) {
+            const size_t c = row_counts[t*L+x];
+            row_counts[t*L+x] = s;
+            s += c;
+        }
+        row_start[x] = s;
+    }
+
+    OMP_MASTER
+    {
+        size_t s(0);
+        for (uint64_t x=0; x<L; x++) {
+            const size_t c = row_start[x];
+            row_start[x] = s;
+            s += c;
+        }
+        row_start[L] = s;
+        bin_start[L*L] = s;
+    }
+    OMP_BARRIER
+
+    for (size_t i=first; i<last; i++) {
+        const uint64_t x = static_cast<uint64_t>(p.x[i]);
+        move_particle(p, i, scratch, row_start[x] + mine[x]++);
+    }
+    OMP_BARRIER
+
+    // rows hold different numbers of particles
+    size_t * RESTRICT cells = &cell_counts[me*L];
+    OMP_FOR(schedule(dynamic))
+    for (uint64_t x=0; x<L; x++) {
+        std::fill(cells, cells+L, 0);
+        for (size_t i=row_start[x]; i<row_start[x+1]; i++) {
+            cells[static_cast<uint64_t>(scratch.y[i])]++;
+        }
+        size_t s = row_start[x];
+        for (uint64_t y=0; y<L; y++) {
+            const size_t c = cells[y];
+            bin_start[x*L+y] = s;
+            cells[y] = s;
+            s += c;
+        }
+        for (size_t i=row_start[x]; i<row_start[x+1]; i++) {
+            move_particle(scratch, i, p, cells[static_cast<uint64_t>(scratch.y[i])]++);
+        }
+    }
+}
+
+// First (side=0) or one-past-last (side=1) particle pushed by the calling
+// thread.  Sorted particles are split at bin boundaries into ranges holding
+// about the same number of particles.
+static size_t push_range(int side, size_t n, const std::vector<size_t> & bin_start, bool sorted)
+{
+#ifdef _OPENMP
+    const int nt = omp_get_num_threads();
+    const int me = omp_get_thread_num();
+#else
+    const int nt = 1;
+    const int me = 0;
+#endif
+    const size_t target = (me+side)*n/nt;
+    if (!sorted || target == n) return target;
+    return *std::lower_bound(bin_start.begin(), bin_start.end(), target);
+}
+
+int main(int argc, char* argv[])
+{
+  std::cout << "Parallel Research Kernels version " << PRKVERSION << std::endl;
+  std::cout << "C++11/OpenMP cell-sorted Particle-in-Cell execution on 2D grid" << std::endl;
+
+  //////////////////////////////////////////////////////////////////////
+  // Process and test input parameters
+  //////////////////////////////////////////////////////////////////////
+
+  uint64_t iterations;   // total number of simulation steps
+  uint64_t L;            // dimension of grid in cells
+  uint64_t n;            // total number of particles requested
+  int64_t k, m;          // determine initial horizontal and vertical velocity of
+                         // particles-- (2*k)+1 cells per time step
+  uint64_t sort_period;  // number of time steps between sorts of the particles
+  std::string init_mode; // particle initialization mode
+  pic_mode particle_mode = UNDEFINED;
+  double rho(0);         // attenuation factor for geometric particle distribution
+  double alpha(0), beta(0); // slope and offset values for linear particle distribution
+  bbox_t init_patch = {0,0,0,0}; // subset of grid used for localized initialization
+  try {
+      if (argc < 8) {
+        throw "Usage: <#simulation steps> <grid size> <#particles> <k (particle charge semi-increment)>\n"
+              "       <m (vertical particle velocity)> <sort period> <init mode> <init parameters>\n"
+              "   init mode \"GEOMETRIC\"  parameters: <attenuation factor>\n"
+              "             \"SINUSOIDAL\" parameters: none\n"
+              "             \"LINEAR\"     parameters: <negative slope> <constant offset>\n"
+              "             \"PATCH\"      parameters: <xleft> <xright>  <ybottom> <ytop>";
+      }
+
+      iterations = std::atol(argv[1]);
+      if (std::atol(argv[1]) < 1) {
+        throw "ERROR: Number of time steps must be positive";
+      }
+
+      L = std::atol(argv[2]);
+      if (std::atol(argv[2]) < 1 || L%2) {
+        throw "ERROR: Number of grid cells must be positive and even";
+      }
+
+      n = std::atol(argv[3]);
+      if (std::atol(argv[3]) < 1) {
+        throw "ERROR: Number of particles must be positive";
+      }
+
+      k = std::atoi(argv[4]);
+      if (k < 0) {
+        throw "ERROR: Particle semi-charge must be non-negative";
+      }
+      m = std::atoi(argv[5]);
+
+      sort_period = std::atol(argv[6]);
+      if (std::atol(argv[6]) < 0) {
+        throw "ERROR: Sort period must be non-negative";
+      }
+
+      init_mode = std::string(argv[7]);
+      if (init_mode == "GEOMETRIC") {
+        if (argc < 9) {
+          throw "ERROR: Not enough arguments for GEOMETRIC";
+        }
+        particle_mode = GEOMETRIC;
+        rho = std::atof(argv[8]);
+      } else if (init_mode == "SINUSOIDAL") {
+        particle_mode = SINUSOIDAL;
+      } else if (init_mode == "LINEAR") {
+        if (argc < 10) {
+          throw "ERROR: Not enough arguments for LINEAR initialization";
+        }
+        particle_mode = LINEAR;
+        alpha = std::atof(argv[8]);
+        beta  = std::atof(argv[9]);
+        if (beta < 0 || beta < alpha) {
+          throw "ERROR: linear profile gives negative particle density";
+        }
+      } else if (init_mode == "PATCH") {
+        if (argc < 12) {
+          throw "ERROR: Not enough arguments for PATCH initialization";
+        }
+        particle_mode = PATCH;
+        init_patch.left   = std::atoi(argv[8]);
+        init_patch.right  = std::atoi(argv[9]);
+        init_patch.bottom = std::atoi(argv[10]);
+        init_patch.top    = std::atoi(argv[11]);
+        bbox_t grid_patch = {0, L+1, 0, L+1};
+        if (bad_patch(init_patch, grid_patch)) {
+          throw "ERROR: inconsistent initial patch";
+        }
+      } else {
+        throw "ERROR: Unsupported particle initializating mode";
+      }
+  }
+  catch (const char * e) {
+    std::cout << e << std::endl;
+    return 1;
+  }
+
+#ifdef _OPENMP
+  std::cout << "Number of threads              = " << omp_get_max_threads() << std::endl;
+#endif
+  std::cout << "Grid size                      = " << L << std::endl;
+  std::cout << "Number of particles requested  = " << n << std::endl;
+  std::cout << "Number of time steps           = " << iterations << std::endl;
+  std::cout << "Initialization mode            = " << init_mode << std::endl;
+  switch (particle_mode) {
+    case GEOMETRIC:  std::cout << "  Attenuation factor           = " << rho << std::endl; break;
+    case SINUSOIDAL: break;
+    case LINEAR:     std::cout << "  Negative slope               = " << alpha << std::endl;
+                     std::cout << "  Offset                       = " << beta << std::endl; break;
+    case PATCH:      std::cout << "  Bounding box                 = "
+                               << init_patch.left << ", " << init_patch.right << ", "
+                               << init_patch.bottom << ", " << init_patch.top << std::endl; break;
+    default: break;
+  }
+  std::cout << "Particle charge semi-increment = " << k << std::endl;
+  std::cout << "Vertical velocity              = " << m << std::endl;
+  if (sort_period > 0) {
+    std::cout << "Sort period                    = " << sort_period << std::endl;
+  } else {
+    std::cout << "Particles are not sorted" << std::endl;
+  }
+
+  //////////////////////////////////////////////////////////////////////
+  // Initialize grid of charges and particles
+  //////////////////////////////////////////////////////////////////////
+
+  auto Qgrid = initialize_grid(L);
+
+  particles_t particles;
+  switch (particle_mode) {
+    case GEOMETRIC:  initialize_geometric(n, L, rho, k, m, particles);         break;
+    case SINUSOIDAL: initialize_sinusoidal(n, L, k, m, particles);             break;
+    case LINEAR:     initialize_linear(n, L, alpha, beta, k, m, particles);    break;
+    case PATCH:      initialize_patch(n, L, init_patch, k, m, particles);      break;
+    default: break;
+  }
+  n = particles.size();
+
+  std::cout << "Number of particles placed     = " << n << std::endl;
+
+  //////////////////////////////////////////////////////////////////////
+  // Perform the computation
+  //////////////////////////////////////////////////////////////////////
+
+  auto sort_time = 0.0;
+  auto push_time = 0.0;
+
+  particles_t scratch;
+  scratch.resize(n);
+
+  // bin_start[c] is the index of the first particle in cell c
+  const uint64_t ncells = L*L;
+  std::vector<size_t> bin_start(ncells+1,0);
+  // per-thread histograms of the rows, and of the cells of one row
+  std::vector<size_t> row_start(L+1,0);
+#ifdef _OPENMP
+  std::vector<size_t> row_counts(omp_get_max_threads()*L);
+  std::vector<size_t> cell_counts(omp_get_max_threads()*L);
+#else
+  std::vector<size_t> row_counts(L);
+  std::vector<size_t> cell_counts(L);
+#endif
+
+  OMP_PARALLEL()
+  {
+    double t0(0); // only used by the master thread
+
+    size_t first = push_range(0, n, bin_start, false);
+    size_t last  = push_range(1, n, bin_start, false);
+
+    for (uint64_t iter=0; iter<=iterations; iter++) {
+
+      if (sort_period > 0 && iter % sort_period == 0) {
+        OMP_BARRIER
+        OMP_MASTER
+        t0 = prk::wtime();
+
+        bin_particles(L, particles, scratch, row_counts, row_start, cell_counts, bin_start);
+
+        OMP_MASTER
+        if (iter>=1) sort_time += prk::wtime() - t0;
+
+        first = push_range(0, n, bin_start, true);
+        last  = push_range(1, n, bin_start, true);
+      }
+
+      OMP_BARRIER
+      OMP_MASTER
+      t0 = prk::wtime();
+
+      // calculate forces on particles and update positions
+      push_particles(first, last, L, Qgrid.data(), particles);
+
+      // start the timers after one warm-up time step
+      OMP_BARRIER
+      OMP_MASTER
+      if (iter>=1) push_time += prk::wtime() - t0;
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////
+  // Analyze and output results.
+  //////////////////////////////////////////////////////////////////////
+
+  if (verify_particles(0, n, iterations, Qgrid, L, particles)) {
+    std::cout << "Solution validates" << std::endl;
+#ifdef VERBOSE
+    std::cout << "Simulation time is " << sort_time+push_time << " seconds" << std::endl;
+#endif
+    std::cout << "Avg sort time (s): " << sort_time/iterations
+              << " Avg push time (s): " << push_time/iterations << std::endl;
+    auto avgtime = (sort_time+push_time)/iterations;
+    std::cout << "Rate (Mparticles_moved/s): " << 1.0e-6*(n/avgtime)
+              << " Avg time (s): " << avgtime << std::endl;
+  } else {
+    std::cout << "ERROR: Solution does not validate" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,229 @@
+///
+/// Copyright (c) 2015, Intel Corporation
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions
+/// are met:
+///
+/// * Redistributions of source code must retain the above copyright
+///       notice, this list of conditions and the following disclaimer.
+/// * Redistributions in binary form must reproduce the above
+///       copyright notice, this list of conditions and the following
+///       disclaimer in the documentation and/or other materials provided
+///       with the distribution.
+/// * Neither the name of Intel Corporation nor the names of its
+///       contributors may be used to endorse or promote products
+///       derived from this software without specific prior written
+///       permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+/// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+/// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+/// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+/// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+/// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+/// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+/// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+/// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+/// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+
+//////////////////////////////////////////////////////////////////////
+///
+/// NAME:    PIC
+///
+/// PURPOSE: This program tests the efficiency with which a cloud of
+///          charged particles can be moved through a spatially fixed
+///          collection of charges located at the vertices of a square
+///          equi-spaced grid. It is a proxy for a component of a
+///          particle-in-cell method
+///
+/// USAGE:   <progname> <#simulation steps> <grid size> <#particles>
+///                     <k (particle charge semi-increment)>
+///                     <m (vertical particle velocity)>
+///                     <init mode> <init parameters>
+///
+///          The output consists of diagnostics to make sure the
+///          algorithm worked, and of timing statistics.
+///
+/// FUNCTIONS CALLED:
+///
+///          Other than standard C functions, the following functions are used in
+///          this program:
+///          wtime()
+///          bad_patch()
+///          prk::random_draw
+///
+/// HISTORY: - Written by Evangelos Georganas, August 2015.
+///          - RvdW: Refactored to make the code PRK conforming, December 2015
+///            C++11-ification with structure-of-arrays particles, 2018.
+///
+//////////////////////////////////////////////////////////////////////
+
+#include "prk_util.h"
+#include "pic-kernel.h"
+
+int main(int argc, char* argv[])
+{
+  std::cout << "Parallel Research Kernels version " << PRKVERSION << std::endl;
+  std::cout << "C++11 Particle-in-Cell execution on 2D grid" << std::endl;
+
+  //////////////////////////////////////////////////////////////////////
+  // Process and test input parameters
+  //////////////////////////////////////////////////////////////////////
+
+  uint64_t iterations;   // total number of simulation steps
+  uint64_t L;            // dimension of grid in cells
+  uint64_t n;            // total number of particles requested
+  int64_t k, m;          // determine initial horizontal and vertical velocity of
+                         // particles-- (2*k)+1 cells per time step
+  std::string init_mode; // particle initialization mode
+  pic_mode particle_mode = UNDEFINED;
+  double rho(0);         // attenuation factor for geometric particle distribution
+  double alpha(0), beta(0); // slope and offset values for linear particle distribution
+  bbox_t init_patch = {0,0,0,0}; // subset of grid used for localized initialization
+  try {
+      if (argc < 7) {
+        throw "Usage: <#simulation steps> <grid size> <#particles> <k (particle charge semi-increment)>\n"
+              "       <m (vertical particle velocity)> <init mode> <init parameters>\n"
+              "   init mode \"GEOMETRIC\"  parameters: <attenuation factor>\n"
+              "             \"SINUSOIDAL\" parameters: none\n"
+              "             \"LINEAR\"     parameters: <negative slope> <constant offset>\n"
+              "             \"PATCH\"      parameters: <xleft> <xright>  <ybottom> <ytop>";
+      }
+
+      iterations = std::atol(argv[1]);
+      if (std::atol(argv[1]) < 1) {
+        throw "ERROR: Number of time steps must be positive";
+      }
+
+      L = std::atol(argv[2]);
+      if (std::atol(argv[2]) < 1 || L%2) {
+        throw "ERROR: Number of grid cells must be positive and even";
+      }
+
+      n = std::atol(argv[3]);
+      if (std::atol(argv[3]) < 1) {
+        throw "ERROR: Number of particles must be positive";
+      }
+
+      k = std::atoi(argv[4]);
+      if (k < 0) {
+        throw "ERROR: Particle semi-charge must be non-negative";
+      }
+      m = std::atoi(argv[5]);
+
+      init_mode = std::string(argv[6]);
+      if (init_mode == "GEOMETRIC") {
+        if (argc < 8) {
+          throw "ERROR: Not enough arguments for GEOMETRIC";
+        }
+        particle_mode = GEOMETRIC;
+        rho = std::atof(argv[7]);
+      } else if (init_mode == "SINUSOIDAL") {
+        particle_mode = SINUSOIDAL;
+      } else if (init_mode == "LINEAR") {
+        if (argc < 9) {
+          throw "ERROR: Not enough arguments for LINEAR initialization";
+        }
+        particle_mode = LINEAR;
+        alpha = std::atof(argv[7]);
+        beta  = std::atof(argv[8]);
+        if (beta < 0 || beta < alpha) {
+          throw "ERROR: linear profile gives negative particle density";
+        }
+      } else if (init_mode == "PATCH") {
+        if (argc < 11) {
+          throw "ERROR: Not enough arguments for PATCH initialization";
+        }
+        particle_mode = PATCH;
+        init_patch.left   = std::atoi(argv[7]);
+        init_patch.right  = std::atoi(argv[8]);
+        init_patch.bottom = std::atoi(argv[9]);
+        init_patch.top    = std::atoi(argv[10]);
+        bbox_t grid_patch = {0, L+1, 0, L+1};
+        if (bad_patch(init_patch, grid_patch)) {
+          throw "ERROR: inconsistent initial patch";
+        }
+      } else {
+        throw "ERROR: Unsupported particle initializating mode";
+      }
+  }
+  catch (const char * e) {
+    std::cout << e << std::endl;
+    return 1;
+  }
+
+  std::cout << "Grid size                      = " << L << std::endl;
+  std::cout << "Number of particles requested  = " << n << std::endl;
+  std::cout << "Number of time steps           = " << iterations << std::endl;
+  std::cout << "Initialization mode            = " << init_mode << std::endl;
+  switch (particle_mode) {
+    case GEOMETRIC:  std::cout << "  Attenuation factor           = " << rho << std::endl; break;
+    case SINUSOIDAL: break;
+    case LINEAR:     std::cout << "  Negative slope               = " << alpha << std::endl;
+                     std::cout << "  Offset                       = " << beta << std::endl; break;
+    case PATCH:      std::cout << "  Bounding box                 = "
+                               << init_patch.left << ", " << init_patch.right << ", "
+                               << init_patch.bottom << ", " << init_patch.top << std::endl; break;
+    default: break;
+  }
+  std::cout << "Particle charge semi-increment = " << k << std::endl;
+  std::cout << "Vertical velocity              = " << m << std::endl;
+
+  //////////////////////////////////////////////////////////////////////
+  // Initialize grid of charges and particles
+  //////////////////////////////////////////////////////////////////////
+
+  auto Qgrid = initialize_grid(L);
+
+  particles_t particles;
+  switch (particle_mode) {
+    case GEOMETRIC:  initialize_geometric(n, L, rho, k, m, particles);         break;
+    case SINUSOIDAL: initialize_sinusoidal(n, L, k, m, particles);             break;
+    case LINEAR:     initialize_linear(n, L, alpha, beta, k, m, particles);    break;
+    case PATCH:      initialize_patch(n, L, init_patch, k, m, particles);      break;
+    default: break;
+  }
+  n = particles.size();
+
+  std::cout << "Number of particles placed     = " << n << std::endl;
+
+  //////////////////////////////////////////////////////////////////////
+  // Perform the computation
+  //////////////////////////////////////////////////////////////////////
+
+  auto pic_time = 0.0;
+
+  {
+    for (uint64_t iter=0; iter<=iterations; iter++) {
+
+      // start the timer after one warm-up time step
+      if (iter==1) pic_time = prk::wtime();
+
+      // calculate forces on particles and update positions
+      push_particles(0, n, L, Qgrid.data(), particles);
+    }
+    pic_time = prk::wtime() - pic_time;
+  }
+
+  //////////////////////////////////////////////////////////////////////
+  // Analyze and output results.
+  //////////////////////////////////////////////////////////////////////
+
+  if (verify_particles(0, n, iterations, Qgrid, L, particles)) {
+    std::cout << "Solution validates" << std::endl;
+#ifdef VERBOSE
+    std::cout << "Simulation time is " << pic_time << " seconds" << std::endl;
+#endif
+    auto avgtime = pic_time/iterations;
+    std::cout << "Rate (Mparticles_moved/s): " << 1.0e-6*(n/avgtime)
+              << " Avg time (s): " << avgtime << std::endl;
+  } else {
+    std::cout << "ERROR: Solution does not validate" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,789 @@
+///
+/// Copyright (c) 2018, Intel Corporation
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions
+/// are met:
+///
+/// * Redistributions of source code must retain the above copyright
+///       notice, this list of conditions and the following disclaimer.
+/// * Redistributions in binary form must reproduce the above
+///       copyright notice, this list of conditions and the following
+///       disclaimer in the documentation and/or other materials provided
+///       with the distribution.
+/// * Neither the name of Intel Corporation nor the names of its
+///       contributors may be used to endorse or promote products
+///       derived from this software without specific prior written
+///       permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+/// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+/// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+/// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+/// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+/// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+/// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+/// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+/// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+/// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+
+
+//////////////////////////////////////////////////////////////////////
+///
+/// NAME:    prk-suite
+///
+/// PURPOSE: Runs a suite of kernels in one process, so that a nightly
+///          benchmark run pays for process startup, page faults and
+///          thread creation once rather than once per kernel.
+///
+/// USAGE:   <progname> <suite file> [<report file>]
+///
+///          Each line of the suite file names a kernel, the number of
+///          repetitions and the arguments of the kernel, which are those
+///          of the stand-alone driver of the same name:
+///
+///          nstream   <reps> <# iterations> <vector length>
+///          transpose <reps> <# iterations> <matrix order> [<tile size>]
+///          stencil   <reps> <# iterations> <grid size> [<tile size> [<star/grid> [<radius>]]]
+///          dgemm     <reps> <# iterations> <matrix order> [<tile size>]
+///          p2p       <reps> <# iterations> <m> <n> [<mc> <nc>]
+///
+///          A line "threads <n>" sets the number of OpenMP threads for
+///          the entries that follow.  Text after '#' is a comment.
+///
+///          The kernels are shared with the stand-alone drivers: nstream
+///          and transpose with the -openmp ones, stencil with stencil-openmp,
+///          and dgemm and p2p with dgemm-vector and p2p-vector, which are
+///          serial, so these two always run on one thread.
+///
+///          Every iteration after the first of every repetition is timed
+///          separately.  The report, a JSON document with the rate and
+///          these samples for each entry, is written to the report file,
+///          or to standard output when none is given.
+///
+///          --cold or --cold=flush anywhere on the command line flushes
+///          the caches before every iteration (see prk::cold in
+///          prk_util.h); the report records which caches were used.
+///
+///          With PRK_ROOFLINE set, each entry also prints its percent of
+///          the roofline for its thread count (see prk::roofline).
+///
+///          <progname> --compare <baseline report> [<report file>]
+///
+///          reruns the entries of a stored report and compares the samples
+///          of each with those of the baseline by a two-sided Mann-Whitney
+///          U test.  An entry is slower or faster when the test is
+///          significant at level PRK_SUITE_ALPHA (default 0.01) and its
+///          median time changed by more than PRK_SUITE_THRESHOLD (default
+///          0.05, i.e. 5%).  The exit code is 2 if any entry is slower and
+///          1 if any entry fails to validate.
+///
+/// NOTES:   Arrays are kept in a workspace that only ever grows, so an
+///          entry that fits into the arrays of an earlier one touches no
+///          new pages.  The OpenMP runtime keeps its threads between the
+///          parallel regions of all entries.
+///
+/// HISTORY: Single-process suite of the C++11 kernels, 2018.
+///
+//////////////////////////////////////////////////////////////////////
+
+#include "prk_util.h"
+#include "stencil_openmp.hpp"
+#include "nstream-kernel.h"
+#include "transpose-kernel.h"
+#include "dgemm-kernel.h"
+#include "p2p-kernel.h"
+
+#ifdef __linux__
+# include <unistd.h>
+#endif
+
+namespace {
+
+// arrays reused across entries; slot i only ever grows
+class workspace {
+
+  private:
+
+    std::vector<std::vector<double>> slots;
+
+  public:
+
+    std::vector<double> & vector(size_t slot, size_t length) {
+        if (slots.size() <= slot) slots.resize(slot+1);
+        if (slots[slot].size() < length) slots[slot].resize(length);
+        return slots[slot];
+    }
+
+    double * get(size_t slot, size_t length) {
+        return vector(slot, length).data();
+    }
+
+    std::vector<prk::cold::operand> operands() const {
+        return std::vector<prk::cold::operand>(slots.begin(), slots.end());
+    }
+};
+
+struct entry {
+    std::string kernel;
+    int repetitions;
+    std::vector<std::string> args;
+    int threads;
+};
+
+struct result {
+    bool valid;
+    std::string units;
+    double work;                  // units per iteration, e.g. bytes or flops
+    std::vector<double> samples;  // time of each timed iteration, in seconds
+    prk::work_model model;        // flops and bytes of one iteration, for the roofline
+
+    double avgtime() const {
+        return samples.empty() ? 0.0 : prk::reduce(samples.begin(), samples.end(), 0.0)/samples.size();
+    }
+
+    double rate() const {
+        return (avgtime() > 0.0) ? 1.e-6*work/avgtime() : 0.0;
+    }
+};
+
+int max_threads()
+{
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+// dgemm and p2p run the serial kernels of dgemm-vector and p2p-vector,
+// so their entries use and report one thread
+bool serial(const std::string & kernel)
+{
+    return kernel == "dgemm" || kernel == "p2p";
+}
+
+long get_arg(const entry & e, size_t i, long fallback = -1)
+{
+    if (i < e.args.size()) return std::atol(e.args[i].c_str());
+    if (fallback < 0) throw "ERROR: too few arguments for kernel";
+    return fallback;
+}
+
+// times iterations 1..iterations of body(iter); iteration 0 is a warmup.
+// In cold-cache mode the caches are flushed before, and outside of, the
+// timing of every iteration.
+template <typename F>
+void run_iterations(const workspace & ws, int iterations, std::vector<double> & samples, F body)
+{
+    for (int iter=0; iter<=iterations; iter++) {
+        prk::cold::flush(ws.operands());
+        const double t0 = prk::wtime();
+        body(iter);
+        if (iter > 0) samples.push_back(prk::wtime() - t0);
+    }
+}
+
+result nstream(const entry & e, workspace & ws)
+{
+    const int iterations = get_arg(e,0);
+    const size_t length  = get_arg(e,1);
+    if (iterations < 1 || length < 1) throw "ERROR: nstream needs iterations and length >= 1";
+
+    result r{true, "MB/s", 4.0*length*sizeof(double), {}, {2.0*length, 4.0*length*sizeof(double)}};
+    double * RESTRICT A = ws.get(0,length);
+    double * RESTRICT B = ws.get(1,length);
+    double * RESTRICT C = ws.get(2,length);
+    const double scalar(3);
+
+    for (int rep=0; rep<e.repetitions; rep++) {
+        OMP_PARALLEL()
+        {
+            nstream_init(length, A, B, C);
+        }
+        run_iterations(ws, iterations, r.samples, [&] (int) {
+            OMP_PARALLEL()
+            {
+                nstream_triad(length, scalar, A, B, C);
+            }
+        });
+        const double ar = nstream_reference(iterations, length, scalar);
+        const double asum = nstream_checksum(length, A);
+        r.valid = r.valid && (std::fabs(ar-asum)/asum <= 1.e-8);
+    }
+    return r;
+}
+
+result transpose(const entry & e, workspace & ws)
+{
+    const int iterations = get_arg(e,0);
+    const int64_t order      = get_arg(e,1);
+    const int64_t tile_size  = std::max(1L, std::min(get_arg(e,2,32), static_cast<long>(order)));
+    if (iterations < 1 || order < 1) throw "ERROR: transpose needs iterations and order >= 1";
+
+    // the rate counts reading A and writing B, but both are read and written
+    result r{true, "MB/s", 2.0*order*order*sizeof(double), {},
+             {2.0*order*order, 4.0*order*order*sizeof(double)}};
+    double * RESTRICT A = ws.get(0,static_cast<size_t>(order)*order);
+    double * RESTRICT B = ws.get(1,static_cast<size_t>(order)*order);
+
+    for (int rep=0; rep<e.repetitions; rep++) {
+        OMP_PARALLEL()
+        {
+            transpose_init(order, A, B);
+        }
+        run_iterations(ws, iterations, r.samples, [&] (int) {
+            OMP_PARALLEL()
+            {
+                transpose_tiled(order, tile_size, A, B);
+            }
+        });
+        r.valid = r.valid && (transpose_error(iterations, order, B) < 1.e-8);
+    }
+    return r;
+}
+
+result stencil(const entry & e, workspace & ws)
+{
+    const int iterations = get_arg(e,0);
+    const int64_t n          = get_arg(e,1);
+    const int64_t tile_size  = std::max(1L, std::min(get_arg(e,2,32), static_cast<long>(n)));
+    const bool star      = (e.args.size() <= 3) || (e.args[3] != "grid");
+    const int radius     = get_arg(e,4,2);
+    if (iterations < 1 || n < 1) throw "ERROR: stencil needs iterations and grid size >= 1";
+    if (radius < 1 || 2*radius+1 > n) throw "ERROR: stencil radius negative or too large";
+
+    void (*kernel)(const int64_t, const int64_t, const double * RESTRICT, double * RESTRICT) = nullptr;
+    switch (radius) {
+        case 1: kernel = star ? star1 : grid1; break;
+        case 2: kernel = star ? star2 : grid2; break;
+        case 3: kernel = star ? star3 : grid3; break;
+        case 4: kernel = star ? star4 : grid4; break;
+        case 5: kernel = star ? star5 : grid5; break;
+    }
+    if (kernel == nullptr) throw "ERROR: stencil radius must be between 1 and 5";
+
+    const size_t active_points = static_cast<size_t>(n-2*radius)*static_cast<size_t>(n-2*radius);
+    const int stencil_size = star ? 4*radius+1 : (2*radius+1)*(2*radius+1);
+    // in and out are streamed by the stencil, in again by the update
+    result r{true, "MFlops/s", (2.0*stencil_size+1.0)*active_points, {},
+             {(2.0*stencil_size+1.0)*active_points, 4.0*n*n*sizeof(double)}};
+    double * RESTRICT in  = ws.get(0,static_cast<size_t>(n)*n);
+    double * RESTRICT out = ws.get(1,static_cast<size_t>(n)*n);
+
+    for (int rep=0; rep<e.repetitions; rep++) {
+        OMP(parallel for)
+        for (int64_t i=0; i<n; i++) {
+            for (int64_t j=0; j<n; j++) {
+                in[i*n+j]  = static_cast<double>(i+j);
+                out[i*n+j] = 0.0;
+            }
+        }
+        run_iterations(ws, iterations, r.samples, [&] (int) {
+            OMP_PARALLEL()
+            {
+                kernel(n, tile_size, in, out);
+                OMP_FOR()
+                for (int64_t i=0; i<n; i++) {
+                    for (int64_t j=0; j<n; j++) {
+                        in[i*n+j] += 1.0;
+                    }
+                }
+            }
+        });
+        double norm(0);
+        OMP_PARALLEL_FOR_REDUCE( +:norm )
+        for (int64_t i=radius; i<n-radius; i++) {
+            for (int64_t j=radius; j<n-radius; j++) {
+                norm += std::fabs(out[i*n+j]);
+            }
+        }
+        norm /= active_points;
+        r.valid = r.valid && (std::fabs(norm - 2.*(iterations+1.)) <= 1.e-8);
+    }
+    return r;
+}
+
+result dgemm(const entry & e, workspace & ws)
+{
+    const int iterations = get_arg(e,0);
+    const int64_t order      = get_arg(e,1);
+    const int64_t tile_size  = std::max(1L, std::min(get_arg(e,2,32), static_cast<long>(order)));
+    if (iterations < 1 || order < 1) throw "ERROR: dgemm needs iterations and order >= 1";
+
+    const double forder = static_cast<double>(order);
+    result r{true, "MFlops/s", 2.0*forder*forder*forder, {}, {2.0*forder*forder*forder, 4.0*forder*forder*sizeof(double)}};
+    auto & A = ws.vector(0,static_cast<size_t>(order)*order);
+    auto & B = ws.vector(1,static_cast<size_t>(order)*order);
+    auto & C = ws.vector(2,static_cast<size_t>(order)*order);
+
+    for (int rep=0; rep<e.repetitions; rep++) {
+        OMP(parallel for)
+        for (int64_t i=0; i<order; i++) {
+            for (int64_t j=0; j<order; j++) {
+                A[i*order+j] = i;
+                B[i*order+j] = i;
+                C[i*order+j] = 0.0;
+            }
+        }
+        // the serial kernel of dgemm-vector
+        run_iterations(ws, iterations, r.samples, [&] (int) {
+            if (tile_size < order) {
+                prk_dgemm(order, tile_size, A, B, C);
+            } else {
+                prk_dgemm(order, A, B, C);
+            }
+        });
+        const double reference = dgemm_reference(order, iterations);
+        double checksum(0);
+        OMP_PARALLEL_FOR_REDUCE( +:checksum )
+        for (size_t ij=0; ij<static_cast<size_t>(order)*order; ij++) {
+            checksum += C[ij];
+        }
+        r.valid = r.valid && (std::fabs(checksum-reference)/reference < 1.e-8);
+    }
+    return r;
+}
+
+result p2p(const entry & e, workspace & ws)
+{
+    const int iterations = get_arg(e,0);
+    const int64_t m          = get_arg(e,1);
+    const int64_t n          = get_arg(e,2);
+    const int64_t mc         = std::max(1L, std::min(get_arg(e,3,m), static_cast<long>(m)));
+    const int64_t nc         = std::max(1L, std::min(get_arg(e,4,n), static_cast<long>(n)));
+    if (iterations < 1 || m < 1 || n < 1) throw "ERROR: p2p needs iterations and grid dimensions >= 1";
+
+    result r{true, "MFlops/s", 2.0*(m-1.)*(n-1.), {}, {2.0*(m-1.)*(n-1.), 2.0*m*n*sizeof(double)}};
+    double * RESTRICT grid = ws.get(0,static_cast<size_t>(m)*n);
+
+    for (int rep=0; rep<e.repetitions; rep++) {
+        std::fill(grid, grid+static_cast<size_t>(m)*n, 0.0);
+        for (int64_t j=0; j<n; j++) grid[0*n+j] = static_cast<double>(j);
+        for (int64_t i=0; i<m; i++) grid[i*n+0] = static_cast<double>(i);
+        // the serial kernel of p2p-vector
+        run_iterations(ws, iterations, r.samples, [&] (int) {
+            sweep_tiles(m, n, mc, nc, grid);
+            grid[0*n+0] = -grid[(m-1)*n+(n-1)];
+        });
+        const double corner_val = (iterations+1.)*(n+m-2.);
+        r.valid = r.valid && (std::fabs(grid[(m-1)*n+(n-1)] - corner_val)/corner_val <= 1.e-8);
+    }
+    return r;
+}
+
+std::vector<entry> read_suite(const std::string & filename)
+{
+    std::ifstream in(filename);
+    if (!in) throw "ERROR: cannot open suite file";
+    std::vector<entry> suite;
+    int threads = max_threads();
+    std::string line;
+    while (std::getline(in, line)) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream is(line);
+        entry e{"", 1, {}, threads};
+        if (!(is >> e.kernel)) continue;
+        if (e.kernel == "threads") {
+            if (!(is >> threads) || threads < 1) throw "ERROR: threads needs a positive count";
+            continue;
+        }
+        if (serial(e.kernel)) e.threads = 1;
+        if (!(is >> e.repetitions) || e.repetitions < 1) throw "ERROR: repetitions must be >= 1";
+        std::string arg;
+        while (is >> arg) e.args.push_back(arg);
+        suite.push_back(e);
+    }
+    return suite;
+}
+
+std::string join(const std::vector<std::string> & args)
+{
+    std::string s;
+    for (const auto & a : args) s += (s.empty() ? "" : " ") + a;
+    return s;
+}
+
+result run(const entry & e, workspace & ws)
+{
+#ifdef _OPENMP
+    omp_set_num_threads(e.threads);
+#endif
+    if (e.kernel == "nstream")   return nstream(e, ws);
+    if (e.kernel == "transpose") return transpose(e, ws);
+    if (e.kernel == "stencil")   return stencil(e, ws);
+    if (e.kernel == "dgemm")     return dgemm(e, ws);
+    if (e.kernel == "p2p")       return p2p(e, ws);
+    throw "ERROR: kernel must be one of nstream, transpose, stencil, dgemm or p2p";
+}
+
+// just enough JSON to read back a report of ours
+struct json {
+    enum { null, boolean, number, string, array, object } kind = null;
+    bool b = false;
+    double x = 0.0;
+    std::string s;
+    std::vector<json> items;
+    std::vector<std::pair<std::string,json>> members;
+
+    const json & operator[](const std::string & key) const {
+        for (const auto & m : members) {
+            if (m.first == key) return m.second;
+        }
+        throw "ERROR: baseline report lacks a field";
+    }
+};
+
+class json_parser {
+
+  private:
+
+    const std::string & text;
+    size_t pos;
+
+    void skip() {
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) pos++;
+    }
+
+    char peek() {
+        skip();
+        if (pos >= text.size()) throw "ERROR: baseline report is truncated";
+        return text[pos];
+    }
+
+    void expect(char c) {
+        if (peek() != c) throw "ERROR: baseline report is not valid JSON";
+        pos++;
+    }
+
+    std::string str() {
+        expect('"');
+        std::string v;
+        while (pos < text.size() && text[pos] != '"') {
+            if (text[pos] == '\\' && pos+1 < text.size()) pos++;
+            v += text[pos++];
+        }
+        expect('"');
+        return v;
+    }
+
+  public:
+
+    json_parser(const std::string & t) : text(t), pos(0) {}
+
+    json value() {
+        json v;
+        const char c = peek();
+        if (c == '{') {
+            v.kind = json::object;
+            pos++;
+            while (peek() != '}') {
+                std::string key = str();
+                expect(':');
+                v.members.emplace_back(key, value());
+                if (peek() == ',') pos++;
+            }
+            pos++;
+        } else if (c == '[') {
+            v.kind = json::array;
+            pos++;
+            while (peek() != ']') {
+                v.items.push_back(value());
+                if (peek() == ',') pos++;
+            }
+            pos++;
+        } else if (c == '"') {
+            v.kind = json::string;
+            v.s = str();
+        } else if (text.compare(pos, 4, "true") == 0 || text.compare(pos, 5, "false") == 0) {
+            v.kind = json::boolean;
+            v.b = (text[pos] == 't');
+            pos += v.b ? 4 : 5;
+        } else if (text.compare(pos, 4, "null") == 0) {
+            pos += 4;
+        } else {
+            v.kind = json::number;
+            char * end;
+            v.x = std::strtod(text.c_str()+pos, &end);
+            if (end == text.c_str()+pos) throw "ERROR: baseline report is not valid JSON";
+            pos = end - text.c_str();
+        }
+        return v;
+    }
+};
+
+// the entries of a stored report, their samples and the cache mode
+std::vector<entry> read_baseline(const std::string & filename, std::vector<std::vector<double>> & samples,
+                                 std::string & cache)
+{
+    std::ifstream in(filename);
+    if (!in) throw "ERROR: cannot open baseline report";
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    const std::string text = buffer.str();
+    const json report = json_parser(text).value();
+
+    // reports older than cold-cache mode were all warm
+    cache = "warm";
+    for (const auto & m : report.members) {
+        if (m.first == "cache") cache = m.second.s;
+    }
+
+    std::vector<entry> suite;
+    for (const auto & j : report["entries"].items) {
+        entry e{j["kernel"].s, static_cast<int>(j["repetitions"].x), {}, static_cast<int>(j["threads"].x)};
+        if (serial(e.kernel)) e.threads = 1;
+        std::istringstream is(j["args"].s);
+        std::string arg;
+        while (is >> arg) e.args.push_back(arg);
+        suite.push_back(e);
+        samples.emplace_back();
+        for (const auto & x : j["samples"].items) samples.back().push_back(x.x);
+    }
+    return suite;
+}
+
+double median(std::vector<double> v)
+{
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    const size_t h = v.size()/2;
+    return (v.size() % 2) ? v[h] : 0.5*(v[h-1]+v[h]);
+}
+
+// Two-sided Mann-Whitney U test of the hypothesis that a and b come from
+// the same distribution, with the normal approximation corrected for ties
+// and continuity.  Returns the p-value.
+double mann_whitney(const std::vector<double> & a, const std::vector<double> & b)
+{
+    const size_t n1 = a.size(), n2 = b.size(), n = n1+n2;
+    if (n1 == 0 || n2 == 0) return 1.0;
+    std::vector<std::pair<double,int>> all;
+    for (auto x : a) all.emplace_back(x,0);
+    for (auto x : b) all.emplace_back(x,1);
+    std::sort(all.begin(), all.end());
+
+    double r1 = 0.0, ties = 0.0;
+    for (size_t i=0; i<n; ) {
+        size_t k = i;
+        while (k < n && all[k].first == all[i].first) k++;
+        const double rank = 0.5*(i+1+k);   // average of ranks i+1..k
+        const double t = k-i;
+        ties += t*t*t - t;
+        for (size_t m=i; m<k; m++) {
+            if (all[m].second == 0) r1 += rank;
+        }
+        i = k;
+    }
+    const double u1 = r1 - 0.5*n1*(n1+1.0);
+    const double mu = 0.5*n1*n2;
+    const double var = n1*n2/12.0 * ((n+1.0) - ties/(n*(n-1.0)));
+    if (var <= 0.0) return 1.0;
+    const double z = std::max(0.0, std::fabs(u1-mu) - 0.5) / std::sqrt(var);
+    return std::erfc(z/std::sqrt(2.0));
+}
+
+struct comparison {
+    double ratio;     // median time now / median time in the baseline
+    double p;
+    int verdict;      // -1 slower, 0 no significant change, +1 faster
+};
+
+// a change counts when it is both significant and larger than threshold
+comparison compare(const std::vector<double> & baseline, const std::vector<double> & now,
+                   double alpha, double threshold)
+{
+    comparison c{0.0, mann_whitney(baseline, now), 0};
+    const double m0 = median(baseline);
+    c.ratio = (m0 > 0.0) ? median(now)/m0 : 1.0;
+    if (c.p < alpha && c.ratio > 1.0+threshold) c.verdict = -1;
+    if (c.p < alpha && c.ratio < 1.0/(1.0+threshold)) c.verdict = +1;
+    return c;
+}
+
+const char * verdict_name(int verdict)
+{
+    return (verdict < 0) ? "slower" : (verdict > 0) ? "faster" : "unchanged";
+}
+
+// comparisons is empty unless the suite was compared with a baseline
+void write_report(std::ostream & os, const std::vector<entry> & suite,
+                  const std::vector<result> & results, const std::vector<comparison> & comparisons,
+                  double total_time)
+{
+    char host[256] = "localhost";
+#ifdef __linux__
+    gethostname(host, sizeof(host)-1);
+#endif
+    os << std::setprecision(9);
+    os << "{\n"
+       << "  \"version\": \"" << PRKVERSION << "\",\n"
+       << "  \"host\": \"" << host << "\",\n"
+       << "  \"cache\": \"" << prk::cold::mode() << "\",\n"
+       << "  \"total_time\": " << total_time << ",\n"
+       << "  \"entries\": [\n";
+    for (size_t i=0; i<suite.size(); i++) {
+        const auto & e = suite[i];
+        const auto & r = results[i];
+        os << "    {\n"
+           << "      \"kernel\": \"" << e.kernel << "\",\n"
+           << "      \"args\": \"" << join(e.args) << "\",\n"
+           << "      \"repetitions\": " << e.repetitions << ",\n"
+           << "      \"threads\": " << e.threads << ",\n"
+           << "      \"valid\": " << (r.valid ? "true" : "false") << ",\n"
+           << "      \"units\": \"" << r.units << "\",\n"
+           << "      \"rate\": " << r.rate() << ",\n"
+           << "      \"avg_time\": " << r.avgtime() << ",\n"
+           << "      \"samples\": [";
+        for (size_t s=0; s<r.samples.size(); s++) {
+            os << (s ? ", " : "") << r.samples[s];
+        }
+        os << "]";
+        if (i < comparisons.size()) {
+            const auto & c = comparisons[i];
+            os << ",\n"
+               << "      \"baseline\": { \"time_ratio\": " << c.ratio << ", \"p_value\": " << c.p
+               << ", \"verdict\": \"" << verdict_name(c.verdict) << "\" }";
+        }
+        os << "\n"
+           << "    }" << (i+1 < suite.size() ? "," : "") << "\n";
+    }
+    os << "  ]\n"
+       << "}" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+  std::cout << "Parallel Research Kernels version " << PRKVERSION << std::endl;
+  std::cout << "C++11 kernel suite" << std::endl;
+
+  //////////////////////////////////////////////////////////////////////
+  /// Read and test input parameters
+  //////////////////////////////////////////////////////////////////////
+
+  std::vector<entry> suite;
+  std::string report;
+  std::string baseline;
+  std::vector<std::vector<double>> baseline_samples;
+  std::string baseline_cache;
+  double alpha = 0.01;
+  double threshold = 0.05;
+  try {
+      prk::cold::parse(argc, argv);
+
+      if (argc < 2) {
+        throw "Usage: <suite file> [<report file>]\n"
+              "       --compare <baseline report> [<report file>]";
+      }
+      int arg = 1;
+      if (std::string(argv[1]) == "--compare") {
+        if (argc < 3) {
+          throw "Usage: --compare <baseline report> [<report file>]";
+        }
+        baseline = argv[2];
+        suite = read_baseline(baseline, baseline_samples, baseline_cache);
+        arg = 2;
+      } else {
+        suite = read_suite(argv[1]);
+      }
+      if (suite.empty()) {
+        throw "ERROR: suite file has no entries";
+      }
+      report = (argc > arg+1) ? std::string(argv[arg+1]) : std::string();
+
+      const char * a = std::getenv("PRK_SUITE_ALPHA");
+      if (a != nullptr) alpha = std::atof(a);
+      const char * t = std::getenv("PRK_SUITE_THRESHOLD");
+      if (t != nullptr) threshold = std::atof(t);
+      if (alpha <= 0.0 || alpha >= 1.0 || threshold < 0.0) {
+        throw "ERROR: PRK_SUITE_ALPHA must be in (0,1) and PRK_SUITE_THRESHOLD nonnegative";
+      }
+  }
+  catch (const char * e) {
+    std::cout << e << std::endl;
+    return 1;
+  }
+
+  if (baseline.empty()) {
+    std::cout << "Suite file           = " << argv[1] << std::endl;
+  } else {
+    std::cout << "Baseline report      = " << baseline << std::endl;
+    std::cout << "Significance level   = " << alpha << std::endl;
+    std::cout << "Change threshold     = " << 100.0*threshold << "%" << std::endl;
+    if (baseline_cache != prk::cold::mode()) {
+      std::cout << "WARNING: the baseline was measured with " << baseline_cache
+                << " caches and this run with " << prk::cold::mode() << " caches" << std::endl;
+    }
+  }
+  std::cout << "Number of entries    = " << suite.size() << std::endl;
+  prk::cold::print();
+
+  //////////////////////////////////////////////////////////////////////
+  /// Run the suite
+  //////////////////////////////////////////////////////////////////////
+
+  workspace ws;
+  std::vector<result> results;
+  std::vector<comparison> comparisons;
+  bool validate = true;
+  int regressions = 0;
+  double total_time = prk::wtime();
+
+  for (const auto & e : suite) {
+    std::cout << e.kernel << " " << join(e.args) << " (" << e.repetitions << " x "
+              << e.threads << " threads): " << std::flush;
+    try {
+        results.push_back(run(e, ws));
+    }
+    catch (const char * err) {
+        std::cout << err << std::endl;
+        return 1;
+    }
+    const auto & r = results.back();
+    if (r.valid) {
+      std::cout << "Solution validates Rate (" << r.units << "): " << r.rate()
+                << " Avg time (s): " << r.avgtime() << std::endl;
+      prk::roofline::print(r.model, r.avgtime());
+    } else {
+      std::cout << "ERROR: solution did not validate" << std::endl;
+      validate = false;
+    }
+    if (!baseline.empty()) {
+      const auto & c = compare(baseline_samples[results.size()-1], r.samples, alpha, threshold);
+      comparisons.push_back(c);
+      std::cout << "  vs baseline: median time x" << c.ratio << " p-value " << c.p << " "
+                << (c.verdict < 0 ? "REGRESSION" : c.verdict > 0 ? "improvement" : "no significant change")
+                << std::endl;
+      if (c.verdict < 0) regressions++;
+    }
+  }
+  total_time = prk::wtime() - total_time;
+
+  //////////////////////////////////////////////////////////////////////
+  /// Write the report
+  //////////////////////////////////////////////////////////////////////
+
+  if (report.empty()) {
+    write_report(std::cout, suite, results, comparisons, total_time);
+  } else {
+    std::ofstream os(report);
+    if (!os) {
+      std::cout << "ERROR: cannot write report file " << report << std::endl;
+      return 1;
+    }
+    write_report(os, suite, results, comparisons, total_time);
+    std::cout << "Report written to " << report << std::endl;
+  }
+  std::cout << "Total time (s): " << total_time << std::endl;
+
+  if (!validate) return 1;
+  if (regressions > 0) {
+    std::cout << "ERROR: " << regressions << " entries are slower than the baseline" << std::endl;
+    return 2;
+  }
+  return 0;
+}
@@ -0,0 +1,290 @@
+///
+/// Copyright (c) 2018, Intel Corporation
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions
+/// are met:
+///
+/// * Redistributions of source code must retain the above copyright
+///       notice, this list of conditions and the following disclaimer.
+/// * Redistributions in binary form must reproduce the above
+///       copyright notice, this list of conditions and the following
+///       disclaimer in the documentation and/or other materials provided
+///       with the distribution.
+/// * Neither the name of Intel Corporation nor the names of its
+///       contributors may be used to endorse or promote products
+///       derived from this software without specific prior written
+///       permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+/// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+/// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+/// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+/// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+/// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+/// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+/// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+/// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+/// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef PRK_AFFINITY_H
+#define PRK_AFFINITY_H
+
+// Thread placement for the std::thread, std::async and TBB kernels, which
+// otherwise leave it to the OS.  The environment variable PRK_AFFINITY
+// selects a placement:
+//
+//     compact   fill each core, then the next core, then the next package
+//     scatter   round-robin over packages, then cores, then hardware threads
+//     cores     one thread per core (the first hardware thread of each)
+//     smt       one thread per hardware thread, all cores before any sibling
+//     0,2,4-7   an explicit list of logical CPUs
+//
+// Thread t of a team is pinned to the t-th CPU of the placement, wrapping
+// around when there are more threads than CPUs.  Only the CPUs the process
+// may run on (taskset, cgroups) are used, and an explicit list naming any
+// other CPU is an error.  The topology comes from /sys/devices/system/cpu;
+// where it is missing, every CPU is its own core.
+// Without PRK_AFFINITY nothing is pinned.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+# include <sched.h>
+#endif
+
+#ifdef USE_TBB
+# include <tbb/task_scheduler_observer.h>
+# include <tbb/task_arena.h>
+#endif
+
+namespace prk {
+
+    class affinity {
+
+      private:
+
+        struct hwthread {
+            int cpu, package, core, smt;
+        };
+
+        std::string spec;
+        std::vector<int> cpus;
+
+        static int read_id(int cpu, const char * what, int fallback) {
+            char path[128];
+            std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/%s", cpu, what);
+            FILE * f = std::fopen(path, "r");
+            if (f == nullptr) return fallback;
+            int id = fallback;
+            if (std::fscanf(f, "%d", &id) != 1) id = fallback;
+            std::fclose(f);
+            return id;
+        }
+
+        // the CPUs the process may run on, in ascending order
+        static std::vector<int> allowed() {
+            std::vector<int> list;
+#ifdef __linux__
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+                for (int c=0; c<CPU_SETSIZE; c++) {
+                    if (CPU_ISSET(c, &set)) list.push_back(c);
+                }
+            }
+#endif
+            return list;
+        }
+
+        static std::vector<hwthread> topology() {
+            std::vector<hwthread> hw;
+            for (int c : allowed()) {
+                hw.push_back({c, read_id(c, "physical_package_id", 0), read_id(c, "core_id", c), 0});
+            }
+            // number the hardware threads of each core, and the cores of each
+            // package densely, since core_id may have gaps
+            std::sort(hw.begin(), hw.end(), [](const hwthread & a, const hwthread & b) {
+                return a.package != b.package ? a.package < b.package
+                     : a.core != b.core ? a.core < b.core : a.cpu < b.cpu;
+            });
+            int package = -1, core_id = -1, core = -1, smt = 0;
+            for (auto & h : hw) {
+                if (h.package != package) {
+                    core = 0;
+                    smt = 0;
+                } else if (h.core != core_id) {
+                    core++;
+                    smt = 0;
+                } else {
+                    smt++;
+                }
+                package = h.package;
+                core_id = h.core;
+                h.core = core;
+                h.smt = smt;
+            }
+            return hw;
+        }
+
+        static std::vector<int> parse_list(const std::string & s) {
+            std::vector<int> list;
+            std::istringstream is(s);
+            std::string item;
+            while (std::getline(is, item, ',')) {
+                int lo, hi;
+                char dash;
+                std::istringstream r(item);
+                if (!(r >> lo) || lo < 0) {
+                    throw "ERROR: PRK_AFFINITY CPU list must be like 0,2,4-7";
+                }
+                hi = lo;
+                if (r >> dash && (dash != '-' || !(r >> hi) || hi < lo)) {
+                    throw "ERROR: PRK_AFFINITY CPU list must be like 0,2,4-7";
+                }
+                for (int c=lo; c<=hi; c++) list.push_back(c);
+            }
+#ifdef __linux__
+            // a CPU that is offline or outside the taskset/cgroup cannot be
+            // pinned to, so reject it here rather than report a placement
+            // that never takes effect
+            const auto ok = allowed();
+            for (int c : list) {
+                if (!std::binary_search(ok.begin(), ok.end(), c)) {
+                    throw "ERROR: PRK_AFFINITY CPU list names a CPU this process may not run on";
+                }
+            }
+#endif
+            return list;
+        }
+
+      public:
+
+        // no pinning
+        affinity() = default;
+
+        // throws like the argument parsers of the drivers
+        explicit affinity(const std::string & s) : spec(s) {
+            if (spec.empty() || spec == "none") {
+                spec.clear();
+                return;
+            }
+            if (spec.find_first_not_of("0123456789,-") == std::string::npos) {
+                cpus = parse_list(spec);
+                return;
+            }
+            auto hw = topology();
+            auto order = [&hw] (auto less) {
+                std::stable_sort(hw.begin(), hw.end(), less);
+            };
+            if (spec == "compact") {
+                order([](const hwthread & a, const hwthread & b) {
+                    return a.package != b.package ? a.package < b.package
+                         : a.core != b.core ? a.core < b.core : a.smt < b.smt;
+                });
+            } else if (spec == "scatter") {
+                order([](const hwthread & a, const hwthread & b) {
+                    return a.smt != b.smt ? a.smt < b.smt
+                         : a.core != b.core ? a.core < b.core : a.package < b.package;
+                });
+            } else if (spec == "cores" || spec == "smt") {
+                order([](const hwthread & a, const hwthread & b) {
+                    return a.smt != b.smt ? a.smt < b.smt
+                         : a.package != b.package ? a.package < b.package : a.core < b.core;
+                });
+                if (spec == "cores") {
+                    hw.erase(std::remove_if(hw.begin(), hw.end(), [](const hwthread & h) { return h.smt > 0; }),
+                             hw.end());
+                }
+            } else {
+                throw "ERROR: PRK_AFFINITY must be compact, scatter, cores, smt or a CPU list";
+            }
+            for (const auto & h : hw) cpus.push_back(h.cpu);
+        }
+
+        bool enabled() const {
+            return !cpus.empty();
+        }
+
+        int cpu(int tid) const {
+            return cpus[static_cast<size_t>(tid) % cpus.size()];
+        }
+
+        // pins the calling thread to the CPU of team member tid
+        bool pin(int tid) const {
+            if (!enabled() || tid < 0) return false;
+#ifdef __linux__
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu(tid), &set);
+            if (sched_setaffinity(0, sizeof(set), &set) == 0) return true;
+            // the allowed set can still shrink after parsing (cpuset changes,
+            // hotplug), so say so once instead of failing silently per thread
+            static std::once_flag warned;
+            std::call_once(warned, [&] {
+                std::cout << "WARNING: PRK_AFFINITY could not pin thread " << tid
+                          << " to CPU " << cpu(tid) << std::endl;
+            });
+            return false;
+#else
+            return false;
+#endif
+        }
+
+        // prints the placement of a team of nthread threads
+        void print(int nthread) const {
+            if (!enabled()) return;
+            std::cout << "Affinity             = " << spec << " (thread:cpu";
+            for (int t=0; t<nthread; t++) {
+                std::cout << " " << t << ":" << cpu(t);
+            }
+            std::cout << ")" << std::endl;
+#ifndef __linux__
+            std::cout << "WARNING: thread pinning is only implemented for Linux" << std::endl;
+#endif
+        }
+    };
+
+    // reads PRK_AFFINITY
+    static inline affinity get_affinity() {
+        const char * env = std::getenv("PRK_AFFINITY");
+        return affinity((env != nullptr) ? std::string(env) : std::string());
+    }
+
+#ifdef USE_TBB
+    // pins each TBB thread as it joins the arena, by its arena slot
+    class affinity_observer : public tbb::task_scheduler_observer {
+
+      private:
+
+        const affinity & placement;
+
+      public:
+
+        affinity_observer(const affinity & a) : placement(a) {
+            if (placement.enabled()) observe(true);
+        }
+
+        ~affinity_observer() {
+            if (placement.enabled()) observe(false);
+        }
+
+        void on_scheduler_entry(bool) override {
+            placement.pin(tbb::this_task_arena::current_thread_index());
+        }
+    };
+#endif
+
+} // namespace prk
+
+#endif /* PRK_AFFINITY_H */
@@ -0,0 +1,235 @@
+///
+/// Copyright (c) 2018, Intel Corporation
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions
+/// are met:
+///
+/// * Redistributions of source code must retain the above copyright
+///       notice, this list of conditions and the following disclaimer.
+/// * Redistributions in binary form must reproduce the above
+///       copyright notice, this list of conditions and the following
+///       disclaimer in the documentation and/or other materials provided
+///       with the distribution.
+/// * Neither the name of Intel Corporation nor the names of its
+///       contributors may be used to endorse or promote products
+///       derived from this software without specific prior written
+///       permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+/// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+/// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+/// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+/// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+/// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+/// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+/// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+/// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+/// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef PRK_AUTOTUNE_H
+#define PRK_AUTOTUNE_H
+
+// Empirical tuning of blocking parameters.  A driver describes its
+// parameters as integer ranges and supplies a function that runs the
+// kernel once (a short trial) for a given point and returns its time:
+//
+//     prk::autotune tuner("transpose-vector", "order=4096", {{"tile_size", 4, 4096}});
+//     auto best = tuner.tune([&](const prk::autotune::point & p) { ... });
+//
+// The search evaluates a coarse grid of powers of two in every dimension
+// and then refines the best point with a pattern search whose step is
+// halved until no neighbour improves.  Each point is timed twice and the
+// faster trial counts.  PRK_AUTOTUNE_TRIALS bounds the number of points
+// (default 64).  The result is stored in a tuning database keyed by
+// hostname, kernel and problem, and later runs with the same key reuse it
+// without any trials.  The database is $HOME/.prk_autotune, or the file
+// named by PRK_AUTOTUNE_DB; remove a line from it to tune again.
+
+#include "prk_util.h"
+
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+# include <unistd.h>
+#endif
+
+namespace prk {
+
+    class autotune {
+
+      public:
+
+        using point = std::vector<int>;
+
+        // the bounds may be problem sizes, which are 64-bit, but no
+        // blocking parameter is ever larger than INT_MAX
+        struct range {
+            std::string name;
+            int lo, hi;
+            range(const std::string & n, int64_t l, int64_t h)
+                : name(n),
+                  lo(static_cast<int>(std::min<int64_t>(l,INT_MAX))),
+                  hi(static_cast<int>(std::min<int64_t>(h,INT_MAX))) {}
+        };
+
+      private:
+
+        std::string kernel;
+        std::string problem;
+        std::vector<range> ranges;
+        std::string filename;
+        std::string host;
+        int budget;
+
+        std::string format(const point & p) const {
+            std::ostringstream os;
+            for (size_t d=0; d<ranges.size(); d++) {
+                os << (d ? "," : "") << ranges[d].name << "=" << p[d];
+            }
+            return os.str();
+        }
+
+        // the last entry with our key wins, so a retuned point replaces an
+        // older one without rewriting the file
+        bool lookup(point & p) const {
+            std::ifstream in(filename);
+            std::string line;
+            bool found = false;
+            while (std::getline(in, line)) {
+                if (line.empty() || line[0] == '#') continue;
+                std::istringstream is(line);
+                std::string h, k, pr, params;
+                if (!(is >> h >> k >> pr >> params) || h != host || k != kernel || pr != problem) continue;
+                point q;
+                std::istringstream ps(params);
+                std::string item;
+                while (std::getline(ps, item, ',')) {
+                    const size_t eq = item.find('=');
+                    if (eq == std::string::npos) break;
+                    q.push_back(std::atoi(item.c_str()+eq+1));
+                }
+                if (q.size() == ranges.size()) {
+                    p = q;
+                    found = true;
+                }
+            }
+            return found;
+        }
+
+        void store(const point & p, double t) const {
+            std::ofstream out(filename, std::ios::app);
+            if (!out) {
+                std::cout << "WARNING: cannot write tuning database " << filename << std::endl;
+                return;
+            }
+            out << host << " " << kernel << " " << problem << " " << format(p) << " " << t << std::endl;
+        }
+
+      public:
+
+        autotune(const std::string & k, const std::string & pr, const std::vector<range> & r)
+            : kernel(k), problem(pr), ranges(r), budget(64)
+        {
+            const char * db = std::getenv("PRK_AUTOTUNE_DB");
+            const char * home = std::getenv("HOME");
+            if (db != nullptr && *db != '\0') {
+                filename = std::string(db);
+            } else {
+                filename = (home != nullptr) ? std::string(home) + "/.prk_autotune" : ".prk_autotune";
+            }
+            const char * trials = std::getenv("PRK_AUTOTUNE_TRIALS");
+            if (trials != nullptr && std::atoi(trials) > 0) budget = std::atoi(trials);
+            char name[256] = "localhost";
+#ifdef __linux__
+            gethostname(name, sizeof(name)-1);
+#endif
+            host = std::string(name);
+            for (auto & x : ranges) {
+                if (x.hi < x.lo) x.hi = x.lo;
+            }
+        }
+
+        point tune(const std::function<double(const point &)> & trial) {
+            point best;
+            if (lookup(best)) {
+                std::cout << "Autotune: " << format(best) << " (cached in " << filename << ")" << std::endl;
+                return best;
+            }
+
+            const size_t dims = ranges.size();
+            std::map<point,double> seen;
+            double best_time = 0.0;
+            const double start = wtime();
+
+            auto evaluate = [&] (const point & p) {
+                if (seen.count(p) || static_cast<int>(seen.size()) >= budget) return;
+                const double t = std::min(trial(p), trial(p));
+                seen[p] = t;
+                if (best.empty() || t < best_time) {
+                    best = p;
+                    best_time = t;
+                }
+            };
+
+            // coarse grid: lo, 2*lo, 4*lo, ... and hi in every dimension
+            std::vector<std::vector<int>> axes(dims);
+            for (size_t d=0; d<dims; d++) {
+                for (long v=ranges[d].lo; v<ranges[d].hi; v*=2) {
+                    axes[d].push_back(static_cast<int>(v));
+                    if (v == 0) break;
+                }
+                axes[d].push_back(ranges[d].hi);
+            }
+            point p(dims);
+            std::vector<size_t> index(dims,0);
+            while (true) {
+                for (size_t d=0; d<dims; d++) p[d] = axes[d][index[d]];
+                evaluate(p);
+                size_t d = 0;
+                while (d<dims && ++index[d] == axes[d].size()) {
+                    index[d++] = 0;
+                }
+                if (d == dims) break;
+            }
+
+            // local refinement around the best grid point
+            std::vector<int> step(dims);
+            for (size_t d=0; d<dims; d++) step[d] = best[d]/4;
+            bool active = true;
+            while (active && static_cast<int>(seen.size()) < budget) {
+                const point center = best;
+                for (size_t d=0; d<dims; d++) {
+                    for (int sign : {-1,1}) {
+                        point q = center;
+                        q[d] = std::max(ranges[d].lo, std::min(ranges[d].hi, q[d] + sign*step[d]));
+                        evaluate(q);
+                    }
+                }
+                if (best == center) {
+                    active = false;
+                    for (auto & s : step) {
+                        s /= 2;
+                        if (s > 0) active = true;
+                    }
+                }
+            }
+
+            std::cout << "Autotune: " << format(best) << " (" << seen.size() << " trials in "
+                      << wtime()-start << " s, stored in " << filename << ")" << std::endl;
+            store(best, best_time);
+            return best;
+        }
+    };
+
+} // namespace prk
+
+#endif /* PRK_AUTOTUNE_H */
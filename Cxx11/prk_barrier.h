@@ -0,0 +1,241 @@
+///
+/// Copyright (c) 2018, Intel Corporation
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions
+/// are met:
+///
+/// * Redistributions of source code must retain the above copyright
+///       notice, this list of conditions and the following disclaimer.
+/// * Redistributions in binary form must reproduce the above
+///       copyright notice, this list of conditions and the following
+///       disclaimer in the documentation and/or other materials provided
+///       with the distribution.
+/// * Neither the name of Intel Corporation nor the names of its
+///       contributors may be used to endorse or promote products
+///       derived from this software without specific prior written
+///       permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+/// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+/// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+/// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+/// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+/// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+/// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+/// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+/// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+/// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef PRK_BARRIER_H
+#define PRK_BARRIER_H
+
+// Barriers for a fixed team of std::threads.  All of them have the same
+// interface: construct with the number of threads, then every thread calls
+// wait(id) with its id in [0,nthread).  The algorithms are those of
+// Mellor-Crummey and Scott, "Algorithms for scalable synchronization on
+// shared-memory multiprocessors", ACM TOCS 9(1), 1991.
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <climits>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#else
+#include <mutex>
+#include <condition_variable>
+#endif
+
+#define PRK_CACHELINE 64
+
+namespace prk {
+
+    // a T that has a cache line to itself
+    template <typename T>
+    struct alignas(PRK_CACHELINE) padded {
+        T value;
+    };
+
+    // spin for a while, then give up the processor between polls
+    template <typename P>
+    static inline void spin_wait(P done)
+    {
+        for (int i=0; !done(); i++) {
+            if (i >= 1024) std::this_thread::yield();
+        }
+    }
+
+    // centralized sense-reversing barrier: one counter, one flag
+    class central_barrier {
+
+      private:
+
+        const int nthread;
+        padded<std::atomic<int>> count;
+        padded<std::atomic<bool>> sense;
+        std::vector<padded<bool>> local_sense;
+
+      public:
+
+        central_barrier(int n) : nthread(n), local_sense(n) {
+            count.value.store(n);
+            sense.value.store(false);
+            for (auto & s : local_sense) s.value = false;
+        }
+
+        void wait(int id) {
+            const bool s = !local_sense[id].value;
+            local_sense[id].value = s;
+            if (count.value.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                count.value.store(nthread, std::memory_order_relaxed);
+                sense.value.store(s, std::memory_order_release);
+            } else {
+                spin_wait([&] { return sense.value.load(std::memory_order_acquire) == s; });
+            }
+        }
+    };
+
+    // dissemination barrier: in round r, thread i signals thread i+2^r
+    // and waits for thread i-2^r, so there is no hot spot
+    class dissemination_barrier {
+
+      private:
+
+        const int nthread;
+        int rounds;
+        // flags[id*rounds+r] holds the last episode in which id was signaled in round r
+        std::vector<padded<std::atomic<uint64_t>>> flags;
+        std::vector<padded<uint64_t>> episode;
+
+      public:
+
+        dissemination_barrier(int n) : nthread(n), rounds(0), episode(n) {
+            while ((1<<rounds) < n) rounds++;
+            flags = std::vector<padded<std::atomic<uint64_t>>>(n*rounds);
+            for (auto & f : flags) f.value.store(0);
+            for (auto & e : episode) e.value = 0;
+        }
+
+        void wait(int id) {
+            const uint64_t e = ++episode[id].value;
+            for (int r=0; r<rounds; r++) {
+                const int partner = (id + (1<<r)) % nthread;
+                flags[partner*rounds+r].value.store(e, std::memory_order_release);
+                auto & mine = flags[id*rounds+r].value;
+                spin_wait([&] { return mine.load(std::memory_order_acquire) >= e; });
+            }
+        }
+    };
+
+    // tournament barrier: in round k, thread i with i%2^(k+1)==0 waits for
+    // the arrival of thread i+2^k, which then waits to be released.  Thread 0
+    // wins the tournament and releases the losers down the same tree.
+    class tournament_barrier {
+
+      private:
+
+        const int nthread;
+        std::vector<padded<std::atomic<uint64_t>>> arrival;
+        std::vector<padded<std::atomic<uint64_t>>> release;
+        std::vector<padded<uint64_t>> episode;
+
+      public:
+
+        tournament_barrier(int n) : nthread(n), arrival(n), release(n), episode(n) {
+            for (auto & a : arrival) a.value.store(0);
+            for (auto & r : release) r.value.store(0);
+            for (auto & e : episode) e.value = 0;
+        }
+
+        void wait(int id) {
+            const uint64_t e = ++episode[id].value;
+            int k = 0;
+            for (; (1<<k) < nthread; k++) {
+                if (id & (1<<k)) {
+                    // I lose this round: report arrival and wait for release
+                    arrival[id].value.store(e, std::memory_order_release);
+                    auto & mine = release[id].value;
+                    spin_wait([&] { return mine.load(std::memory_order_acquire) >= e; });
+                    break;
+                }
+                const int loser = id + (1<<k);
+                if (loser < nthread) {
+                    auto & theirs = arrival[loser].value;
+                    spin_wait([&] { return theirs.load(std::memory_order_acquire) >= e; });
+                }
+            }
+            // release the threads I beat, last round first
+            for (int j=k-1; j>=0; j--) {
+                const int loser = id + (1<<j);
+                if (loser < nthread) release[loser].value.store(e, std::memory_order_release);
+            }
+        }
+    };
+
+    // blocking barrier: waiters sleep in the kernel on the generation counter
+    // after a short spin, so oversubscribed runs do not burn processors
+    class futex_barrier {
+
+      private:
+
+        const int nthread;
+        padded<std::atomic<int>> count;
+        padded<std::atomic<int>> generation;
+#ifndef __linux__
+        std::mutex mutex;
+        std::condition_variable cv;
+#endif
+
+        void sleep(int g) {
+#ifdef __linux__
+            syscall(SYS_futex, reinterpret_cast<int*>(&generation.value), FUTEX_WAIT_PRIVATE, g, nullptr, nullptr, 0);
+#else
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&] { return generation.value.load(std::memory_order_acquire) != g; });
+#endif
+        }
+
+        void wake_all() {
+#ifdef __linux__
+            syscall(SYS_futex, reinterpret_cast<int*>(&generation.value), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+            std::lock_guard<std::mutex> lock(mutex);
+            cv.notify_all();
+#endif
+        }
+
+      public:
+
+        futex_barrier(int n) : nthread(n) {
+            count.value.store(n);
+            generation.value.store(0);
+        }
+
+        void wait(int) {
+            // read the generation before arriving, else the last thread may
+            // have moved on already
+            const int g = generation.value.load(std::memory_order_acquire);
+            if (count.value.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                count.value.store(nthread, std::memory_order_relaxed);
+                generation.value.fetch_add(1, std::memory_order_release);
+                wake_all();
+            } else {
+                for (int i=0; i<1024; i++) {
+                    if (generation.value.load(std::memory_order_acquire) != g) return;
+                }
+                while (generation.value.load(std::memory_order_acquire) == g) {
+                    sleep(g);
+                }
+            }
+        }
+    };
+
+} // namespace prk
+
+#endif /* PRK_BARRIER_H */
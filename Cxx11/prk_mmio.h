@@ -0,0 +1,299 @@
+///
+/// Copyright (c) 2018, Intel Corporation
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions
+/// are met:
+///
+/// * Redistributions of source code must retain the above copyright
+///       notice, this list of conditions and the following disclaimer.
+/// * Redistributions in binary form must reproduce the above
+///       copyright notice, this list of conditions and the following
+///       disclaimer in the documentation and/or other materials provided
+///       with the distribution.
+/// * Neither the name of Intel Corporation nor the names of its
+///       contributors may be used to endorse or promote products
+///       derived from this software without specific prior written
+///       permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+/// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+/// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+/// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+/// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+/// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+/// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+/// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+/// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+/// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef PRK_MMIO_H
+#define PRK_MMIO_H
+
+// Matrix Market (coordinate format) reader that produces CSR.
+// See https://math.nist.gov/MatrixMarket/formats.html for the format.
+//
+// The file is mapped into memory and the entry section is split into
+// one chunk per thread at line boundaries, so that parsing the text,
+// which dominates the cost for large matrices, runs in parallel.
+
+#include <cstring>
+#include <cctype>
+
+#include <thread>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace prk {
+
+    struct csr_matrix {
+        size_t nrows;
+        size_t ncols;
+        std::vector<size_t> rowPtr;
+        std::vector<size_t> colIndex;
+        std::vector<double> values;
+    };
+
+    namespace mmio {
+
+        struct triplet {
+            size_t row;
+            size_t col;
+            double val;
+        };
+
+        // Bounded parsers: the mapping is not NUL-terminated, so std::strtod
+        // cannot be used on it directly.
+
+        static inline const char * skip_blanks(const char * p, const char * end)
+        {
+            while (p<end && (*p==' ' || *p=='\t' || *p=='\r')) p++;
+            return p;
+        }
+
+        static inline const char * next_line(const char * p, const char * end)
+        {
+            while (p<end && *p!='\n') p++;
+            return (p<end) ? p+1 : end;
+        }
+
+        static inline const char * parse_index(const char * p, const char * end, size_t & x)
+        {
+            p = skip_blanks(p,end);
+            if (p==end || !std::isdigit(*p)) {
+                throw "ERROR: Matrix Market entry has an invalid index";
+            }
+            size_t r(0);
+            while (p<end && std::isdigit(*p)) {
+                r = 10*r + (*p-'0');
+                p++;
+            }
+            x = r;
+            return p;
+        }
+
+        static inline const char * parse_value(const char * p, const char * end, double & x)
+        {
+            p = skip_blanks(p,end);
+            char buf[64];
+            size_t len(0);
+            while (p<end && len<sizeof(buf)-1 && !std::isspace(*p)) {
+                buf[len++] = *p++;
+            }
+            buf[len] = '\0';
+            char * last;
+            x = std::strtod(buf,&last);
+            if (len==0 || last==buf) {
+                throw "ERROR: Matrix Market entry has an invalid value";
+            }
+            return p;
+        }
+
+        static void parse_chunk(const char * p, const char * end, bool pattern,
+                                std::vector<triplet> & entries)
+        {
+            while (p<end) {
+                const char * q = skip_blanks(p,end);
+                if (q==end || *q=='\n' || *q=='%') {
+                    p = next_line(q,end);
+                    continue;
+                }
+                triplet t;
+                q = parse_index(q,end,t.row);
+                q = parse_index(q,end,t.col);
+                if (pattern) {
+                    t.val = 1.0;
+                } else {
+                    q = parse_value(q,end,t.val);
+                }
+                entries.push_back(t);
+                p = next_line(q,end);
+            }
+        }
+
+    } // namespace mmio
+
+    // Reads a real, integer or pattern coordinate matrix, expanding the
+    // symmetric and skew-symmetric storage schemes.  Throws a C string
+    // on error, like the argument parsing in the drivers.
+    static csr_matrix read_matrix_market(const char * filename, int nthreads)
+    {
+        int fd = open(filename, O_RDONLY);
+        if (fd < 0) {
+            throw "ERROR: cannot open Matrix Market file";
+        }
+        struct stat sb;
+        if (fstat(fd, &sb) != 0 || sb.st_size == 0) {
+            close(fd);
+            throw "ERROR: cannot stat Matrix Market file or file is empty";
+        }
+        const size_t bytes = sb.st_size;
+        void * map = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (map == MAP_FAILED) {
+            throw "ERROR: cannot mmap Matrix Market file";
+        }
+        madvise(map, bytes, MADV_SEQUENTIAL);
+        madvise(map, bytes, MADV_WILLNEED);
+
+        const char * const begin = static_cast<const char*>(map);
+        const char * const end   = begin + bytes;
+
+        // banner: %%MatrixMarket matrix coordinate <field> <symmetry>
+        const char * p = begin;
+        std::string banner(p, mmio::next_line(p,end));
+        std::transform(banner.begin(), banner.end(), banner.begin(), ::tolower);
+        if (banner.compare(0,14,"%%matrixmarket") != 0 ||
+            banner.find("coordinate") == std::string::npos) {
+            munmap(map, bytes);
+            throw "ERROR: only Matrix Market coordinate format is supported";
+        }
+        if (banner.find("complex") != std::string::npos) {
+            munmap(map, bytes);
+            throw "ERROR: complex Matrix Market files are not supported";
+        }
+        const bool pattern   = (banner.find("pattern") != std::string::npos);
+        const bool skew      = (banner.find("skew-symmetric") != std::string::npos);
+        const bool symmetric = skew || (banner.find("symmetric") != std::string::npos)
+                                    || (banner.find("hermitian") != std::string::npos);
+
+        // skip comments, then read the size line
+        p = mmio::next_line(p,end);
+        while (p<end && (*p=='%' || *p=='\n' || *p=='\r')) {
+            p = mmio::next_line(p,end);
+        }
+        size_t nrows, ncols, nnz;
+        try {
+            p = mmio::parse_index(p,end,nrows);
+            p = mmio::parse_index(p,end,ncols);
+            p = mmio::parse_index(p,end,nnz);
+        }
+        catch (const char *) {
+            munmap(map, bytes);
+            throw "ERROR: Matrix Market size line is invalid";
+        }
+        p = mmio::next_line(p,end);
+
+        // split the entry section at line boundaries and parse in parallel
+        if (nthreads < 1) nthreads = 1;
+        std::vector<const char *> bounds(nthreads+1);
+        bounds[0] = p;
+        bounds[nthreads] = end;
+        const size_t chunk = (end-p)/nthreads;
+        for (int t=1; t<nthreads; t++) {
+            const char * b = std::max(bounds[t-1], p + t*chunk);
+            bounds[t] = (b>p && b[-1]=='\n') ? b : mmio::next_line(b,end);
+        }
+
+        std::vector<std::vector<mmio::triplet>> entries(nthreads);
+        std::vector<const char *> errors(nthreads,nullptr);
+        std::vector<std::thread> pool;
+        for (int t=0; t<nthreads; t++) {
+            pool.push_back(std::thread([=,&entries,&errors,&bounds] {
+                try {
+                    entries[t].reserve(nnz/nthreads+1);
+                    mmio::parse_chunk(bounds[t], bounds[t+1], pattern, entries[t]);
+                }
+                catch (const char * e) {
+                    errors[t] = e;
+                }
+            }));
+        }
+        std::for_each(pool.begin(), pool.end(), [](std::thread & t) { t.join(); });
+        pool.clear();
+        munmap(map, bytes);
+
+        size_t count(0);
+        for (int t=0; t<nthreads; t++) {
+            if (errors[t]) throw errors[t];
+            count += entries[t].size();
+        }
+        if (count != nnz) {
+            throw "ERROR: Matrix Market entry count does not match size line";
+        }
+
+        // counting sort by row into CSR
+        csr_matrix A;
+        A.nrows = nrows;
+        A.ncols = ncols;
+        A.rowPtr.assign(nrows+1,0);
+        for (auto & e : entries) {
+            for (auto & x : e) {
+                if (x.row<1 || x.row>nrows || x.col<1 || x.col>ncols) {
+                    throw "ERROR: Matrix Market entry index out of range";
+                }
+                A.rowPtr[x.row]++;
+                if (symmetric && x.row!=x.col) A.rowPtr[x.col]++;
+            }
+        }
+        std::partial_sum(A.rowPtr.begin(), A.rowPtr.end(), A.rowPtr.begin());
+        const size_t nent = A.rowPtr[nrows];
+        A.colIndex.resize(nent);
+        A.values.resize(nent);
+        std::vector<size_t> fill(A.rowPtr.begin(), A.rowPtr.end()-1);
+        for (auto & e : entries) {
+            for (auto & x : e) {
+                size_t k = fill[x.row-1]++;
+                A.colIndex[k] = x.col-1;
+                A.values[k]   = x.val;
+                if (symmetric && x.row!=x.col) {
+                    k = fill[x.col-1]++;
+                    A.colIndex[k] = x.row-1;
+                    A.values[k]   = skew ? -x.val : x.val;
+                }
+            }
+            std::vector<mmio::triplet>().swap(e);
+        }
+
+        // sort the columns within each row, rows split among threads
+        for (int t=0; t<nthreads; t++) {
+            pool.push_back(std::thread([=,&A] {
+                std::vector<std::pair<size_t,double>> row;
+                for (size_t i=t; i<A.nrows; i+=nthreads) {
+                    const size_t first = A.rowPtr[i];
+                    const size_t last  = A.rowPtr[i+1];
+                    row.clear();
+                    for (size_t k=first; k<last; k++) {
+                        row.push_back(std::make_pair(A.colIndex[k],A.values[k]));
+                    }
+                    std::sort(row.begin(), row.end());
+                    for (size_t k=first; k<last; k++) {
+                        A.colIndex[k] = row[k-first].first;
+                        A.values[k]   = row[k-first].second;
+                    }
+                }
+            }));
+        }
+        std::for_each(pool.begin(), pool.end(), [](std::thread & t) { t.join(); });
+
+        return A;
+    }
+
+} // namespace prk
+
+#endif /* PRK_MMIO_H */
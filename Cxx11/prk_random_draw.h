@@ -0,0 +1,180 @@
+///
+/// Copyright (c) 2018, Intel Corporation
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions
+/// are met:
+///
+/// * Redistributions of source code must retain the above copyright
+///       notice, this list of conditions and the following disclaimer.
+/// * Redistributions in binary form must reproduce the above
+///       copyright notice, this list of conditions and the following
+///       disclaimer in the documentation and/or other materials provided
+///       with the distribution.
+/// * Neither the name of Intel Corporation nor the names of its
+///       contributors may be used to endorse or promote products
+///       derived from this software without specific prior written
+///       permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+/// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+/// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+/// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+/// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+/// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+/// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+/// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+/// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+/// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef PRK_RANDOM_DRAW_H
+#define PRK_RANDOM_DRAW_H
+
+// C++ port of common/random_draw.c, which is used to initialize the
+// PIC and AMR kernels.  The sequence of numbers is identical to the C
+// version, so the C++ drivers place exactly the same particles.
+//
+// prk::lcg is the underlying linear congruential engine.  It satisfies
+// the UniformRandomBitGenerator requirements, so it can be used with the
+// <random> distributions, and it can jump ahead in O(log n) steps, which
+// gives every thread its own window of the one reproducible sequence.
+
+#include <cstdint>
+#include <cstddef>
+#include <climits>
+#include <cmath>
+
+#include "prk_simd.h"
+
+namespace prk {
+
+    class lcg {
+
+      public:
+
+        typedef uint64_t result_type;
+
+        static constexpr uint64_t multiplier   = 6364136223846793005ULL;
+        static constexpr uint64_t increment    = 1442695040888963407ULL;
+        static constexpr uint64_t default_seed = 27182818285ULL;
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return UINT64_MAX; }
+
+        explicit lcg(uint64_t s = default_seed) : state(s) {}
+
+        void seed(uint64_t s = default_seed) { state = s; }
+
+        result_type operator()() {
+            state = multiplier*state + increment;
+            return state;
+        }
+
+        // advance the engine as if operator() had been called n times
+        void discard(uint64_t n) {
+            uint64_t A, C;
+            affine(n, A, C);
+            state = A*state + C;
+        }
+
+        // out[0..n) receives the next n numbers.  W independent lanes each
+        // advance W steps at a time, which the compiler can vectorize.
+        void fill(result_type * out, size_t n) {
+            const int W = 8;
+            if (n < 2*W) {
+                for (size_t i=0; i<n; i++) out[i] = (*this)();
+                return;
+            }
+            uint64_t x[W];
+            for (int j=0; j<W; j++) x[j] = (*this)();
+            uint64_t A, C;
+            affine(W, A, C);
+            size_t i = 0;
+            for (; i+W<=n; i+=W) {
+                PRAGMA_SIMD
+                for (int j=0; j<W; j++) {
+                    out[i+j] = x[j];
+                    x[j] = A*x[j] + C;
+                }
+            }
+            for (int j=0; i<n; i++, j++) out[i] = x[j];
+            state = out[n-1];
+        }
+
+      private:
+
+        uint64_t state;
+
+        // n steps of x -> a*x+c are x -> A*x+C; square-and-multiply on the map
+        static void affine(uint64_t n, uint64_t & A, uint64_t & C) {
+            uint64_t a = multiplier, c = increment;
+            A = 1;
+            C = 0;
+            while (n) {
+                if (n&1) {
+                    A = a*A;
+                    C = a*C + c;
+                }
+                c = (a+1)*c;
+                a = a*a;
+                n >>= 1;
+            }
+        }
+    };
+
+    class random_draw {
+
+      private:
+
+        lcg engine;
+
+      public:
+
+        random_draw() { init(); }
+
+        // (re)set the seed
+        void init() {
+            engine.seed();
+        }
+
+        uint64_t next(uint64_t bound) {
+            return engine() % bound;
+        }
+
+        // position the generator as if next() had been called m times
+        // since init(); the bound is kept for symmetry with LCG_jump
+        void jump(uint64_t m, uint64_t = 0) {
+            engine.seed();
+            engine.discard(m);
+        }
+
+        // number of particles to place in a cell with expected value mu;
+        // consumes exactly two numbers of the sequence
+        uint64_t draw(double mu) {
+            const double   two_pi      = 2.0*3.14159265358979323846;
+            const uint64_t rand_max    = ULLONG_MAX;
+            const double   rand_div    = 1.0/ULLONG_MAX;
+            const uint64_t denominator = UINT_MAX;
+
+            if (mu>=1.0) {
+                // set std dev equal to 15% of average; ensures result will never be negative
+                const double sigma = mu*0.15;
+                const double u0 = next(rand_max) * rand_div;
+                const double u1 = next(rand_max) * rand_div;
+                const double z0 = std::sqrt(-2.0 * std::log(u0)) * std::cos(two_pi * u1);
+                return static_cast<uint64_t>(z0 * sigma + mu+0.5);
+            } else {
+                // we need to pick two integers whose quotient approximates mu; set one to UINT_MAX
+                const uint64_t numerator = static_cast<uint32_t>(mu*static_cast<double>(denominator));
+                next(denominator); // don't use value, but must call next twice
+                const uint64_t i1 = next(denominator);
+                return static_cast<uint64_t>(i1<=numerator);
+            }
+        }
+    };
+
+} // namespace prk
+
+#endif /* PRK_RANDOM_DRAW_H */
@@ -0,0 +1,200 @@
+///
+/// Copyright (c) 2018, Intel Corporation
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions
+/// are met:
+///
+/// * Redistributions of source code must retain the above copyright
+///       notice, this list of conditions and the following disclaimer.
+/// * Redistributions in binary form must reproduce the above
+///       copyright notice, this list of conditions and the following
+///       disclaimer in the documentation and/or other materials provided
+///       with the distribution.
+/// * Neither the name of Intel Corporation nor the names of its
+///       contributors may be used to endorse or promote products
+///       derived from this software without specific prior written
+///       permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+/// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+/// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+/// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+/// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+/// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+/// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+/// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+/// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+/// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef PRK_TRACE_H
+#define PRK_TRACE_H
+
+// Task tracing for the task-based kernels.  Wrap the body of a task in
+//
+//     PRK_TRACE_SCOPE("name", x, y);
+//
+// where (x,y) identifies the tile.  Tracing is off unless the environment
+// variable PRK_TRACE names an output file.  Each thread then records the
+// start and end of its tasks into its own ring buffer, without locks or
+// shared cache lines, and at exit all buffers are written to that file in
+// the Chrome trace event format (load it in chrome://tracing or Perfetto).
+// PRK_TRACE_EVENTS sets the capacity of each ring (default 65536 events);
+// when a ring is full, the oldest events are overwritten.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace prk {
+
+    namespace trace {
+
+        struct event {
+            const char * name;
+            int x, y;
+            uint64_t start, stop; // ns since the trace began
+        };
+
+        // written only by its owning thread, read only at exit
+        class ring {
+
+          public:
+
+            const int tid;
+            const size_t capacity;
+            std::vector<event> events;
+            uint64_t head;
+
+            // short-lived threads (e.g. std::async) should not pay for a
+            // full ring, so it grows up to its capacity
+            ring(int id, size_t c) : tid(id), capacity(c), head(0) {
+                events.reserve(std::min(c,size_t(1024)));
+            }
+
+            void push(const event & e) {
+                if (events.size() < capacity) {
+                    events.push_back(e);
+                } else {
+                    events[head % capacity] = e;
+                }
+                head++;
+            }
+        };
+
+        class tracer {
+
+          public:
+
+            bool on;
+            std::string filename;
+            size_t capacity;
+            std::chrono::steady_clock::time_point epoch;
+            std::mutex mutex; // protects rings, taken once per thread
+            std::vector<std::unique_ptr<ring>> rings;
+
+            tracer() : on(false), capacity(65536), epoch(std::chrono::steady_clock::now()) {
+                const char * file = std::getenv("PRK_TRACE");
+                if (file == nullptr || *file == '\0') return;
+                filename = std::string(file);
+                const char * cap = std::getenv("PRK_TRACE_EVENTS");
+                if (cap != nullptr && std::atol(cap) > 0) capacity = std::atol(cap);
+                on = true;
+                std::atexit([] { instance().dump(); });
+            }
+
+            // never destroyed, so that the atexit handler and threads that
+            // outlive main can still use it
+            static tracer & instance() {
+                static tracer * t = new tracer;
+                return *t;
+            }
+
+            uint64_t now() const {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>
+                           (std::chrono::steady_clock::now() - epoch).count();
+            }
+
+            ring * make_ring() {
+                std::lock_guard<std::mutex> lock(mutex);
+                rings.emplace_back(new ring(static_cast<int>(rings.size()), capacity));
+                return rings.back().get();
+            }
+
+            void dump() {
+                std::lock_guard<std::mutex> lock(mutex);
+                FILE * f = std::fopen(filename.c_str(), "w");
+                if (f == nullptr) {
+                    std::printf("WARNING: cannot write trace file %s\n", filename.c_str());
+                    return;
+                }
+                uint64_t written = 0, dropped = 0;
+                std::fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+                for (auto & r : rings) {
+                    std::fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,"
+                                    "\"args\":{\"name\":\"thread %d\"}}",
+                                 (written++ ? ",\n" : ""), r->tid, r->tid);
+                    const uint64_t size  = r->capacity;
+                    const uint64_t count = std::min(r->head, size);
+                    dropped += r->head - count;
+                    for (uint64_t k = r->head - count; k < r->head; k++) {
+                        const event & e = r->events[k % size];
+                        std::fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,"
+                                        "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"x\":%d,\"y\":%d}}",
+                                     e.name, r->tid, 1.e-3*e.start, 1.e-3*(e.stop-e.start), e.x, e.y);
+                        written++;
+                    }
+                }
+                std::fprintf(f, "\n]}\n");
+                std::fclose(f);
+                std::printf("Trace file %s: %llu events from %zu threads, %llu overwritten\n",
+                            filename.c_str(), static_cast<unsigned long long>(written - rings.size()),
+                            rings.size(), static_cast<unsigned long long>(dropped));
+            }
+        };
+
+        static inline bool enabled() {
+            return tracer::instance().on;
+        }
+
+        static inline ring * my_ring() {
+            static thread_local ring * r = tracer::instance().make_ring();
+            return r;
+        }
+
+        // records the lifetime of the enclosing block as one event
+        class scope {
+
+          private:
+
+            const char * name;
+            int x, y;
+            uint64_t start;
+
+          public:
+
+            scope(const char * n, int i, int j) : name(n), x(i), y(j), start(0) {
+                if (enabled()) start = tracer::instance().now();
+            }
+
+            ~scope() {
+                if (enabled()) my_ring()->push(event{name, x, y, start, tracer::instance().now()});
+            }
+        };
+
+    } // namespace trace
+
+} // namespace prk
+
+#define PRK_TRACE_SCOPE(name,x,y) prk::trace::scope prk_trace_scope_(name,x,y)
+
+#endif /* PRK_TRACE_H */
@@ -0,0 +1,205 @@
+///
+/// Copyright (c) 2018, Intel Corporation
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions
+/// are met:
+///
+/// * Redistributions of source code must retain the above copyright
+///       notice, this list of conditions and the following disclaimer.
+/// * Redistributions in binary form must reproduce the above
+///       copyright notice, this list of conditions and the following
+///       disclaimer in the documentation and/or other materials provided
+///       with the distribution.
+/// * Neither the name of Intel Corporation nor the names of its
+///       contributors may be used to endorse or promote products
+///       derived from this software without specific prior written
+///       permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+/// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+/// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+/// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+/// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+/// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+/// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+/// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+/// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+/// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef PRK_TYPES_H
+#define PRK_TYPES_H
+
+// Element types for the kernels that are templated on precision, in the
+// spirit of DTYPE/EPSILON in SERIAL/AMR.  The precision is chosen at run
+// time with PRK_PRECISION=double (default), float, bf16 or fp16.  The
+// 16-bit types are storage formats only: they convert to float, which is
+// the type all arithmetic is done in, and round to nearest even when a
+// result is stored.  The conversions are plain integer operations so that
+// they vectorize without F16C or AVX512-BF16.
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cfloat>
+#include <string>
+
+namespace prk {
+
+    namespace detail {
+
+        static inline uint32_t float_bits(float f) {
+            uint32_t u;
+            std::memcpy(&u, &f, sizeof(u));
+            return u;
+        }
+
+        static inline float bits_float(uint32_t u) {
+            float f;
+            std::memcpy(&f, &u, sizeof(f));
+            return f;
+        }
+
+    } // namespace detail
+
+    // bfloat16: the upper half of an IEEE float
+    class bf16 {
+
+      private:
+
+        uint16_t bits;
+
+      public:
+
+        bf16() = default;
+
+        bf16(float f) {
+            uint32_t x = detail::float_bits(f);
+            const bool nan = (x & 0x7fffffffu) > 0x7f800000u;
+            // round to nearest even; keep NaN quiet instead of rounding it to inf
+            x = nan ? (x | 0x00400000u) : x + 0x7fffu + ((x >> 16) & 1u);
+            bits = static_cast<uint16_t>(x >> 16);
+        }
+
+        operator float() const {
+            return detail::bits_float(static_cast<uint32_t>(bits) << 16);
+        }
+
+        bf16 & operator+=(float x) {
+            return *this = bf16(static_cast<float>(*this) + x);
+        }
+    };
+
+    // IEEE binary16, converted as in F. Giesen's float_to_half_fast3_rtne
+    class fp16 {
+
+      private:
+
+        uint16_t bits;
+
+      public:
+
+        fp16() = default;
+
+        fp16(float f) {
+            uint32_t x = detail::float_bits(f);
+            const uint32_t sign = x & 0x80000000u;
+            x ^= sign;
+            uint32_t o;
+            if (x >= 0x47800000u) {
+                // overflow to inf, or NaN
+                o = (x > 0x7f800000u) ? 0x7e00u : 0x7c00u;
+            } else if (x < 0x38800000u) {
+                // subnormal or zero: let the FPU align the mantissa
+                o = detail::float_bits(detail::bits_float(x) + 0.5f) - 0x3f000000u;
+            } else {
+                const uint32_t odd = (x >> 13) & 1u;
+                x += (static_cast<uint32_t>(15-127) << 23) + 0xfffu + odd;
+                o = x >> 13;
+            }
+            bits = static_cast<uint16_t>(o | (sign >> 16));
+        }
+
+        operator float() const {
+            const uint32_t shifted_exp = 0x7c00u << 13;
+            uint32_t o = (static_cast<uint32_t>(bits) & 0x7fffu) << 13;
+            const uint32_t exp = shifted_exp & o;
+            o += static_cast<uint32_t>(127-15) << 23;
+            if (exp == shifted_exp) {
+                // inf or NaN
+                o += static_cast<uint32_t>(128-16) << 23;
+            } else if (exp == 0) {
+                // subnormal
+                o += 1u << 23;
+                o = detail::float_bits(detail::bits_float(o) - detail::bits_float(113u << 23));
+            }
+            o |= (static_cast<uint32_t>(bits) & 0x8000u) << 16;
+            return detail::bits_float(o);
+        }
+
+        fp16 & operator+=(float x) {
+            return *this = fp16(static_cast<float>(*this) + x);
+        }
+    };
+
+    // name:    short name, as in PRK_PRECISION
+    // compute: the type arithmetic is done in
+    // epsilon: validation tolerance, relative to the size of the result
+    // exact:   largest integer up to which all integers are representable
+    // max:     largest finite value
+    template <typename T> struct precision_traits;
+
+    template <> struct precision_traits<double> {
+        using compute = double;
+        static constexpr const char * name = "double";
+        static constexpr const char * description = "double";
+        static constexpr double epsilon = 1.e-8;
+        static constexpr double exact = 9007199254740992.0;
+        static constexpr double max = DBL_MAX;
+    };
+
+    template <> struct precision_traits<float> {
+        using compute = float;
+        static constexpr const char * name = "float";
+        static constexpr const char * description = "float";
+        static constexpr double epsilon = 1.e-4;
+        static constexpr double exact = 16777216.0;
+        static constexpr double max = FLT_MAX;
+    };
+
+    template <> struct precision_traits<bf16> {
+        using compute = float;
+        static constexpr const char * name = "bf16";
+        static constexpr const char * description = "bf16 storage, float compute";
+        static constexpr double epsilon = 5.e-2;
+        static constexpr double exact = 256.0;
+        static constexpr double max = 3.3895313892515355e38;
+    };
+
+    template <> struct precision_traits<fp16> {
+        using compute = float;
+        static constexpr const char * name = "fp16";
+        static constexpr const char * description = "fp16 storage, float compute";
+        static constexpr double epsilon = 1.e-2;
+        static constexpr double exact = 2048.0;
+        static constexpr double max = 65504.0;
+    };
+
+    enum class precision { fp64, fp32, bf16, fp16 };
+
+    // reads PRK_PRECISION; throws like the argument parsers of the drivers
+    static inline precision get_precision() {
+        const char * env = std::getenv("PRK_PRECISION");
+        const std::string p = (env != nullptr) ? std::string(env) : std::string("double");
+        if (p == "double" || p == "fp64" || p.empty()) return precision::fp64;
+        if (p == "float"  || p == "fp32") return precision::fp32;
+        if (p == "bf16")                  return precision::bf16;
+        if (p == "fp16"   || p == "half") return precision::fp16;
+        throw "ERROR: PRK_PRECISION must be one of double, float, bf16 or fp16";
+    }
+
+} // namespace prk
+
+#endif /* PRK_TYPES_H */
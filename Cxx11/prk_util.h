@@ -51,6 +51,8 @@
 #include <string>
 #include <iostream>
 #include <iomanip> // std::setprecision
+#include <sstream>
+#include <fstream>
 #include <exception>
 #include <list>
 #include <vector>
@@ -58,13 +60,24 @@
 
 #include <chrono>
 #include <random>
+
+#ifdef __linux__
+# include <cerrno>
+# include <cstring>
+# include <unistd.h>
+# include <sys/ioctl.h>
+# include <sys/syscall.h>
+# include <linux/perf_event.h>
+#endif
 #include <typeinfo>
 #include <array>
 #include <atomic>
+#include <thread>
 #include <numeric>
 #include <algorithm>
 
 #include "prk_simd.h"
+#include "prk_types.h"
 
 #ifdef USE_RANGES
 # include "prk_ranges.h"
@@ -113,6 +126,529 @@ namespace prk {
         return ( numerator / denominator + (numerator % denominator > 0) );
     }
 
+    // Hardware performance counters around a timed region, via Linux
+    // perf_event_open.  They are off unless PRK_COUNTERS is set, either to
+    // "default" (cycles, instructions, LLC misses and dTLB misses) or to a
+    // comma-separated list of event names (see counters::lookup) and raw
+    // event codes like raw:0x01b1.  The counters of the thread that
+    // constructs the object are measured between start() and stop();
+    // threaded kernels use one object per thread and add them up.
+    // Events that cannot be opened (no PMU in a VM, perf_event_paranoid,
+    // not Linux) are reported as unavailable and otherwise ignored.
+    class counters {
+
+      private:
+
+        struct event {
+            std::string name;
+            uint32_t    type;
+            uint64_t    config;
+            int         fd;
+            double      value;
+        };
+
+        std::vector<event> events;
+        std::string        unavailable;
+        bool               enabled;
+
+#ifdef __linux__
+        static bool lookup(const std::string & name, uint32_t & type, uint64_t & config) {
+            const uint64_t cache_miss = (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            if      (name == "cycles")           { type = PERF_TYPE_HARDWARE; config = PERF_COUNT_HW_CPU_CYCLES; }
+            else if (name == "instructions")     { type = PERF_TYPE_HARDWARE; config = PERF_COUNT_HW_INSTRUCTIONS; }
+            else if (name == "branch-misses")    { type = PERF_TYPE_HARDWARE; config = PERF_COUNT_HW_BRANCH_MISSES; }
+            else if (name == "llc-misses")       { type = PERF_TYPE_HW_CACHE; config = PERF_COUNT_HW_CACHE_LL   | cache_miss; }
+            else if (name == "l1d-misses")       { type = PERF_TYPE_HW_CACHE; config = PERF_COUNT_HW_CACHE_L1D  | cache_miss; }
+            else if (name == "dtlb-misses")      { type = PERF_TYPE_HW_CACHE; config = PERF_COUNT_HW_CACHE_DTLB | cache_miss; }
+            else if (name == "task-clock")       { type = PERF_TYPE_SOFTWARE; config = PERF_COUNT_SW_TASK_CLOCK; }
+            else if (name == "page-faults")      { type = PERF_TYPE_SOFTWARE; config = PERF_COUNT_SW_PAGE_FAULTS; }
+            else if (name == "context-switches") { type = PERF_TYPE_SOFTWARE; config = PERF_COUNT_SW_CONTEXT_SWITCHES; }
+            else if (name.compare(0,4,"raw:") == 0) {
+                type = PERF_TYPE_RAW;
+                config = std::strtoull(name.c_str()+4, nullptr, 0);
+            }
+            else return false;
+            return true;
+        }
+
+        static int open_event(uint32_t type, uint64_t config) {
+            struct perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size           = sizeof(attr);
+            attr.type           = type;
+            attr.config         = config;
+            attr.disabled       = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv     = 1;
+            // scale for multiplexing when there are more events than counters
+            attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+#endif
+
+        double get(const std::string & name) const {
+            for (auto & e : events) {
+                if (e.name == name && e.fd >= 0) return e.value;
+            }
+            return -1.0;
+        }
+
+      public:
+
+        counters() : enabled(false) {
+            const char * env = std::getenv("PRK_COUNTERS");
+            if (env == nullptr || *env == '\0') return;
+            enabled = true;
+            std::string list(env);
+            if (list == "default" || list == "1") {
+                list = "cycles,instructions,llc-misses,dtlb-misses";
+            }
+            size_t pos = 0;
+            while (pos <= list.size()) {
+                size_t comma = list.find(',', pos);
+                if (comma == std::string::npos) comma = list.size();
+                const std::string name = list.substr(pos, comma-pos);
+                pos = comma+1;
+                if (name.empty()) continue;
+                event e{name, 0, 0, -1, 0.0};
+#ifdef __linux__
+                if (!lookup(name, e.type, e.config)) {
+                    unavailable += " " + name + " (unknown event)";
+                } else if ((e.fd = open_event(e.type, e.config)) < 0) {
+                    unavailable += " " + name + " (" + std::strerror(errno) + ")";
+                }
+#else
+                unavailable += " " + name + " (perf_event_open requires Linux)";
+#endif
+                events.push_back(e);
+            }
+        }
+
+        ~counters() {
+#ifdef __linux__
+            for (auto & e : events) {
+                if (e.fd >= 0) close(e.fd);
+            }
+#endif
+        }
+
+        counters(const counters &) = delete;
+        counters & operator=(const counters &) = delete;
+
+        void start() {
+#ifdef __linux__
+            for (auto & e : events) {
+                if (e.fd < 0) continue;
+                ioctl(e.fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(e.fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+#endif
+        }
+
+        void stop() {
+#ifdef __linux__
+            for (auto & e : events) {
+                if (e.fd < 0) continue;
+                ioctl(e.fd, PERF_EVENT_IOC_DISABLE, 0);
+                uint64_t data[3] = {0,0,0}; // value, time enabled, time running
+                if (read(e.fd, data, sizeof(data)) == sizeof(data) && data[2] > 0) {
+                    e.value += static_cast<double>(data[0]) * static_cast<double>(data[1])
+                                                           / static_cast<double>(data[2]);
+                }
+            }
+#endif
+        }
+
+        // aggregate the counts of another thread
+        counters & operator+=(const counters & other) {
+            for (size_t i=0; i<events.size() && i<other.events.size(); i++) {
+                events[i].value += other.events[i].value;
+            }
+            return *this;
+        }
+
+        // print the counts and the metrics derived from them, given the
+        // number of bytes moved and flops done in the measured region
+        void print(double bytes, double flops = 0.0) const {
+            if (!enabled) return;
+            if (!unavailable.empty()) {
+                std::cout << "Counters unavailable:" << unavailable << std::endl;
+            }
+            bool any = false;
+            for (auto & e : events) {
+                if (e.fd < 0) continue;
+                std::cout << (any ? " " : "Counters: ") << e.name << "=" << e.value;
+                any = true;
+            }
+            if (!any) return;
+            std::cout << std::endl;
+            const double cycles = get("cycles");
+            const double instructions = get("instructions");
+            std::ostringstream os;
+            if (cycles > 0 && instructions >= 0) os << " IPC=" << instructions/cycles;
+            if (cycles > 0 && flops > 0)         os << " Flops/cycle=" << flops/cycles;
+            if (bytes > 0) {
+                const double kb = bytes/1024.0;
+                if (get("llc-misses") >= 0)  os << " LLC misses/KB=" << get("llc-misses")/kb;
+                if (get("l1d-misses") >= 0)  os << " L1D misses/KB=" << get("l1d-misses")/kb;
+                if (get("dtlb-misses") >= 0) os << " dTLB misses/KB=" << get("dtlb-misses")/kb;
+            }
+            if (!os.str().empty()) std::cout << "Derived:" << os.str() << std::endl;
+        }
+    };
+
+    // The work model of one iteration of a kernel: the flops it does and
+    // the bytes it must move to or from memory at least (compulsory
+    // traffic, ignoring write-allocate and capacity misses).
+    struct work_model {
+        double flops;
+        double bytes;
+        double intensity() const { return (bytes > 0) ? flops/bytes : 0.0; }
+    };
+
+    // Roofline ceilings of this machine: the bandwidth of an nstream triad
+    // and the rate of a multiply-add loop, both built with the flags of the
+    // kernel itself and run on as many threads as the kernel.  Off unless
+    // PRK_ROOFLINE is set, either to "default" (cache in $HOME/.prk_roofline)
+    // or to the name of the cache file.  The ceilings are measured once per
+    // hostname and thread count and appended to the cache; delete the file
+    // to measure again.  The triad needs 384 MB on top of the kernel.
+    // Problems that fit in cache can do better than 100% of the memory
+    // roofline.
+    class roofline {
+
+      private:
+
+        bool        enabled;
+        std::string filename;
+        std::string host;
+        int         nthread;   // thread count the ceilings below belong to
+        double      bandwidth; // bytes/s
+        double      peak;      // flops/s
+
+        static int threads() {
+#if defined(USE_OPENMP) && defined(_OPENMP)
+            return omp_get_max_threads();
+#else
+            return 1;
+#endif
+        }
+
+        // runs f(t) for t in [0,n) concurrently, on OpenMP threads in
+        // OpenMP builds and on std::threads otherwise
+        template <typename F>
+        static void team(int n, F f) {
+#if defined(USE_OPENMP) && defined(_OPENMP)
+            #pragma omp parallel num_threads(n)
+            f(omp_get_thread_num());
+#else
+            std::vector<std::thread> pool;
+            for (int t=1; t<n; t++) pool.emplace_back(f, t);
+            f(0);
+            for (auto & p : pool) p.join();
+#endif
+        }
+
+        static double measure_bandwidth(int n) {
+            const size_t length = size_t(1)<<24;
+            const double scalar = 3.0;
+            std::vector<double> A(length), B(length), C(length);
+            auto chunk = [=] (int id, size_t & lo, size_t & hi) {
+                lo = length*id/n;
+                hi = length*(id+1)/n;
+            };
+            team(n, [&] (int id) {
+                size_t lo, hi;
+                chunk(id, lo, hi);
+                for (size_t i=lo; i<hi; i++) {
+                    A[i] = 0.0; B[i] = 2.0; C[i] = 2.0;
+                }
+            });
+            double best = 0.0;
+            for (int trial=0; trial<=5; trial++) {
+                double t = wtime();
+                team(n, [&] (int id) {
+                    size_t lo, hi;
+                    chunk(id, lo, hi);
+                    for (size_t i=lo; i<hi; i++) {
+                        A[i] += B[i] + scalar * C[i];
+                    }
+                });
+                t = wtime() - t;
+                if (trial > 0) best = std::max(best, 4.0*length*sizeof(double)/t);
+            }
+            return best;
+        }
+
+        // N independent multiply-add chains per thread; which N saturates
+        // the FP pipes depends on the vector width and latency, so several
+        // are tried
+        template <int N>
+        static double measure_fma(int n) {
+            const long reps = (1L<<26)/N;
+            double best = 0.0;
+            std::vector<double> check(n, 0.0);
+            for (int trial=0; trial<3; trial++) {
+                double t = wtime();
+                team(n, [&] (int id) {
+                    double v[N];
+                    for (int k=0; k<N; k++) v[k] = static_cast<double>(k);
+                    for (long r=0; r<reps; r++) {
+                        PRAGMA_SIMD
+                        for (int k=0; k<N; k++) {
+                            v[k] = v[k] * 0.999999 + 1.e-6;
+                        }
+                    }
+                    for (int k=0; k<N; k++) check[id] += v[k];
+                });
+                t = wtime() - t;
+                best = std::max(best, 2.0*N*reps*n/t);
+            }
+            // keep the loop from being optimized away
+            if (prk::reduce(check.begin(), check.end(), 0.0) < 0.0) std::cout << check[0] << std::endl;
+            return best;
+        }
+
+        std::string key() const {
+            return host + " " + std::to_string(nthread);
+        }
+
+        bool load() {
+            std::ifstream in(filename);
+            std::string line;
+            while (std::getline(in, line)) {
+                if (line.empty() || line[0] == '#') continue;
+                std::istringstream is(line);
+                std::string h;
+                int n;
+                double bw, fl;
+                if ((is >> h >> n >> bw >> fl) && (h + " " + std::to_string(n)) == key()) {
+                    bandwidth = 1.e9*bw;
+                    peak      = 1.e9*fl;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void measure() {
+            bandwidth = measure_bandwidth(nthread);
+            peak = std::max({measure_fma<16>(nthread), measure_fma<32>(nthread), measure_fma<64>(nthread)});
+            std::ofstream out(filename, std::ios::app);
+            if (out) {
+                out << key() << " " << 1.e-9*bandwidth << " " << 1.e-9*peak << std::endl;
+            } else {
+                std::cout << "WARNING: cannot write roofline cache " << filename << std::endl;
+            }
+            std::cout << "Roofline ceilings measured for " << key() << " thread(s): "
+                      << 1.e-9*bandwidth << " GB/s, " << 1.e-9*peak << " GFlop/s" << std::endl;
+        }
+
+        roofline() : enabled(false), host("localhost"), nthread(0), bandwidth(0.0), peak(0.0) {
+            const char * env = std::getenv("PRK_ROOFLINE");
+            if (env == nullptr || *env == '\0') return;
+            enabled = true;
+            filename = std::string(env);
+            if (filename == "default" || filename == "1") {
+                const char * home = std::getenv("HOME");
+                filename = (home != nullptr) ? std::string(home) + "/.prk_roofline" : ".prk_roofline";
+            }
+#ifdef __linux__
+            char h[256] = "localhost";
+            gethostname(h, sizeof(h)-1);
+            host = std::string(h);
+#endif
+        }
+
+      public:
+
+        static roofline & instance() {
+            static roofline r;
+            return r;
+        }
+
+        // print how close one iteration of the given work in avgtime
+        // seconds comes to the roofline.  Drivers that run their own
+        // std::threads pass how many; the default is the OpenMP thread
+        // count, or one thread without OpenMP.
+        static void print(const work_model & w, double avgtime, int nthreads = 0) {
+            roofline & r = instance();
+            if (!r.enabled || avgtime <= 0.0) return;
+            // more threads than the machine runs at once see the same ceilings
+            const int hw = static_cast<int>(std::thread::hardware_concurrency());
+            int n = (nthreads > 0) ? nthreads : threads();
+            if (hw > 0) n = std::min(n, hw);
+            if (n != r.nthread) {
+                r.nthread = n;
+                if (!r.load()) r.measure();
+            }
+            const double tmem   = w.bytes/r.bandwidth;
+            const double tflops = w.flops/r.peak;
+            std::cout << "Roofline: intensity (flops/byte)=" << w.intensity()
+                      << " ceilings (GB/s, GFlop/s)=" << 1.e-9*r.bandwidth << ", " << 1.e-9*r.peak
+                      << " bound=" << ((tmem >= tflops) ? "memory" : "compute")
+                      << " percent of roofline=" << 100.0*std::max(tmem,tflops)/avgtime << std::endl;
+        }
+    };
+
+    // Cold-cache measurement.  The drivers time hot iterations, because
+    // iteration 0 warms the caches and the TLB.  With --cold on the command
+    // line, flush() evicts both before every iteration: it streams through
+    // a buffer of four times the last-level cache, which also touches far
+    // more pages than the TLB maps.  With --cold=flush it also evicts the
+    // operands themselves with clflush (x86 only; elsewhere only the stream).
+    // The time spent in flush() after start() is returned by elapsed(), for
+    // the driver to subtract from its timed region, and a counters object
+    // passed to flush() is paused around it.  A driver that supports it does
+    //
+    //     prk::cold::parse(argc, argv);       // first thing in main
+    //     ...
+    //     prk::cold::flush(counters, {A, B}); // before every iteration
+    //     if (iter==1) { t = wtime(); counters.start(); prk::cold::start(); }
+    //     ...
+    //     t = wtime() - t - prk::cold::elapsed();
+    class cold {
+
+      public:
+
+        struct operand {
+            const void * data;
+            size_t       bytes;
+            operand(const void * p, size_t b) : data(p), bytes(b) {}
+            template <typename C>
+            operand(const C & c) : data(c.data()), bytes(c.size()*sizeof(*c.data())) {}
+        };
+
+      private:
+
+        bool                  enabled;
+        bool                  clflush;
+        bool                  timing;
+        double                excluded;
+        size_t                llc;
+        std::vector<uint64_t> buffer;
+
+        cold() : enabled(false), clflush(false), timing(false), excluded(0.0), llc(0) {}
+
+        // the largest cache of cpu0, in bytes
+        static size_t cache_size() {
+            size_t largest = 0;
+#ifdef __linux__
+            for (int index=0; index<16; index++) {
+                std::ifstream in("/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/size");
+                if (!in) break;
+                size_t size = 0;
+                char unit = ' ';
+                if (!(in >> size)) continue;
+                in >> unit;
+                if (unit == 'K') size <<= 10;
+                if (unit == 'M') size <<= 20;
+                largest = std::max(largest, size);
+            }
+#endif
+            // assume a large server part when the size is unknown
+            return (largest > 0) ? largest : size_t(64)<<20;
+        }
+
+        void stream() {
+            const size_t words = buffer.size();
+            // one write per cache line, so every line is owned and the
+            // operands' dirty lines are written back
+#if defined(USE_OPENMP) && defined(_OPENMP)
+            #pragma omp parallel for
+#endif
+            for (size_t i=0; i<words; i+=8) {
+                buffer[i] += 1;
+            }
+        }
+
+        static void evict(const operand & o) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+            const char * p = static_cast<const char *>(o.data);
+            for (size_t b=0; b<o.bytes; b+=64) {
+                __builtin_ia32_clflush(p+b);
+            }
+            __builtin_ia32_mfence();
+#else
+            (void)o;
+#endif
+        }
+
+        static cold & instance() {
+            static cold c;
+            return c;
+        }
+
+      public:
+
+        // removes --cold and --cold=flush from the arguments, so that the
+        // positional arguments of the driver are unaffected
+        static void parse(int & argc, char * argv[]) {
+            cold & c = instance();
+            int k = 1;
+            for (int i=1; i<argc; i++) {
+                const std::string arg(argv[i]);
+                if (arg == "--cold") {
+                    c.enabled = true;
+                } else if (arg == "--cold=flush") {
+                    c.enabled = c.clflush = true;
+                } else if (arg.compare(0,6,"--cold") == 0) {
+                    throw "ERROR: cold-cache mode is --cold or --cold=flush";
+                } else {
+                    argv[k++] = argv[i];
+                }
+            }
+            argc = k;
+            argv[argc] = nullptr;
+            if (c.enabled) c.llc = cache_size();
+        }
+
+        static const char * mode() {
+            const cold & c = instance();
+            return !c.enabled ? "warm" : (c.clflush ? "cold+clflush" : "cold");
+        }
+
+        static void print() {
+            const cold & c = instance();
+            if (!c.enabled) return;
+            std::cout << "Cold caches          = stream " << (4*c.llc >> 20) << " MB"
+                      << (c.clflush ? " and clflush operands" : "") << " before each iteration" << std::endl;
+        }
+
+        // the timed region begins; flushes from now on are excluded from it
+        static void start() {
+            cold & c = instance();
+            c.timing = true;
+            c.excluded = 0.0;
+        }
+
+        static double elapsed() {
+            return instance().excluded;
+        }
+
+        static void flush(const std::vector<operand> & operands = {}) {
+            cold & c = instance();
+            if (!c.enabled) return;
+            const double t0 = wtime();
+            if (c.buffer.empty()) {
+                c.buffer.resize(4*c.llc/sizeof(uint64_t), 0);
+            }
+            if (c.clflush) {
+                for (auto & o : operands) evict(o);
+            }
+            c.stream();
+            if (c.timing) c.excluded += wtime() - t0;
+        }
+
+        static void flush(counters & k, const std::vector<operand> & operands = {}) {
+            cold & c = instance();
+            if (!c.enabled) return;
+            if (c.timing) k.stop();
+            flush(operands);
+            if (c.timing) k.start();
+        }
+    };
+
 } // namespace prk
 
 #endif /* PRK_UTIL_H */
@@ -0,0 +1,398 @@
+///
+/// Copyright (c) 2013, Intel Corporation
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions
+/// are met:
+///
+/// * Redistributions of source code must retain the above copyright
+///       notice, this list of conditions and the following disclaimer.
+/// * Redistributions in binary form must reproduce the above
+///       copyright notice, this list of conditions and the following
+///       disclaimer in the documentation and/or other materials provided
+///       with the distribution.
+/// * Neither the name of Intel Corporation nor the names of its
+///       contributors may be used to endorse or promote products
+///       derived from this software without specific prior written
+///       permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+/// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+/// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+/// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+/// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+/// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+/// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+/// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+/// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+/// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+
+//////////////////////////////////////////////////////////////////////
+///
+/// NAME:    RandomAccess
+///
+/// PURPOSE: This program tests the efficiency of the memory subsystem to
+///          update elements of an array with irregular stride.
+///
+/// USAGE:   The program takes as input the number of threads, the 2log
+///          of the size of the table that gets updated, the ratio of number
+///          of updates over table size, and the vector length of
+///          simultaneously updatable table elements (independent streams).
+///
+///          <progname> <# threads> <log2 tablesize> <#update ratio>
+///                     <vector length> [<mode> <bucket size>]
+///
+///          The update Table[ran & (tablesize-1)] ^= ran is applied in
+///          one or all of the following modes:
+///          scalar - one thread runs all the streams, as in SERIAL/Random.
+///          atomic - the streams are divided among the threads, which share
+///                   the table and update it with atomic XOR.
+///          bucket - each thread owns a contiguous region of the table.
+///                   Threads generate up to <bucket size> updates, sort
+///                   them into one bucket per owner, and after a barrier
+///                   each owner applies the updates destined for it, so
+///                   no update is atomic and none conflicts.
+///          all    - run the three modes in turn (default).
+///
+///          The output consists of diagnostics to make sure the
+///          algorithm worked, and of timing statistics per mode.
+///
+/// FUNCTIONS CALLED:
+///
+///          Other than standard C functions, the following functions are used in
+///          this program:
+///          wtime()
+///          PRK_starts()
+///
+/// NOTES:   This program is derived from HPC Challenge Random Access.  See
+///          OPENMP/Random/random.c for the differences with the HPCC version.
+///          The timed code applies the operator twice, starting from the same
+///          seeds, so that every table element returns to its initial value.
+///          Because XOR is commutative, the order in which updates are
+///          applied does not matter, and all modes verify exactly.
+///
+/// HISTORY: Written by Rob Van der Wijngaart, June 2006.
+///          Shared table version derived from random.c by Michael Frumkin, October 2006
+///          C++11-ification with std::thread and std::atomic, 2018.
+///
+//////////////////////////////////////////////////////////////////////
+
+#include "prk_util.h"
+#include "prk_barrier.h"
+#include "prk_affinity.h"
+
+#include <memory>
+#include <thread>
+
+// PERIOD = (2^63-1)/7 = 7*73*127*337*92737*649657
+#define POLY    0x0000000000000007ULL
+#define PERIOD  1317624576693539401LL
+// sequence number in stream of random numbers to be used as initial value
+#define SEQSEED 834568137686317453LL
+
+static inline uint64_t next_ran(uint64_t ran)
+{
+    return (ran << 1) ^ (static_cast<int64_t>(ran) < 0 ? POLY : 0);
+}
+
+// start random number generator at nth step
+uint64_t PRK_starts(int64_t n)
+{
+    uint64_t m2[64];
+
+    while (n < 0) n += PERIOD;
+    while (n > PERIOD) n -= PERIOD;
+    if (n == 0) return 0x1;
+
+    uint64_t temp = 0x1;
+    for (int i=0; i<64; i++) {
+        m2[i] = temp;
+        temp = next_ran(temp);
+        temp = next_ran(temp);
+    }
+
+    int i;
+    for (i=62; i>=0; i--) {
+        if ((n >> i) & 1) break;
+    }
+
+    uint64_t ran = 0x2;
+    while (i > 0) {
+        temp = 0;
+        for (int j=0; j<64; j++) {
+            if (static_cast<unsigned>((ran >> j) & 1)) temp ^= m2[j];
+        }
+        ran = temp;
+        i -= 1;
+        if ((n >> i) & 1) ran = next_ran(ran);
+    }
+    return ran;
+}
+
+int main(int argc, char * argv[])
+{
+  std::cout << "Parallel Research Kernels version " << PRKVERSION << std::endl;
+  std::cout << "C++11/Threads Random Access test" << std::endl;
+
+  //////////////////////////////////////////////////////////////////////
+  // Read and test input parameters
+  //////////////////////////////////////////////////////////////////////
+
+  int nthread;
+  int log2tablesize;
+  int64_t update_ratio;
+  int64_t nstarts;
+  std::string mode("all");
+  int64_t bucket_size;
+  int64_t tablesize;
+  int64_t nupdate;
+  prk::affinity affinity;
+  try {
+      if (argc < 5) {
+        throw "Usage: <# threads> <log2 tablesize> <#update ratio> <vector length> "
+              "[<scalar/atomic/bucket/all> <bucket size>]";
+      }
+
+      nthread = std::atoi(argv[1]);
+      if (nthread < 1) {
+        throw "ERROR: number of threads must be positive";
+      }
+
+      log2tablesize = std::atoi(argv[2]);
+      if (log2tablesize < 1) {
+        throw "ERROR: log2 tablesize must be >= 1";
+      } else if (log2tablesize > 62) {
+        throw "ERROR: requested table size too large; reduce log2 tablesize";
+      }
+      tablesize = INT64_C(1) << log2tablesize;
+
+      update_ratio = std::atol(argv[3]);
+      if (update_ratio < 1) {
+        throw "ERROR: update ratio must be positive";
+      }
+
+      nstarts = std::atol(argv[4]);
+      if (nstarts < 1) {
+        throw "ERROR: vector length must be positive";
+      }
+
+      if (nstarts % nthread) {
+        throw "ERROR: vector length must be divisible by # threads";
+      }
+      if (update_ratio % nstarts) {
+        throw "ERROR: update ratio must be divisible by vector length";
+      }
+      if (nthread > tablesize) {
+        throw "ERROR: table must have at least one element per thread";
+      }
+
+      nupdate = update_ratio * tablesize;
+      if (nupdate / tablesize != update_ratio) {
+        throw "ERROR: requested number of updates too large; reduce log2 tablesize or update ratio";
+      }
+
+      if (argc > 5) {
+        mode = std::string(argv[5]);
+        if (mode != "scalar" && mode != "atomic" && mode != "bucket" && mode != "all") {
+          throw "ERROR: mode must be one of scalar, atomic, bucket or all";
+        }
+      }
+
+      bucket_size = (argc > 6) ? std::atol(argv[6]) : 8192;
+      if (bucket_size < 1) {
+        throw "ERROR: bucket size must be positive";
+      }
+
+      affinity = prk::get_affinity();
+  }
+  catch (const char * e) {
+    std::cout << e << std::endl;
+    return 1;
+  }
+
+  std::cout << "Number of threads      = " << nthread << std::endl;
+  affinity.print(nthread);
+  std::cout << "Table size (shared)    = " << tablesize << std::endl;
+  std::cout << "Update ratio           = " << update_ratio << std::endl;
+  std::cout << "Number of updates      = " << nupdate << std::endl;
+  std::cout << "Vector length          = " << nstarts << std::endl;
+  std::cout << "Mode                   = " << mode << std::endl;
+  std::cout << "Bucket size            = " << bucket_size << std::endl;
+
+  //////////////////////////////////////////////////////////////////////
+  // Allocate space and perform the computation
+  //////////////////////////////////////////////////////////////////////
+
+  // because we do two rounds, each stream does half its updates per round
+  const int64_t nsteps = nupdate/(nstarts*2);
+  const int64_t my_starts = nstarts/nthread;
+  const uint64_t mask = tablesize-1;
+
+  // the atomic mode has a table of its own, so each table is only
+  // allocated when a mode that uses it runs
+  std::vector<uint64_t> Table((mode == "atomic") ? 0 : tablesize);
+
+  auto verify = [&] (const std::string & name, int64_t error) {
+      if (error) {
+        std::cout << "ERROR: " << name << " number of incorrect table elements = " << error << std::endl;
+      }
+      return (error == 0);
+  };
+
+  std::vector<std::thread> pool;
+  bool validate = true;
+
+  if (mode == "scalar" || mode == "all") {
+
+    for (int64_t i=0; i<tablesize; i++) Table[i] = i;
+
+    auto random_time = prk::wtime();
+    {
+      std::vector<uint64_t> ran(nstarts);
+      for (int round=0; round<2; round++) {
+        for (int64_t j=0; j<nstarts; j++) {
+          ran[j] = PRK_starts(SEQSEED+(nupdate/nstarts)*j);
+        }
+        for (int64_t j=0; j<nstarts; j++) {
+          for (int64_t i=0; i<nsteps; i++) {
+            ran[j] = next_ran(ran[j]);
+            Table[ran[j] & mask] ^= ran[j];
+          }
+        }
+      }
+    }
+    random_time = prk::wtime() - random_time;
+
+    int64_t error = 0;
+    for (int64_t i=0; i<tablesize; i++) {
+      if (Table[i] != static_cast<uint64_t>(i)) error++;
+    }
+    if (verify("scalar", error)) {
+      std::cout << "Rate (GUPs/s) scalar: " << 1.e-9*nupdate/random_time
+                << " Time (s): " << random_time << std::endl;
+    } else {
+      validate = false;
+    }
+  }
+
+  if (mode == "atomic" || mode == "all") {
+
+    std::unique_ptr<std::atomic<uint64_t>[]> ATable(new std::atomic<uint64_t>[tablesize]);
+    for (int64_t i=0; i<tablesize; i++) ATable[i].store(i, std::memory_order_relaxed);
+
+    auto random_time = prk::wtime();
+    for (int t=0; t<nthread; t++) {
+      pool.push_back(std::thread([=,&ATable,&affinity] {
+        affinity.pin(t);
+        std::vector<uint64_t> ran(my_starts);
+        const int64_t offset = t*my_starts;
+        for (int round=0; round<2; round++) {
+          for (int64_t j=0; j<my_starts; j++) {
+            ran[j] = PRK_starts(SEQSEED+(nupdate/nstarts)*(j+offset));
+          }
+          for (int64_t j=0; j<my_starts; j++) {
+            for (int64_t i=0; i<nsteps; i++) {
+              ran[j] = next_ran(ran[j]);
+              ATable[ran[j] & mask].fetch_xor(ran[j], std::memory_order_relaxed);
+            }
+          }
+        }
+      }));
+    }
+    std::for_each(pool.begin(), pool.end(), [](std::thread & t) { t.join(); });
+    pool.clear();
+    random_time = prk::wtime() - random_time;
+
+    int64_t error = 0;
+    for (int64_t i=0; i<tablesize; i++) {
+      if (ATable[i].load(std::memory_order_relaxed) != static_cast<uint64_t>(i)) error++;
+    }
+    if (verify("atomic", error)) {
+      std::cout << "Rate (GUPs/s) atomic: " << 1.e-9*nupdate/random_time
+                << " Time (s): " << random_time << std::endl;
+    } else {
+      validate = false;
+    }
+  }
+
+  if (mode == "bucket" || mode == "all") {
+
+    for (int64_t i=0; i<tablesize; i++) Table[i] = i;
+
+    // table region owned by each thread
+    const int64_t chunk = prk::divceil(tablesize,nthread);
+    // number of steps each stream takes per bucketing phase
+    const int64_t batch = std::max(INT64_C(1), bucket_size/my_starts);
+
+    // buckets[src][dst] holds updates generated by src for the region of dst
+    std::vector<std::vector<std::vector<uint64_t>>> buckets(nthread);
+    for (auto & b : buckets) {
+      b.resize(nthread);
+      for (auto & v : b) v.reserve(batch*my_starts/nthread+1);
+    }
+
+    prk::central_barrier barrier(nthread);
+
+    auto random_time = prk::wtime();
+    for (int t=0; t<nthread; t++) {
+      pool.push_back(std::thread([=,&Table,&buckets,&barrier,&affinity] {
+        affinity.pin(t);
+        std::vector<uint64_t> ran(my_starts);
+        auto & mine = buckets[t];
+        const int64_t offset = t*my_starts;
+        for (int round=0; round<2; round++) {
+          for (int64_t j=0; j<my_starts; j++) {
+            ran[j] = PRK_starts(SEQSEED+(nupdate/nstarts)*(j+offset));
+          }
+          for (int64_t step=0; step<nsteps; step+=batch) {
+            const int64_t last = std::min(nsteps,step+batch);
+            // generate and sort by owner
+            for (int64_t j=0; j<my_starts; j++) {
+              for (int64_t i=step; i<last; i++) {
+                ran[j] = next_ran(ran[j]);
+                mine[(ran[j] & mask)/chunk].push_back(ran[j]);
+              }
+            }
+            barrier.wait(t);
+            // apply the updates that fall in my region
+            for (int src=0; src<nthread; src++) {
+              for (auto r : buckets[src][t]) {
+                Table[r & mask] ^= r;
+              }
+            }
+            barrier.wait(t);
+            for (auto & v : mine) v.clear();
+          }
+        }
+      }));
+    }
+    std::for_each(pool.begin(), pool.end(), [](std::thread & t) { t.join(); });
+    pool.clear();
+    random_time = prk::wtime() - random_time;
+
+    int64_t error = 0;
+    for (int64_t i=0; i<tablesize; i++) {
+      if (Table[i] != static_cast<uint64_t>(i)) error++;
+    }
+    if (verify("bucket", error)) {
+      std::cout << "Rate (GUPs/s) bucket: " << 1.e-9*nupdate/random_time
+                << " Time (s): " << random_time << std::endl;
+    } else {
+      validate = false;
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////
+  /// Analyze and output results
+  //////////////////////////////////////////////////////////////////////
+
+  if (!validate) {
+    std::cout << "Solution does not validate" << std::endl;
+    return 1;
+  }
+  std::cout << "Solution validates" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,335 @@
+///
+/// Copyright (c) 2013, Intel Corporation
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions
+/// are met:
+///
+/// * Redistributions of source code must retain the above copyright
+///       notice, this list of conditions and the following disclaimer.
+/// * Redistributions in binary form must reproduce the above
+///       copyright notice, this list of conditions and the following
+///       disclaimer in the documentation and/or other materials provided
+///       with the distribution.
+/// * Neither the name of Intel Corporation nor the names of its
+///       contributors may be used to endorse or promote products
+///       derived from this software without specific prior written
+///       permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+/// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+/// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+/// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+/// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+/// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+/// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+/// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+/// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+/// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+
+//////////////////////////////////////////////////////////////////////
+///
+/// NAME:    reduce
+///
+/// PURPOSE: This program tests the efficiency with which a collection of
+///          vectors that are distributed among the threads can be added in
+///          elementwise fashion. The number of vectors per thread is two,
+///          so that a reduction will take place even if the code runs on
+///          just a single thread.
+///
+/// USAGE:   The program takes as input the number of threads, the number
+///          of times the reduction is repeated, the length of the vectors,
+///          plus, optionally, the reduction algorithm:
+///
+///          <progname> <# threads> <# iterations> <vector length> [<algorithm>]
+///
+///          flat           - thread 0 adds the vectors of all other threads.
+///          binary-p2p     - binary tree; each pair of threads synchronizes
+///                           through a flag instead of a barrier.
+///          reduce-scatter - ring reduce-scatter in nthread-1 stages,
+///                           followed by an allgather, so that every
+///                           thread ends up with the full result.
+///          all            - run the three algorithms in turn (default).
+///
+///          The output consists of diagnostics to make sure the
+///          algorithm worked, and of timing statistics per algorithm.
+///
+/// FUNCTIONS CALLED:
+///
+///          Other than standard C functions, the following functions are used in
+///          this program:
+///          wtime()
+///
+/// NOTES:   The reduce-scatter algorithm is the first phase of the
+///          long-optimal algorithm of OPENMP/Reduce, which is based on
+///          Collective Communication; Theory, Practice, and Experience by
+///          Chan, Heimlich, Purkayastha, Van de Geijn.
+///          Each thread's vector pair starts on its own cache line and the
+///          synchronization flags are padded to a cache line, so that the
+///          partial sums do not suffer from false sharing.
+///
+/// HISTORY: Written by Rob Van der Wijngaart, March 2006.
+///          C++11-ification with std::thread and std::atomic, 2018.
+///
+//////////////////////////////////////////////////////////////////////
+
+#include "prk_util.h"
+#include "prk_barrier.h"
+#include "prk_affinity.h"
+
+#include <memory>
+#include <thread>
+
+// bytes per cache line, used for padding
+#define CACHELINE 64
+
+int main(int argc, char * argv[])
+{
+  std::cout << "Parallel Research Kernels version " << PRKVERSION << std::endl;
+  std::cout << "C++11/Threads Vector Reduction" << std::endl;
+
+  //////////////////////////////////////////////////////////////////////
+  // Read and test input parameters
+  //////////////////////////////////////////////////////////////////////
+
+  int nthread;
+  int iterations;
+  size_t vector_length;
+  std::string algorithm("all");
+  prk::affinity affinity;
+  try {
+      if (argc < 4) {
+        throw "Usage: <# threads> <# iterations> <vector length> "
+              "[<flat/binary-p2p/reduce-scatter/all>]";
+      }
+
+      nthread = std::atoi(argv[1]);
+      if (nthread < 1) {
+        throw "ERROR: number of threads must be positive";
+      }
+
+      iterations = std::atoi(argv[2]);
+      if (iterations < 1) {
+        throw "ERROR: iterations must be >= 1";
+      }
+
+      if (std::atol(argv[3]) < 1) {
+        throw "ERROR: vector length must be >= 1";
+      }
+      vector_length = std::atol(argv[3]);
+
+      if (argc > 4) {
+        algorithm = std::string(argv[4]);
+        if (algorithm != "flat" && algorithm != "binary-p2p" &&
+            algorithm != "reduce-scatter" && algorithm != "all") {
+          throw "ERROR: algorithm must be one of flat, binary-p2p, reduce-scatter or all";
+        }
+      }
+
+      affinity = prk::get_affinity();
+  }
+  catch (const char * e) {
+    std::cout << e << std::endl;
+    return 1;
+  }
+
+  std::cout << "Number of threads              = " << nthread << std::endl;
+  affinity.print(nthread);
+  std::cout << "Vector length                  = " << vector_length << std::endl;
+  std::cout << "Reduction algorithm            = " << algorithm << std::endl;
+  std::cout << "Number of iterations           = " << iterations << std::endl;
+
+  //////////////////////////////////////////////////////////////////////
+  // Allocate space and perform the computation
+  //////////////////////////////////////////////////////////////////////
+
+  // pad every vector to a whole number of cache lines and align the base
+  const size_t linewords = CACHELINE/sizeof(double);
+  const size_t stride = prk::divceil(vector_length,linewords) * linewords;
+  std::vector<double> storage(2*nthread*stride + linewords);
+  void * base = storage.data();
+  size_t space = storage.size()*sizeof(double);
+  base = std::align(CACHELINE, 2*nthread*stride*sizeof(double), base, space);
+  double * const vector = static_cast<double*>(base);
+
+  auto vec0 = [=] (int id) { return vector + id*stride; };
+  auto vec1 = [=] (int id) { return vector + (id+nthread)*stride; };
+
+  // one flag per cache line
+  const int flagwords = CACHELINE/sizeof(std::atomic<int>);
+  std::unique_ptr<std::atomic<int>[]> flag(new std::atomic<int>[nthread*flagwords]);
+
+  // segments of the vectors for the reduce-scatter algorithm
+  const size_t segment_size = prk::divceil(vector_length,nthread);
+  auto seg_start = [=] (int id) { return std::min(vector_length, segment_size*id); };
+  auto seg_end   = [=] (int id) { return std::min(vector_length, segment_size*(id+1)); };
+
+  const double element_value = static_cast<double>(nthread)*(2.0*static_cast<double>(nthread)+1.0);
+  const double epsilon = 1.e-8;
+
+  std::vector<std::string> algorithms;
+  if (algorithm == "all") {
+    algorithms = {"flat", "binary-p2p", "reduce-scatter"};
+  } else {
+    algorithms.push_back(algorithm);
+  }
+
+  bool validate = true;
+
+  for (auto & alg : algorithms) {
+
+    for (int id=0; id<nthread; id++) {
+      flag[id*flagwords].store(0, std::memory_order_relaxed);
+    }
+
+    prk::central_barrier barrier(nthread);
+    double reduce_time = 0.0;
+
+    std::vector<std::thread> pool;
+    for (int my_ID=0; my_ID<nthread; my_ID++) {
+      pool.push_back(std::thread([=,&barrier,&flag,&reduce_time,&affinity] {
+
+        affinity.pin(my_ID);
+        double * const mine0 = vec0(my_ID);
+        double * const mine1 = vec1(my_ID);
+
+        for (int iter=0; iter<=iterations; iter++) {
+
+          // make sure no thread still reads my vector from the previous
+          // iteration before I reinitialize it
+          barrier.wait(my_ID);
+
+          // start timer after a warmup iteration
+          if (iter==1 && my_ID==0) reduce_time = prk::wtime();
+
+          // initialize the arrays, assuming first-touch memory placement
+          for (size_t i=0; i<vector_length; i++) {
+            mine0[i] = static_cast<double>(my_ID+1);
+            mine1[i] = static_cast<double>(my_ID+1+nthread);
+          }
+
+          // first do the "local" part, which is the same for all algorithms
+          PRAGMA_SIMD
+          for (size_t i=0; i<vector_length; i++) {
+            mine0[i] += mine1[i];
+          }
+
+          if (nthread == 1) continue;
+
+          // now do the "non-local" part
+          if (alg == "flat") {
+
+            barrier.wait(my_ID);
+            if (my_ID == 0) {
+              for (int id=1; id<nthread; id++) {
+                const double * const other = vec0(id);
+                PRAGMA_SIMD
+                for (size_t i=0; i<vector_length; i++) {
+                  mine0[i] += other[i];
+                }
+              }
+            }
+
+          } else if (alg == "binary-p2p") {
+
+            // flags count iterations, so they never need to be reset
+            const int epoch = iter+1;
+            int group_size = nthread;
+            while (group_size > 1) {
+              const int old_size = group_size;
+              group_size = (group_size+1)/2;
+              if (my_ID < group_size && my_ID+group_size < old_size) {
+                // wait for the donor of the pair to complete its subresult
+                auto & f = flag[(my_ID+group_size)*flagwords];
+                while (f.load(std::memory_order_acquire) < epoch) {
+                  std::this_thread::yield();
+                }
+                const double * const other = vec0(my_ID+group_size);
+                PRAGMA_SIMD
+                for (size_t i=0; i<vector_length; i++) {
+                  mine0[i] += other[i];
+                }
+              } else if (my_ID < old_size) {
+                // I am a producer of data in this round
+                flag[my_ID*flagwords].store(epoch, std::memory_order_release);
+              }
+            }
+
+          } else if (alg == "reduce-scatter") {
+
+            // bucket reduce-scatter in nthread-1 stages
+            const int my_donor = (my_ID-1+nthread)%nthread;
+            const double * const donor = vec0(my_donor);
+            for (int stage=1; stage<nthread; stage++) {
+              barrier.wait(my_ID);
+              const int my_segment = (my_ID-stage+nthread)%nthread;
+              const size_t start = seg_start(my_segment);
+              const size_t end   = seg_end(my_segment);
+              PRAGMA_SIMD
+              for (size_t i=start; i<end; i++) {
+                mine0[i] += donor[i];
+              }
+            }
+            // allgather: thread id owns the complete segment (id+1)%nthread,
+            // and only writes the segments it does not own
+            barrier.wait(my_ID);
+            for (int id=0; id<nthread; id++) {
+              if (id == my_ID) continue;
+              const int segment = (id+1)%nthread;
+              const double * const other = vec0(id);
+              std::copy(other+seg_start(segment), other+seg_end(segment), mine0+seg_start(segment));
+            }
+          }
+        }
+
+        barrier.wait(my_ID);
+        if (my_ID==0) reduce_time = prk::wtime() - reduce_time;
+      }));
+    }
+    std::for_each(pool.begin(), pool.end(), [](std::thread & t) { t.join(); });
+
+    //////////////////////////////////////////////////////////////////////
+    /// Analyze and output results
+    //////////////////////////////////////////////////////////////////////
+
+    // with allgather every thread holds the result, otherwise only thread 0
+    const int nresult = (alg == "reduce-scatter") ? nthread : 1;
+    bool ok = true;
+    for (int id=0; id<nresult && ok; id++) {
+      for (size_t i=0; i<vector_length; i++) {
+        if (std::fabs(vec0(id)[i] - element_value) >= epsilon) {
+          std::cout << "ERROR: " << alg << " first error at thread " << id << " i=" << i
+                    << "; value: " << vec0(id)[i] << "; reference value: " << element_value << std::endl;
+          ok = false;
+          break;
+        }
+      }
+    }
+
+    if (ok) {
+      auto avgtime = reduce_time/iterations;
+      std::cout << "Rate (MFlops/s) " << alg << ": "
+                << 1.0e-6 * (2.0*nthread-1.0)*vector_length/avgtime
+                << " Avg time (s): " << avgtime << std::endl;
+      // the two vectors of every thread are read, and each result written
+      const prk::work_model work{(2.0*nthread-1.0)*vector_length,
+                                 (2.0*nthread+nresult)*vector_length*sizeof(double)};
+      prk::roofline::print(work, avgtime, nthread);
+    } else {
+      validate = false;
+    }
+  }
+
+  if (!validate) {
+    std::cout << "Solution does not validate" << std::endl;
+    return 1;
+  }
+  std::cout << "Solution validates" << std::endl;
+#ifdef VERBOSE
+  std::cout << "Element verification value: " << element_value << std::endl;
+#endif
+
+  return 0;
+}
@@ -0,0 +1,415 @@
+///
+/// Copyright (c) 2015, Intel Corporation
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions
+/// are met:
+///
+/// * Redistributions of source code must retain the above copyright
+///       notice, this list of conditions and the following disclaimer.
+/// * Redistributions in binary form must reproduce the above
+///       copyright notice, this list of conditions and the following
+///       disclaimer in the documentation and/or other materials provided
+///       with the distribution.
+/// * Neither the name of Intel Corporation nor the names of its
+///       contributors may be used to endorse or promote products
+///       derived from this software without specific prior written
+///       permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+/// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+/// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+/// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+/// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+/// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+/// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+/// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+/// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+/// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+
+//////////////////////////////////////////////////////////////////////
+///
+/// NAME:    RefCount
+///
+/// PURPOSE: This program tests the efficiency of exclusive access to a
+///          pair of non-adjacent reference counters.
+///
+/// USAGE:   The program takes as input the maximum number of threads, the
+///          total number of times the reference counters are updated, the
+///          length of the private triad vector that each thread updates
+///          between two counter updates, and optionally the type of mutual
+///          exclusion:
+///
+///          <progname> <# threads> <# counter pair updates>
+///                     <length of private triad vector> [<mode>]
+///
+///          mutex    - std::mutex guards the pair.
+///          spinlock - test-and-test-and-set lock that yields while spinning.
+///          ticket   - FIFO ticket lock.
+///          atomic   - each counter is a std::atomic<double> updated with a
+///                     compare-and-swap loop (no lock; the pair is not
+///                     updated as a unit, like LOCK=1 in OPENMP/Refcount).
+///          sharded  - every thread updates its own padded copy of the pair,
+///                     and the copies are summed when the counters are read.
+///          all      - run all of the above in turn (default).
+///
+///          The updates are divided among 1, 2, 4, ... threads up to the
+///          maximum, and the update rate is reported for each thread count.
+///
+///          The output consists of diagnostics to make sure the
+///          algorithm worked, and of timing statistics.
+///
+/// FUNCTIONS CALLED:
+///
+///          Other than standard C functions, the following functions are used in
+///          this program:
+///          wtime()
+///          private_stream()
+///
+/// HISTORY: Written by Rob Van der Wijngaart, January 2006.
+///          Updated by RvdW to include private work, and a dependence
+///          between update pairs, October 2015
+///          C++11-ification with std::thread and std::atomic, 2018.
+///
+//////////////////////////////////////////////////////////////////////
+
+#include "prk_util.h"
+#include "prk_affinity.h"
+
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <unistd.h>
+
+#define SCALAR 3.0
+#define A0     0.0
+#define B0     2.0
+#define C0     2.0
+
+// bytes per cache line, used for padding
+#define CACHELINE 64
+
+// do some work that does not touch the counters
+void private_stream(double * a, const double * b, const double * c, size_t size)
+{
+    PRAGMA_SIMD
+    for (size_t j=0; j<size; j++) a[j] += b[j] + SCALAR*c[j];
+}
+
+// test-and-test-and-set lock
+class spinlock {
+
+  private:
+
+    std::atomic<bool> locked;
+
+  public:
+
+    spinlock() : locked(false) {}
+
+    void lock() {
+        while (locked.exchange(true, std::memory_order_acquire)) {
+            while (locked.load(std::memory_order_relaxed)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void unlock() {
+        locked.store(false, std::memory_order_release);
+    }
+};
+
+// first-come first-served ticket lock
+class ticketlock {
+
+  private:
+
+    std::atomic<uint64_t> next_ticket;
+    char pad[CACHELINE-sizeof(std::atomic<uint64_t>)];
+    std::atomic<uint64_t> now_serving;
+
+  public:
+
+    ticketlock() : next_ticket(0), now_serving(0) {}
+
+    void lock() {
+        const uint64_t my_ticket = next_ticket.fetch_add(1, std::memory_order_relaxed);
+        while (now_serving.load(std::memory_order_acquire) != my_ticket) {
+            std::this_thread::yield();
+        }
+    }
+
+    void unlock() {
+        now_serving.store(now_serving.load(std::memory_order_relaxed)+1, std::memory_order_release);
+    }
+};
+
+static inline void atomic_increment(std::atomic<double> & x)
+{
+    double old = x.load(std::memory_order_relaxed);
+    while (!x.compare_exchange_weak(old, old+1.0, std::memory_order_relaxed)) {}
+}
+
+enum class update_mode { mutex, spinlock, ticket, atomic, sharded };
+
+static const char * mode_name(update_mode m)
+{
+    switch (m) {
+        case update_mode::mutex:    return "mutex";
+        case update_mode::spinlock: return "spinlock";
+        case update_mode::ticket:   return "ticket";
+        case update_mode::atomic:   return "atomic";
+        case update_mode::sharded:  return "sharded";
+    }
+    return "unknown";
+}
+
+int main(int argc, char * argv[])
+{
+  std::cout << "Parallel Research Kernels version " << PRKVERSION << std::endl;
+  std::cout << "C++11/Threads exclusive access test RefCount, shared counters" << std::endl;
+
+  //////////////////////////////////////////////////////////////////////
+  // Read and test input parameters
+  //////////////////////////////////////////////////////////////////////
+
+  int max_threads;
+  size_t iterations;
+  size_t stream_size;
+  std::string mode("all");
+  prk::affinity affinity;
+  try {
+      if (argc < 4) {
+        throw "Usage: <# threads> <# counter pair updates> <private stream size> "
+              "[<mutex/spinlock/ticket/atomic/sharded/all>]";
+      }
+
+      max_threads = std::atoi(argv[1]);
+      if (max_threads < 1) {
+        throw "ERROR: number of threads must be positive";
+      }
+
+      if (std::atol(argv[2]) < 1) {
+        throw "ERROR: iterations must be >= 1";
+      }
+      iterations = std::atol(argv[2]);
+
+      if (std::atol(argv[3]) < 0) {
+        throw "ERROR: private stream size must be non-negative";
+      }
+      stream_size = std::atol(argv[3]);
+
+      if (argc > 4) {
+        mode = std::string(argv[4]);
+        if (mode != "mutex" && mode != "spinlock" && mode != "ticket" &&
+            mode != "atomic" && mode != "sharded" && mode != "all") {
+          throw "ERROR: mode must be one of mutex, spinlock, ticket, atomic, sharded or all";
+        }
+      }
+
+      affinity = prk::get_affinity();
+  }
+  catch (const char * e) {
+    std::cout << e << std::endl;
+    return 1;
+  }
+
+  std::cout << "Number of threads (max)        = " << max_threads << std::endl;
+  affinity.print(max_threads);
+  std::cout << "Number of counter pair updates = " << iterations << std::endl;
+  std::cout << "Length of private stream       = " << stream_size << std::endl;
+  std::cout << "Mutex type                     = " << mode << std::endl;
+
+  //////////////////////////////////////////////////////////////////////
+  // Allocate space and perform the computation
+  //////////////////////////////////////////////////////////////////////
+
+  // put the two counters on different pages
+  const size_t pagewords = sysconf(_SC_PAGESIZE)/sizeof(double);
+  std::vector<double> counter_space(pagewords+1);
+  double & counter1 = counter_space[0];
+  double & counter2 = counter_space[pagewords];
+
+  std::unique_ptr<std::atomic<double>[]> atomic_space(new std::atomic<double>[pagewords+1]);
+  std::atomic<double> & acounter1 = atomic_space[0];
+  std::atomic<double> & acounter2 = atomic_space[pagewords];
+
+  // one pair of shards per cache line and thread
+  const size_t shardwords = CACHELINE/sizeof(double);
+  std::vector<double> shard_space((max_threads+1)*shardwords);
+  void * shard_base = shard_space.data();
+  size_t shard_bytes = shard_space.size()*sizeof(double);
+  double * const shards = static_cast<double*>(std::align(CACHELINE, max_threads*CACHELINE,
+                                                           shard_base, shard_bytes));
+
+  std::mutex mutex;
+  spinlock spin;
+  ticketlock ticket;
+
+  // resolved here, so that the threads do not compare strings per update
+  std::vector<update_mode> modes;
+  for (auto m : {update_mode::mutex, update_mode::spinlock, update_mode::ticket,
+                 update_mode::atomic, update_mode::sharded}) {
+    if (mode == "all" || mode == mode_name(m)) modes.push_back(m);
+  }
+
+  std::vector<int> thread_counts;
+  for (int t=1; t<max_threads; t*=2) thread_counts.push_back(t);
+  thread_counts.push_back(max_threads);
+
+  const double epsilon = 1.e-7;
+  bool validate = true;
+
+  for (auto m : modes) {
+    for (auto nthread : thread_counts) {
+
+      counter1 = 1.0;
+      counter2 = 0.0;
+      acounter1.store(1.0);
+      acounter2.store(0.0);
+      for (int t=0; t<max_threads; t++) {
+        shards[t*shardwords]   = 0.0;
+        shards[t*shardwords+1] = 0.0;
+      }
+
+      std::atomic<int> ready(0);
+      std::atomic<bool> go(false);
+      std::atomic<int> errors(0);
+
+      std::vector<std::thread> pool;
+      for (int my_ID=0; my_ID<nthread; my_ID++) {
+        pool.push_back(std::thread([=,&ready,&go,&errors,&counter1,&counter2,
+                                    &acounter1,&acounter2,&mutex,&spin,&ticket,&affinity] {
+
+          affinity.pin(my_ID);
+
+          // my share of the updates
+          const size_t first = (iterations*my_ID)/nthread;
+          const size_t last  = (iterations*(my_ID+1))/nthread;
+
+          std::vector<double> a(stream_size,A0);
+          std::vector<double> b(stream_size,B0);
+          std::vector<double> c(stream_size,C0);
+
+          double * const shard = shards + my_ID*shardwords;
+
+          ready++;
+          while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+
+          // one instance of the loop per mode, so the update is inlined
+          auto updates = [&] (auto update) {
+            for (size_t iter=first; iter<last; iter++) {
+              update();
+              // give each thread some (overlappable) work to do
+              private_stream(a.data(), b.data(), c.data(), stream_size);
+            }
+          };
+
+          switch (m) {
+            case update_mode::mutex:
+              updates([&] {
+                std::lock_guard<std::mutex> guard(mutex);
+                counter1++;
+                counter2++;
+              });
+              break;
+            case update_mode::spinlock:
+              updates([&] {
+                std::lock_guard<spinlock> guard(spin);
+                counter1++;
+                counter2++;
+              });
+              break;
+            case update_mode::ticket:
+              updates([&] {
+                std::lock_guard<ticketlock> guard(ticket);
+                counter1++;
+                counter2++;
+              });
+              break;
+            case update_mode::atomic:
+              updates([&] {
+                atomic_increment(acounter1);
+                atomic_increment(acounter2);
+              });
+              break;
+            case update_mode::sharded:
+              updates([&] {
+                shard[0]++;
+                shard[1]++;
+              });
+              break;
+          }
+
+          // check whether the private work has been done correctly
+          double aj = A0;
+          for (size_t iter=first; iter<last; iter++) {
+            aj += B0 + SCALAR*C0;
+          }
+          for (size_t j=0; j<stream_size; j++) {
+            if (std::fabs(a[j]-aj) > epsilon) {
+              errors++;
+              break;
+            }
+          }
+        }));
+      }
+
+      while (ready.load() < nthread) std::this_thread::yield();
+      double refcount_time = prk::wtime();
+      go.store(true, std::memory_order_release);
+      std::for_each(pool.begin(), pool.end(), [](std::thread & t) { t.join(); });
+      refcount_time = prk::wtime() - refcount_time;
+
+      //////////////////////////////////////////////////////////////////////
+      /// Analyze and output results
+      //////////////////////////////////////////////////////////////////////
+
+      double value1, value2;
+      if (m == update_mode::atomic) {
+        value1 = acounter1.load();
+        value2 = acounter2.load();
+      } else if (m == update_mode::sharded) {
+        // aggregate on read
+        value1 = 1.0;
+        value2 = 0.0;
+        for (int t=0; t<nthread; t++) {
+          value1 += shards[t*shardwords];
+          value2 += shards[t*shardwords+1];
+        }
+      } else {
+        value1 = counter1;
+        value2 = counter2;
+      }
+
+      const double refcounter1 = static_cast<double>(iterations+1);
+      const double refcounter2 = static_cast<double>(iterations);
+      if (errors.load() > 0) {
+        std::cout << "ERROR: " << mode_name(m) << " threads=" << nthread
+                  << " encountered errors in private work" << std::endl;
+        validate = false;
+      } else if (std::fabs(value1-refcounter1) > epsilon || std::fabs(value2-refcounter2) > epsilon) {
+        std::cout << "ERROR: " << mode_name(m) << " threads=" << nthread
+                  << " incorrect or inconsistent counter values " << value1 << " " << value2
+                  << "; should be " << refcounter1 << ", " << refcounter2 << std::endl;
+        validate = false;
+      } else {
+        std::cout << "Rate (MCPUPs/s) " << mode_name(m) << " threads=" << nthread << ": "
+                  << 1.0e-6*iterations/refcount_time
+                  << " time (s): " << refcount_time << std::endl;
+      }
+    }
+  }
+
+  if (!validate) {
+    std::cout << "Solution does not validate" << std::endl;
+    return 1;
+  }
+  std::cout << "Solution validates" << std::endl;
+
+  return 0;
+}
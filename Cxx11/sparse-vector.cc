@@ -38,10 +38,20 @@
 ///          linear, symmetric filter (stencil) can be applied to a square
 ///          grid or image.
 ///
-/// USAGE:   The program takes as input the linear
-///          dimension of the grid, and the number of iterations on the grid
+/// USAGE:   The program takes as input the number of iterations, the
+///          2log of the linear dimension of the grid, and the stencil radius
 ///
-///                <progname> <iterations> <grid size>
+///                <progname> <iterations> <2log grid size> <radius>
+///
+///          or the number of iterations and a Matrix Market file, which is
+///          mapped into memory and parsed into CSR by a number of threads
+///
+///                <progname> <iterations> <file.mtx> [<# parse threads>]
+///
+///          The element type of the matrix and vectors is chosen with
+///          PRK_PRECISION (see prk_types.h).  For the 16-bit types, the
+///          matrix is scaled up and the vector down by sqrt(order), which
+///          leaves the products unchanged but keeps both in range.
 ///
 ///          The output consists of diagnostics to make sure the
 ///          algorithm worked, and of timing statistics.
@@ -61,6 +71,7 @@
 //////////////////////////////////////////////////////////////////////
 
 #include "prk_util.h"
+#include "prk_mmio.h"
 
 static inline size_t offset(size_t i, size_t j, size_t lsize)
 {
@@ -96,58 +107,97 @@ static inline uint64_t reverse(uint64_t x, int shift_in_bits)
   #define REVERSE(a,b) (a)
 #endif
 
-int main(int argc, char* argv[])
+template <typename T>
+int sparse(int iterations, int lsize, int radius, const std::string & mtxfile, int parse_threads)
 {
-  std::cout << "Parallel Research Kernels version " << PRKVERSION << std::endl;
-  std::cout << "C++11 Sparse matrix-vector multiplication" << std::endl;
-
   //////////////////////////////////////////////////////////////////////
-  // Process and test input parameters
+  // Allocate space and build the matrix
   //////////////////////////////////////////////////////////////////////
 
-  int iterations, lsize, radius, stencil_size;
+  using U = typename prk::precision_traits<T>::compute;
+
+  int stencil_size=0;
   size_t size, size2, nent;
   double sparsity;
-  try {
-      if (argc < 4) {
-        throw "Usage: <# iterations> <2log grid size> <stencil radius>]";
-      }
 
-      // number of times to run the algorithm
-      iterations  = std::atoi(argv[1]);
-      if (iterations < 1) {
-        throw "ERROR: iterations must be >= 1";
-      }
+  std::vector<size_t> rowPtr;
+  std::vector<size_t> colIndex;
+  std::vector<T> matrix;
 
-      // linear grid dimension
-      lsize  = std::atoi(argv[2]);
-      if (lsize < 1) {
-        throw "ERROR: grid dimension must be positive";
-      }
+  double parse_time(0);
+  double vscale(1);
+
+  if (mtxfile.empty()) {
       size_t lsize2 = 2*lsize;
       size = 1L<<lsize;
       size2 = size*size;
-
-      // stencil radius
-      radius = std::atoi(argv[5]);
-
-      if (radius < 0) {
-        throw "ERROR: Stencil radius must be nonnegative";
-      }
-
       stencil_size = 4*radius+1;
       sparsity = (4.*radius+1.)/size2;
       nent = size2 * stencil_size;
-  }
-  catch (const char * e) {
-    std::cout << e << std::endl;
-    return 1;
+
+      rowPtr.resize(size2+1);
+      colIndex.resize(nent,0);
+      matrix.resize(nent,U(0));
+
+      // in 16 bits, neither 1/(col+1) nor k*(col+1) fits unscaled
+      vscale = (sizeof(T) < sizeof(float)) ? 1.0/std::sqrt(static_cast<double>(size2)) : 1.0;
+
+      for (size_t row=0; row<=size2; row++) {
+        rowPtr[row] = row*stencil_size;
+      }
+      for (size_t row=0; row<size2; row++) {
+        size_t i = row % size;
+        size_t j = row / size;
+        size_t elm = row*stencil_size;
+        colIndex[elm] = REVERSE(offset(i,j,lsize),lsize2);
+        for (int r=1; r<=radius; r++, elm+=4) {
+          colIndex[elm+1] = REVERSE(offset((i+r)%size,j,lsize),lsize2);
+          colIndex[elm+2] = REVERSE(offset((i-r+size)%size,j,lsize),lsize2);
+          colIndex[elm+3] = REVERSE(offset(i,(j+r)%size,lsize),lsize2);
+          colIndex[elm+4] = REVERSE(offset(i,(j-r+size)%size,lsize),lsize2);
+        }
+        std::sort(&(colIndex[row*stencil_size]), &(colIndex[(row+1)*stencil_size]));
+        for (size_t elm=row*stencil_size; elm<(row+1)*stencil_size; elm++) {
+          matrix[elm] = U(1.0/((colIndex[elm]+1.)*vscale));
+        }
+      }
+  } else {
+      try {
+          parse_time = prk::wtime();
+          auto A = prk::read_matrix_market(mtxfile.c_str(), parse_threads);
+          parse_time = prk::wtime() - parse_time;
+          if (A.nrows != A.ncols) {
+            throw "ERROR: Matrix Market matrix must be square";
+          }
+          size2 = A.nrows;
+          nent  = A.rowPtr[size2];
+          sparsity = static_cast<double>(nent)/(static_cast<double>(size2)*static_cast<double>(size2));
+          vscale = (sizeof(T) < sizeof(float)) ? 1.0/std::sqrt(static_cast<double>(size2)) : 1.0;
+          rowPtr.swap(A.rowPtr);
+          colIndex.swap(A.colIndex);
+          matrix.resize(nent);
+          for (size_t elm=0; elm<nent; elm++) {
+              matrix[elm] = U(A.values[elm]/vscale);
+          }
+      }
+      catch (const char * e) {
+        std::cout << e << std::endl;
+        return 1;
+      }
   }
 
   std::cout << "Number of iterations = " << iterations << std::endl;
+  prk::cold::print();
   std::cout << "Matrix order         = " << size2 << std::endl;
-  std::cout << "Stencil diameter     = " << 2*radius+1 << std::endl;
+  if (mtxfile.empty()) {
+    std::cout << "Stencil diameter     = " << 2*radius+1 << std::endl;
+  } else {
+    std::cout << "Matrix Market file   = " << mtxfile << std::endl;
+    std::cout << "Nonzeros             = " << nent << std::endl;
+    std::cout << "Parse threads        = " << parse_threads << std::endl;
+  }
   std::cout << "Sparsity             = " << sparsity << std::endl;
+  std::cout << "Precision            = " << prk::precision_traits<T>::description << std::endl;
 #if SCRAMBLE
   std::cout << "Using scrambled indexing"  << std::endl;
 #else
@@ -155,68 +205,71 @@ int main(int argc, char* argv[])
 #endif
 
   //////////////////////////////////////////////////////////////////////
-  // Allocate space and perform the computation
+  // Perform the computation
   //////////////////////////////////////////////////////////////////////
 
-  std::vector<double> matrix(nent,0.0);
-  std::vector<size_t> colIndex(nent,0);
-  std::vector<double> vector(size2,0.0);
-  std::vector<double> result(size2,0.0);
+  std::vector<T> vector(size2,U(0));
+  std::vector<T> result(size2,U(0));
 
   double sparse_time(0);
+  prk::counters counters;
 
   {
-    for (size_t row=0; row<size2; row++) {
-      size_t i = row % size;
-      size_t j = row / size;
-      size_t elm = row*stencil_size;
-      colIndex[elm] = REVERSE(offset(i,j,lsize),lsize2);
-      for (size_t r=1; r<=radius; r++, elm+=4) {
-        colIndex[elm+1] = REVERSE(offset((i+r)%size,j,lsize),lsize2);
-        colIndex[elm+2] = REVERSE(offset((i-r+size)%size,j,lsize),lsize2);
-        colIndex[elm+3] = REVERSE(offset(i,(j+r)%size,lsize),lsize2);
-        colIndex[elm+4] = REVERSE(offset(i,(j-r+size)%size,lsize),lsize2);
-      }
-      std::sort(&(colIndex[row*stencil_size]), &(colIndex[(row+1)*stencil_size]));
-      for (size_t elm=row*stencil_size; elm<(row+1)*stencil_size; elm++) {
-        matrix[elm] = 1.0/(colIndex[elm]+1.);
-      }
-    }
-
     for (auto iter = 0; iter<=iterations; iter++) {
 
-      if (iter==1) sparse_time = prk::wtime();
+      prk::cold::flush(counters, {matrix, colIndex, rowPtr, vector, result});
+
+      if (iter==1) {
+        sparse_time = prk::wtime();
+        counters.start();
+        prk::cold::start();
+      }
 
       for (size_t row=0; row<size2; row++) {
-          vector[row] += (row+1.);
+          vector[row] += U((row+1.)*vscale);
       }
 
       for (size_t row=0; row<size2; row++) {
-          double temp(0);
-          for (size_t col=stencil_size*row; col<stencil_size*(row+1); col++) {
-              temp += matrix[col]*vector[colIndex[col]];
+          U temp(0);
+          for (size_t col=rowPtr[row]; col<rowPtr[row+1]; col++) {
+              temp += static_cast<U>(matrix[col])*static_cast<U>(vector[colIndex[col]]);
           }
           result[row] += temp;
       }
 
     }
-    sparse_time = prk::wtime() - sparse_time;
+    sparse_time = prk::wtime() - sparse_time - prk::cold::elapsed();
+    counters.stop();
   }
 
   //////////////////////////////////////////////////////////////////////
   // Analyze and output results.
   //////////////////////////////////////////////////////////////////////
 
-  double reference_sum = (0.5*nent) * (iterations+1.) * (iterations+2.);
+  // After k updates, vector[col] = k*(col+1), so every entry contributes
+  // matrix[elm]*(col+1) per update.  For the stencil matrix this is one.
+  double entry_sum(0);
+  if (mtxfile.empty()) {
+      entry_sum = static_cast<double>(nent);
+  } else {
+      for (size_t elm=0; elm<nent; elm++) {
+          entry_sum += static_cast<double>(matrix[elm])*(colIndex[elm]+1.)*vscale;
+      }
+  }
+  double reference_sum = (0.5*entry_sum) * (iterations+1.) * (iterations+2.);
 
   double vector_sum(0);
   for (size_t row=0; row<size2; row++) {
-      vector_sum += result[row];
+      vector_sum += static_cast<double>(result[row]);
   }
 
-  const double epsilon(1.e-8);
+  const double epsilon = prk::precision_traits<T>::epsilon;
 
-  if (std::fabs(vector_sum-reference_sum) > epsilon) {
+  // the Matrix Market checksum is not an exact integer, and the reduced
+  // precisions are not exact either, so compare relatively
+  const bool relative = !mtxfile.empty() || !std::is_same<T,double>::value;
+  const double scale = (!relative || reference_sum == 0.0) ? 1.0 : std::fabs(reference_sum);
+  if (std::fabs(vector_sum-reference_sum)/scale > epsilon) {
     std::cout << "ERROR: Vector norm = " << vector_sum
               << " Reference vector norm = " << reference_sum << std::endl;
     return 1;
@@ -227,9 +280,82 @@ int main(int argc, char* argv[])
               << ", vector sum = " << vector_sum << std::endl;
 #endif
     double avgtime = sparse_time/iterations;
+    if (!mtxfile.empty()) {
+      std::cout << "Parse time (s): " << parse_time << std::endl;
+    }
     std::cout << "Rate (MFlops/s): " << 1.0e-6 * (2.*nent)/avgtime
               << " Avg time (s): " << avgtime << std::endl;
+    // matrix value and column index per nonzero, plus the vectors
+    const prk::work_model work{2.0*nent, nent*(sizeof(T)+sizeof(size_t)) + 3.0*size2*sizeof(T)};
+    counters.print(iterations*work.bytes, iterations*work.flops);
+    prk::roofline::print(work, avgtime);
   }
 
   return 0;
 }
+
+int main(int argc, char* argv[])
+{
+  std::cout << "Parallel Research Kernels version " << PRKVERSION << std::endl;
+  std::cout << "C++11 Sparse matrix-vector multiplication" << std::endl;
+
+  //////////////////////////////////////////////////////////////////////
+  // Process and test input parameters
+  //////////////////////////////////////////////////////////////////////
+
+  int iterations, lsize=0, radius=0;
+  std::string mtxfile;
+  int parse_threads = 1;
+  prk::precision precision;
+  try {
+      prk::cold::parse(argc, argv);
+
+      if (argc < 3) {
+        throw "Usage: <# iterations> <2log grid size> <stencil radius>\n"
+              "       <# iterations> <Matrix Market file> [<# parse threads>]";
+      }
+
+      // number of times to run the algorithm
+      iterations  = std::atoi(argv[1]);
+      if (iterations < 1) {
+        throw "ERROR: iterations must be >= 1";
+      }
+
+      auto arg2 = std::string(argv[2]);
+      if (arg2.size() > 4 && arg2.compare(arg2.size()-4,4,".mtx") == 0) {
+        mtxfile = arg2;
+        parse_threads = (argc > 3) ? std::atoi(argv[3]) : std::thread::hardware_concurrency();
+        if (parse_threads < 1) parse_threads = 1;
+      } else {
+        if (argc < 4) {
+          throw "Usage: <# iterations> <2log grid size> <stencil radius>";
+        }
+
+        // linear grid dimension
+        lsize  = std::atoi(argv[2]);
+        if (lsize < 1) {
+          throw "ERROR: grid dimension must be positive";
+        }
+
+        // stencil radius
+        radius = std::atoi(argv[3]);
+        if (radius < 0) {
+          throw "ERROR: Stencil radius must be nonnegative";
+        }
+      }
+
+      precision = prk::get_precision();
+  }
+  catch (const char * e) {
+    std::cout << e << std::endl;
+    return 1;
+  }
+
+  switch (precision) {
+      case prk::precision::fp32: return sparse<float>(iterations, lsize, radius, mtxfile, parse_threads);
+      case prk::precision::bf16: return sparse<prk::bf16>(iterations, lsize, radius, mtxfile, parse_threads);
+      case prk::precision::fp16: return sparse<prk::fp16>(iterations, lsize, radius, mtxfile, parse_threads);
+      default:                   return sparse<double>(iterations, lsize, radius, mtxfile, parse_threads);
+  }
+}
+
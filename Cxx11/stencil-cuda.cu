@@ -64,7 +64,7 @@
 #include "prk_cuda.h"
 #include "stencil_cuda.hpp"
 
-__global__ void nothing(const int n, const prk_float * in, prk_float * out)
+__global__ void nothing(const int64_t n, const prk_float * in, prk_float * out)
 {
     //printf("You are trying to use a stencil that does not exist.\n");
     //printf("Please generate the new stencil using the code generator.\n");
@@ -73,10 +73,10 @@ __global__ void nothing(const int n, const prk_float * in, prk_float * out)
     //abort();
 }
 
-__global__ void add(const int n, prk_float * in)
+__global__ void add(const int64_t n, prk_float * in)
 {
-    int i = blockIdx.x * blockDim.x + threadIdx.x;
-    int j = blockIdx.y * blockDim.y + threadIdx.y;
+    int64_t i = blockIdx.x * blockDim.x + threadIdx.x;
+    int64_t j = blockIdx.y * blockDim.y + threadIdx.y;
 
     if ((i<n) && (j<n)) {
         in[i*n+j] += (prk_float)1;
@@ -95,7 +95,8 @@ int main(int argc, char* argv[])
   // Process and test input parameters
   //////////////////////////////////////////////////////////////////////
 
-  int iterations, n, radius, tile_size;
+  int iterations, radius;
+  int64_t n, tile_size;
   bool star = true;
   try {
       if (argc < 3) {
@@ -109,17 +110,17 @@ int main(int argc, char* argv[])
       }
 
       // linear grid dimension
-      n  = std::atoi(argv[2]);
+      n  = std::atoll(argv[2]);
       if (n < 1) {
         throw "ERROR: grid dimension must be positive";
-      } else if (n > std::floor(std::sqrt(INT_MAX))) {
+      } else if (n > std::floor(std::sqrt(INT64_MAX))) {
         throw "ERROR: grid dimension too large - overflow risk";
       }
 
       // default tile size for tiling of local transpose
       tile_size = 32;
       if (argc > 3) {
-          tile_size = std::atoi(argv[3]);
+          tile_size = std::atoll(argv[3]);
           if (tile_size <= 0) tile_size = n;
           if (tile_size > n) tile_size = n;
           if (tile_size > 32) {
@@ -196,8 +197,8 @@ int main(int argc, char* argv[])
   h_out = new prk_float[nelems];
 #endif
 
-  for (auto i=0; i<n; i++) {
-    for (auto j=0; j<n; j++) {
+  for (int64_t i=0; i<n; i++) {
+    for (int64_t j=0; j<n; j++) {
       h_in[i*n+j]  = static_cast<prk_float>(i+j);
       h_out[i*n+j] = static_cast<prk_float>(0);
     }
@@ -247,8 +248,8 @@ int main(int argc, char* argv[])
   size_t active_points = static_cast<size_t>(n-2*radius)*static_cast<size_t>(n-2*radius);
   // compute L1 norm
   double norm = 0.0;
-  for (auto i=radius; i<n-radius; i++) {
-    for (auto j=radius; j<n-radius; j++) {
+  for (int64_t i=radius; i<n-radius; i++) {
+    for (int64_t j=radius; j<n-radius; j++) {
       norm += std::fabs(h_out[i*n+j]);
     }
   }
@@ -69,7 +69,7 @@ typedef Kokkos::View<double**, Kokkos::LayoutRight> matrix;
 
 #include "stencil_kokkos.hpp"
 
-void nothing(const int n, const int t, matrix & in, matrix & out)
+void nothing(const int64_t n, const int64_t t, matrix & in, matrix & out)
 {
     std::cout << "You are trying to use a stencil that does not exist." << std::endl;
     std::cout << "Please generate the new stencil using the code generator." << std::endl;
@@ -87,7 +87,8 @@ int main(int argc, char* argv[])
     // Process and test input parameters
     //////////////////////////////////////////////////////////////////////
 
-    int iterations, n, radius, tile_size;
+    int iterations, radius;
+    int64_t n, tile_size;
     bool star = true;
     try {
         if (argc < 3) {
@@ -101,17 +102,17 @@ int main(int argc, char* argv[])
         }
 
         // linear grid dimension
-        n  = std::atoi(argv[2]);
+        n  = std::atoll(argv[2]);
         if (n < 1) {
           throw "ERROR: grid dimension must be positive";
-        } else if (n > std::floor(std::sqrt(INT_MAX))) {
+        } else if (n > std::floor(std::sqrt(INT64_MAX))) {
           throw "ERROR: grid dimension too large - overflow risk";
         }
 
         // default tile size for tiling of local transpose
         tile_size = 32;
         if (argc > 3) {
-            tile_size = std::atoi(argv[3]);
+            tile_size = std::atoll(argv[3]);
             if (tile_size <= 0) tile_size = n;
             if (tile_size > n) tile_size = n;
         }
@@ -180,7 +181,7 @@ int main(int argc, char* argv[])
     auto tile2  = {tile_size,tile_size};
     auto full   = Kokkos::MDRangePolicy<Kokkos::Rank<2>>(z2,n2,tile2);
 
-    Kokkos::parallel_for(full, KOKKOS_LAMBDA(int i, int j) {
+    Kokkos::parallel_for(full, KOKKOS_LAMBDA(int64_t i, int64_t j) {
         in(i,j)  = static_cast<double>(i+j);
         out(i,j) = 0.0;
     });
@@ -191,7 +192,7 @@ int main(int argc, char* argv[])
 
       stencil(n, tile_size, in, out);
 
-      Kokkos::parallel_for(full, KOKKOS_LAMBDA(int i, int j) {
+      Kokkos::parallel_for(full, KOKKOS_LAMBDA(int64_t i, int64_t j) {
           in(i,j) += 1.0;
       });
     }
@@ -208,7 +209,7 @@ int main(int argc, char* argv[])
     auto r2     = {radius,radius};
     auto nr2    = {n-radius,n-radius};
     auto inside = Kokkos::MDRangePolicy<Kokkos::Rank<2>>(r2,nr2,tile2);
-    Kokkos::parallel_reduce(inside, KOKKOS_LAMBDA(int i, int j, double & norm) {
+    Kokkos::parallel_reduce(inside, KOKKOS_LAMBDA(int64_t i, int64_t j, double & norm) {
         norm += std::fabs(out(i,j));
     }, norm);
     norm /= active_points;
@@ -63,7 +63,7 @@
 #include "prk_opencl.h"
 
 template <typename T>
-void run(cl::Context context, int iterations, int n, int radius, bool star)
+void run(cl::Context context, int iterations, int64_t n, int radius, bool star)
 {
   auto precision = (sizeof(T)==8) ? 64 : 32;
 
@@ -90,12 +90,12 @@ void run(cl::Context context, int iterations, int n, int radius, bool star)
   cl::Program program2(context, prk::opencl::loadProgram(filename2), true);
 
   cl_int err;
-  auto kernel1 = cl::make_kernel<int, cl::Buffer, cl::Buffer>(program1, funcname1, &err);
+  auto kernel1 = cl::make_kernel<cl_long, cl::Buffer, cl::Buffer>(program1, funcname1, &err);
   if(err != CL_SUCCESS){
     std::vector<cl::Device> devices = context.getInfo<CL_CONTEXT_DEVICES>();
     std::cout << program1.getBuildInfo<CL_PROGRAM_BUILD_LOG>(devices[0]) << std::endl;
   }
-  auto kernel2 = cl::make_kernel<int, cl::Buffer>(program2, funcname2, &err);
+  auto kernel2 = cl::make_kernel<cl_long, cl::Buffer>(program2, funcname2, &err);
   if(err != CL_SUCCESS){
     std::vector<cl::Device> devices = context.getInfo<CL_CONTEXT_DEVICES>();
     std::cout << program2.getBuildInfo<CL_PROGRAM_BUILD_LOG>(devices[0]) << std::endl;
@@ -113,8 +113,8 @@ void run(cl::Context context, int iterations, int n, int radius, bool star)
   auto stencil_time = 0.0;
 
   // initialize the input array
-  for (auto i=0; i<n; i++) {
-    for (auto j=0; j<n; j++) {
+  for (int64_t i=0; i<n; i++) {
+    for (int64_t j=0; j<n; j++) {
       h_in[i*n+j] = static_cast<T>(i+j);
     }
   }
@@ -152,8 +152,8 @@ void run(cl::Context context, int iterations, int n, int radius, bool star)
 
   // compute L1 norm in parallel
   double norm = 0.0;
-  for (auto i=radius; i<n-radius; i++) {
-    for (auto j=radius; j<n-radius; j++) {
+  for (int64_t i=radius; i<n-radius; i++) {
+    for (int64_t j=radius; j<n-radius; j++) {
       norm += std::fabs(static_cast<double>(h_out[i*n+j]));
     }
   }
@@ -190,7 +190,8 @@ int main(int argc, char* argv[])
   // Process and test input parameters
   //////////////////////////////////////////////////////////////////////
 
-  int iterations, n, radius, tile_size;
+  int iterations, radius;
+  int64_t n, tile_size;
   bool star = true;
   try {
       if (argc < 3) {
@@ -204,17 +205,17 @@ int main(int argc, char* argv[])
       }
 
       // linear grid dimension
-      n  = std::atoi(argv[2]);
+      n  = std::atoll(argv[2]);
       if (n < 1) {
         throw "ERROR: grid dimension must be positive";
-      } else if (n > std::floor(std::sqrt(INT_MAX))) {
+      } else if (n > std::floor(std::sqrt(INT64_MAX))) {
         throw "ERROR: grid dimension too large - overflow risk";
       }
 
       // default tile size for tiling of local transpose
       tile_size = 32;
       if (argc > 3) {
-          tile_size = std::atoi(argv[3]);
+          tile_size = std::atoll(argv[3]);
           if (tile_size <= 0) tile_size = n;
           if (tile_size > n) tile_size = n;
       }
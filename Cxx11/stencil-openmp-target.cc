@@ -63,7 +63,7 @@
 #include "prk_util.h"
 #include "stencil_target.hpp"
 
-void nothing(const int n, const int t, const double * RESTRICT in, double * RESTRICT out)
+void nothing(const int64_t n, const int64_t t, const double * RESTRICT in, double * RESTRICT out)
 {
     std::cout << "You are trying to use a stencil that does not exist." << std::endl;
     std::cout << "Please generate the new stencil using the code generator." << std::endl;
@@ -81,7 +81,8 @@ int main(int argc, char* argv[])
   // Process and test input parameters
   //////////////////////////////////////////////////////////////////////
 
-  int iterations, n, radius, tile_size;
+  int iterations, radius;
+  int64_t n, tile_size;
   bool star = true;
   try {
       if (argc < 3) {
@@ -95,17 +96,17 @@ int main(int argc, char* argv[])
       }
 
       // linear grid dimension
-      n  = std::atoi(argv[2]);
+      n  = std::atoll(argv[2]);
       if (n < 1) {
         throw "ERROR: grid dimension must be positive";
-      } else if (n > std::floor(std::sqrt(INT_MAX))) {
+      } else if (n > std::floor(std::sqrt(INT64_MAX))) {
         throw "ERROR: grid dimension too large - overflow risk";
       }
 
       // default tile size for tiling of local transpose
       tile_size = 32;
       if (argc > 3) {
-          tile_size = std::atoi(argv[3]);
+          tile_size = std::atoll(argv[3]);
           if (tile_size <= 0) tile_size = n;
           if (tile_size > n) tile_size = n;
       }
@@ -172,9 +173,9 @@ int main(int argc, char* argv[])
   OMP_PARALLEL()
   {
     OMP_FOR()
-    for (auto i=0; i<n; i++) {
+    for (int64_t i=0; i<n; i++) {
       OMP_SIMD
-      for (auto j=0; j<n; j++) {
+      for (int64_t j=0; j<n; j++) {
         in[i*n+j] = static_cast<double>(i+j);
         out[i*n+j] = 0.0;
       }
@@ -193,8 +194,8 @@ int main(int argc, char* argv[])
 
       // Add constant to solution to force refresh of neighbor data, if any
       OMP_TARGET( teams distribute parallel for simd collapse(2) schedule(static,1) )
-      for (auto i=0; i<n; i++) {
-        for (auto j=0; j<n; j++) {
+      for (int64_t i=0; i<n; i++) {
+        for (int64_t j=0; j<n; j++) {
           in[i*n+j] += 1.0;
         }
       }
@@ -211,8 +212,8 @@ int main(int argc, char* argv[])
   // compute L1 norm in parallel
   double norm = 0.0;
   OMP_PARALLEL_FOR_REDUCE( +:norm )
-  for (auto i=radius; i<n-radius; i++) {
-    for (auto j=radius; j<n-radius; j++) {
+  for (int64_t i=radius; i<n-radius; i++) {
+    for (int64_t j=radius; j<n-radius; j++) {
       norm += std::fabs(out[i*n+j]);
     }
   }
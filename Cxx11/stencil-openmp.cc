@@ -67,7 +67,7 @@
 #include "stencil_seq.hpp"
 #endif
 
-void nothing(const int n, const int t, const double * RESTRICT in, double * RESTRICT out)
+void nothing(const int64_t n, const int64_t t, const double * RESTRICT in, double * RESTRICT out)
 {
     std::cout << "You are trying to use a stencil that does not exist.\n";
     std::cout << "Please generate the new stencil using the code generator\n";
@@ -90,7 +90,8 @@ int main(int argc, char* argv[])
   // Process and test input parameters
   //////////////////////////////////////////////////////////////////////
 
-  int iterations, n, radius, tile_size;
+  int iterations, radius;
+  int64_t n, tile_size;
   bool star = true;
   try {
       if (argc < 3) {
@@ -104,17 +105,17 @@ int main(int argc, char* argv[])
       }
 
       // linear grid dimension
-      n  = std::atoi(argv[2]);
+      n  = std::atoll(argv[2]);
       if (n < 1) {
         throw "ERROR: grid dimension must be positive";
-      } else if (n > std::floor(std::sqrt(INT_MAX))) {
+      } else if (n > std::floor(std::sqrt(INT64_MAX))) {
         throw "ERROR: grid dimension too large - overflow risk";
       }
 
       // default tile size for tiling of local transpose
       tile_size = 32;
       if (argc > 3) {
-          tile_size = std::atoi(argv[3]);
+          tile_size = std::atoll(argv[3]);
           if (tile_size <= 0) tile_size = n;
           if (tile_size > n) tile_size = n;
       }
@@ -181,8 +182,8 @@ int main(int argc, char* argv[])
   OMP_PARALLEL()
   {
     OMP_FOR( collapse(2) )
-    for (auto it=0; it<n; it+=tile_size) {
-      for (auto jt=0; jt<n; jt+=tile_size) {
+    for (int64_t it=0; it<n; it+=tile_size) {
+      for (int64_t jt=0; jt<n; jt+=tile_size) {
         for (auto i=it; i<std::min(n,it+tile_size); i++) {
           PRAGMA_SIMD
           for (auto j=jt; j<std::min(n,jt+tile_size); j++) {
@@ -205,8 +206,8 @@ int main(int argc, char* argv[])
       stencil(n, tile_size, in, out);
       // Add constant to solution to force refresh of neighbor data, if any
       OMP_FOR( collapse(2) )
-      for (auto it=0; it<n; it+=tile_size) {
-        for (auto jt=0; jt<n; jt+=tile_size) {
+      for (int64_t it=0; it<n; it+=tile_size) {
+        for (int64_t jt=0; jt<n; jt+=tile_size) {
           for (auto i=it; i<std::min(n,it+tile_size); i++) {
             PRAGMA_SIMD
             for (auto j=jt; j<std::min(n,jt+tile_size); j++) {
@@ -230,8 +231,8 @@ int main(int argc, char* argv[])
   // compute L1 norm in parallel
   double norm = 0.0;
   OMP_PARALLEL_FOR_REDUCE( +:norm )
-  for (auto i=radius; i<n-radius; i++) {
-    for (auto j=radius; j<n-radius; j++) {
+  for (int64_t i=radius; i<n-radius; i++) {
+    for (int64_t j=radius; j<n-radius; j++) {
       norm += std::fabs(out[i*n+j]);
     }
   }
@@ -255,6 +256,9 @@ int main(int argc, char* argv[])
     auto avgtime = stencil_time/iterations;
     std::cout << "Rate (MFlops/s): " << 1.0e-6 * static_cast<double>(flops)/avgtime
               << " Avg time (s): " << avgtime << std::endl;
+    // in and out are streamed by the stencil, in again by the update
+    const prk::work_model work{static_cast<double>(flops), 4.0*n*n*sizeof(double)};
+    prk::roofline::print(work, avgtime);
   }
 
   return 0;
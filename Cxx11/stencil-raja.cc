@@ -64,7 +64,7 @@
 #include "prk_raja.h"
 #include "stencil_rajaview.hpp"
 
-void nothing(const int n, const int t, matrix & in, matrix & out)
+void nothing(const int64_t n, const int64_t t, matrix & in, matrix & out)
 {
     std::cout << "You are trying to use a stencil that does not exist.\n";
     std::cout << "Please generate the new stencil using the code generator\n";
@@ -83,7 +83,8 @@ int main(int argc, char* argv[])
   // Process and test input parameters
   //////////////////////////////////////////////////////////////////////
 
-  int iterations, n, radius, tile_size;
+  int iterations, radius;
+  int64_t n, tile_size;
   bool star = true;
   try {
       if (argc < 3) {
@@ -97,17 +98,17 @@ int main(int argc, char* argv[])
       }
 
       // linear grid dimension
-      n  = std::atoi(argv[2]);
+      n  = std::atoll(argv[2]);
       if (n < 1) {
         throw "ERROR: grid dimension must be positive";
-      } else if (n > std::floor(std::sqrt(INT_MAX))) {
+      } else if (n > std::floor(std::sqrt(INT64_MAX))) {
         throw "ERROR: grid dimension too large - overflow risk";
       }
 
       // default tile size for tiling of local transpose
       tile_size = 32;
       if (argc > 3) {
-          tile_size = std::atoi(argv[3]);
+          tile_size = std::atoll(argv[3]);
           if (tile_size <= 0) tile_size = n;
           if (tile_size > n) tile_size = n;
       }
@@ -181,7 +182,7 @@ int main(int argc, char* argv[])
   RAJA::RangeSegment range(0, n);
   auto grid = RAJA::make_tuple(range, range);
 
-  RAJA::kernel<regular_policy>(grid, [=](int i, int j) {
+  RAJA::kernel<regular_policy>(grid, [=](RAJA::Index_type i, RAJA::Index_type j) {
       in(i,j)  = static_cast<double>(i+j);
       out(i,j) = 0.0;
   });
@@ -192,7 +193,7 @@ int main(int argc, char* argv[])
     // Apply the stencil operator
     stencil(n, tile_size, in, out);
     // Add constant to solution to force refresh of neighbor data, if any
-    RAJA::kernel<regular_policy>(grid, [=](int i, int j) {
+    RAJA::kernel<regular_policy>(grid, [=](RAJA::Index_type i, RAJA::Index_type j) {
         in(i,j) += 1.0;
     });
   }
@@ -102,17 +102,17 @@ int main(int argc, char* argv[])
       }
 
       // linear grid dimension
-      n  = std::atoi(argv[2]);
+      n  = std::atoll(argv[2]);
       if (n < 1) {
         throw "ERROR: grid dimension must be positive";
-      } else if (n > std::floor(std::sqrt(INT_MAX))) {
+      } else if (n > std::floor(std::sqrt(INT64_MAX))) {
         throw "ERROR: grid dimension too large - overflow risk";
       }
 
       // default tile size for tiling of local transpose
       tile_size = 32;
       if (argc > 3) {
-          tile_size = std::atoi(argv[3]);
+          tile_size = std::atoll(argv[3]);
           if (tile_size <= 0) tile_size = n;
           if (tile_size > n) tile_size = n;
       }
@@ -245,8 +245,8 @@ int main(int argc, char* argv[])
   }
 
 #if 0
-  for (auto i=0; i<n; i++) {
-    for (auto j=0; j<n; j++) {
+  for (size_t i=0; i<n; i++) {
+    for (size_t j=0; j<n; j++) {
         std::cerr << i << "," << j << "," << h_out[i*n+j] << "\n";
     }
   }
@@ -261,8 +261,8 @@ int main(int argc, char* argv[])
 
   // compute L1 norm in parallel
   double norm = 0.0;
-  for (auto i=radius; i<n-radius; i++) {
-    for (auto j=radius; j<n-radius; j++) {
+  for (size_t i=radius; i<n-radius; i++) {
+    for (size_t j=radius; j<n-radius; j++) {
       norm += std::fabs(h_out[i*n+j]);
     }
   }
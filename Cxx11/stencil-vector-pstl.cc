@@ -72,7 +72,7 @@
 #include "stencil_stl.hpp"
 #endif
 
-void nothing(const int n, const int t, std::vector<double> & in, std::vector<double> & out)
+void nothing(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out)
 {
     std::cout << "You are trying to use a stencil that does not exist.\n";
     std::cout << "Please generate the new stencil using the code generator\n";
@@ -95,7 +95,8 @@ int main(int argc, char* argv[])
   // Process and test input parameters
   //////////////////////////////////////////////////////////////////////
 
-  int iterations, n, radius, tile_size;
+  int iterations, radius;
+  int64_t n, tile_size;
   bool star = true;
   try {
       if (argc < 3) {
@@ -109,17 +110,17 @@ int main(int argc, char* argv[])
       }
 
       // linear grid dimension
-      n  = std::atoi(argv[2]);
+      n  = std::atoll(argv[2]);
       if (n < 1) {
         throw "ERROR: grid dimension must be positive";
-      } else if (n > std::floor(std::sqrt(INT_MAX))) {
+      } else if (n > std::floor(std::sqrt(INT64_MAX))) {
         throw "ERROR: grid dimension too large - overflow risk";
       }
 
       // default tile size for tiling of local transpose
       tile_size = 32;
       if (argc > 3) {
-          tile_size = std::atoi(argv[3]);
+          tile_size = std::atoll(argv[3]);
           if (tile_size <= 0) tile_size = n;
           if (tile_size > n) tile_size = n;
       }
@@ -183,15 +184,15 @@ int main(int argc, char* argv[])
   // initialize the input and output arrays
   auto range = prk::range(0,n);
 #if defined(USE_PSTL) && defined(USE_INTEL_PSTL)
-  std::for_each( exec::par, std::begin(range), std::end(range), [&] (int i) {
-    std::for_each( exec::unseq, std::begin(range), std::end(range), [&] (int j) {
+  std::for_each( exec::par, std::begin(range), std::end(range), [&] (int64_t i) {
+    std::for_each( exec::unseq, std::begin(range), std::end(range), [&] (int64_t j) {
 #elif defined(USE_PSTL) && defined(__GNUC__) && defined(__GNUC_MINOR__) \
                         && ( (__GNUC__ == 8) || (__GNUC__ == 7) && (__GNUC_MINOR__ >= 2) )
-  __gnu_parallel::for_each( std::begin(range), std::end(range), [&] (int i) {
-    __gnu_parallel::for_each( std::begin(range), std::end(range), [&] (int j) {
+  __gnu_parallel::for_each( std::begin(range), std::end(range), [&] (int64_t i) {
+    __gnu_parallel::for_each( std::begin(range), std::end(range), [&] (int64_t j) {
 #else
-  std::for_each( std::begin(range), std::end(range), [&] (int i) {
-    std::for_each( std::begin(range), std::end(range), [&] (int j) {
+  std::for_each( std::begin(range), std::end(range), [&] (int64_t i) {
+    std::for_each( std::begin(range), std::end(range), [&] (int64_t j) {
 #endif
       in[i*n+j] = static_cast<double>(i+j);
       out[i*n+j] = 0.0;
@@ -205,15 +206,15 @@ int main(int argc, char* argv[])
     // Add constant to solution to force refresh of neighbor data, if any
 #if 0
 #if defined(USE_PSTL) && defined(USE_INTEL_PSTL)
-    std::for_each( exec::par, std::begin(range), std::end(range), [&] (int i) {
-      std::for_each( exec::unseq, std::begin(range), std::end(range), [&] (int j) {
+    std::for_each( exec::par, std::begin(range), std::end(range), [&] (int64_t i) {
+      std::for_each( exec::unseq, std::begin(range), std::end(range), [&] (int64_t j) {
 #elif defined(USE_PSTL) && defined(__GNUC__) && defined(__GNUC_MINOR__) \
                         && ( (__GNUC__ == 8) || (__GNUC__ == 7) && (__GNUC_MINOR__ >= 2) )
-      __gnu_parallel::for_each( std::begin(range), std::end(range), [&] (int i) {
-        __gnu_parallel::for_each( std::begin(range), std::end(range), [&] (int j) {
+      __gnu_parallel::for_each( std::begin(range), std::end(range), [&] (int64_t i) {
+        __gnu_parallel::for_each( std::begin(range), std::end(range), [&] (int64_t j) {
 #else
-    std::for_each( std::begin(range), std::end(range), [&] (int i) {
-      std::for_each( std::begin(range), std::end(range), [&] (int j) {
+    std::for_each( std::begin(range), std::end(range), [&] (int64_t i) {
+      std::for_each( std::begin(range), std::end(range), [&] (int64_t j) {
 #endif
         in[i*n+j] += 1.0;
       });
@@ -61,9 +61,10 @@
 //////////////////////////////////////////////////////////////////////
 
 #include "prk_util.h"
+#include "prk_trace.h"
 #include "stencil_taskloop.hpp"
 
-void nothing(const int n, const int t, std::vector<double> & in, std::vector<double> & out, const int gs)
+void nothing(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out, const int gs)
 {
     std::cout << "You are trying to use a stencil that does not exist.\n";
     std::cout << "Please generate the new stencil using the code generator\n";
@@ -82,7 +83,8 @@ int main(int argc, char* argv[])
   // Process and test input parameters
   //////////////////////////////////////////////////////////////////////
 
-  int iterations, n, radius, tile_size, gs;
+  int iterations, radius, gs;
+  int64_t n, tile_size;
   bool star = true;
   try {
       if (argc < 3) {
@@ -96,17 +98,17 @@ int main(int argc, char* argv[])
       }
 
       // linear grid dimension
-      n  = std::atoi(argv[2]);
+      n  = std::atoll(argv[2]);
       if (n < 1) {
         throw "ERROR: grid dimension must be positive";
-      } else if (n > std::floor(std::sqrt(INT_MAX))) {
+      } else if (n > std::floor(std::sqrt(INT64_MAX))) {
         throw "ERROR: grid dimension too large - overflow risk";
       }
 
       // default tile size for tiling of local transpose
       tile_size = 32;
       if (argc > 3) {
-          tile_size = std::atoi(argv[3]);
+          tile_size = std::atoll(argv[3]);
           if (tile_size <= 0) tile_size = n;
           if (tile_size > n) tile_size = n;
       }
@@ -181,8 +183,8 @@ int main(int argc, char* argv[])
   OMP_MASTER
   {
     OMP_TASKLOOP_COLLAPSE(2, firstprivate(n) shared(in,out) grainsize(gs) )
-    for (auto it=0; it<n; it+=tile_size) {
-      for (auto jt=0; jt<n; jt+=tile_size) {
+    for (int64_t it=0; it<n; it+=tile_size) {
+      for (int64_t jt=0; jt<n; jt+=tile_size) {
         for (auto i=it; i<std::min(n,it+tile_size); i++) {
           PRAGMA_SIMD
           for (auto j=jt; j<std::min(n,jt+tile_size); j++) {
@@ -203,8 +205,9 @@ int main(int argc, char* argv[])
 
       // Add constant to solution to force refresh of neighbor data, if any
       OMP_TASKLOOP_COLLAPSE(2, firstprivate(n) shared(in,out) grainsize(gs) )
-      for (auto it=0; it<n; it+=tile_size) {
-        for (auto jt=0; jt<n; jt+=tile_size) {
+      for (int64_t it=0; it<n; it+=tile_size) {
+        for (int64_t jt=0; jt<n; jt+=tile_size) {
+          PRK_TRACE_SCOPE("add", it, jt);
           for (auto i=it; i<std::min(n,it+tile_size); i++) {
             PRAGMA_SIMD
             for (auto j=jt; j<std::min(n,jt+tile_size); j++) {
@@ -228,8 +231,8 @@ int main(int argc, char* argv[])
   // compute L1 norm in parallel
   double norm = 0.0;
   OMP_PARALLEL_FOR_REDUCE( +:norm )
-  for (auto i=radius; i<n-radius; i++) {
-    for (auto j=radius; j<n-radius; j++) {
+  for (int64_t i=radius; i<n-radius; i++) {
+    for (int64_t j=radius; j<n-radius; j++) {
       norm += std::fabs(out[i*n+j]);
     }
   }
@@ -253,6 +256,9 @@ int main(int argc, char* argv[])
     auto avgtime = stencil_time/iterations;
     std::cout << "Rate (MFlops/s): " << 1.0e-6 * static_cast<double>(flops)/avgtime
               << " Avg time (s): " << avgtime << std::endl;
+    // in and out are streamed by the stencil, in again by the update
+    const prk::work_model work{static_cast<double>(flops), 4.0*n*n*sizeof(double)};
+    prk::roofline::print(work, avgtime);
   }
 
   return 0;
@@ -62,9 +62,10 @@
 
 #include "prk_util.h"
 #include "prk_tbb.h"
+#include "prk_affinity.h"
 #include "stencil_tbb.hpp"
 
-void nothing(const int n, const int t, std::vector<double> & in, std::vector<double> & out)
+void nothing(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out)
 {
     std::cout << "You are trying to use a stencil that does not exist." << std::endl;
     std::cout << "Please generate the new stencil using the code generator." << std::endl;
@@ -83,8 +84,10 @@ int main(int argc, char* argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int n, radius, tile_size;
+  int radius;
+  int64_t n, tile_size;
   bool star = true;
+  prk::affinity affinity;
   try {
       if (argc < 3){
         throw "Usage: <# iterations> <array dimension> [tile_size] [<star/grid> <radius>]";
@@ -97,17 +100,17 @@ int main(int argc, char* argv[])
       }
 
       // linear grid dimension
-      n  = std::atoi(argv[2]);
+      n  = std::atoll(argv[2]);
       if (n < 1) {
         throw "ERROR: grid dimension must be positive";
-      } else if (n > std::floor(std::sqrt(INT_MAX))) {
+      } else if (n > std::floor(std::sqrt(INT64_MAX))) {
         throw "ERROR: grid dimension too large - overflow risk";
       }
 
       // linear grid dimension
       tile_size = 32;
       if (argc > 3) {
-        tile_size  = std::atoi(argv[3]);
+        tile_size  = std::atoll(argv[3]);
         if (tile_size < 1 || tile_size > n) tile_size = n;
       }
 
@@ -127,6 +130,8 @@ int main(int argc, char* argv[])
       if ( (radius < 1) || (2*radius+1 > n) ) {
         throw "ERROR: Stencil radius negative or too large";
       }
+
+      affinity = prk::get_affinity();
   }
   catch (const char * e) {
     std::cout << e << std::endl;
@@ -136,8 +141,10 @@ int main(int argc, char* argv[])
   const char* envvar = std::getenv("TBB_NUM_THREADS");
   int num_threads = (envvar!=NULL) ? std::atoi(envvar) : tbb::task_scheduler_init::default_num_threads();
   tbb::task_scheduler_init init(num_threads);
+  prk::affinity_observer observer(affinity);
 
   std::cout << "Number of threads    = " << num_threads << std::endl;
+  affinity.print(num_threads);
   std::cout << "Number of iterations = " << iterations << std::endl;
   std::cout << "Grid size            = " << n << std::endl;
   std::cout << "Tile size            = " << tile_size << std::endl;
@@ -173,7 +180,7 @@ int main(int argc, char* argv[])
   std::vector<double> in(n*n);
   std::vector<double> out(n*n);
 
-  tbb::blocked_range2d<int> range(0, n, tile_size, 0, n, tile_size);
+  tbb::blocked_range2d<int64_t> range(0, n, tile_size, 0, n, tile_size);
   tbb::parallel_for( range, [&](decltype(range)& r) {
                      for (auto i=r.rows().begin(); i!=r.rows().end(); ++i ) {
                          PRAGMA_SIMD
@@ -212,8 +219,8 @@ int main(int argc, char* argv[])
   double norm = 0.0;
 #if 0
   // Use this if, for whatever reason, TBB reductions are not reliable.
-  for (auto i=radius; i<n-radius; i++) {
-    for (auto j=radius; j<n-radius; j++) {
+  for (int64_t i=radius; i<n-radius; i++) {
+    for (int64_t j=radius; j<n-radius; j++) {
       norm += std::fabs(out[i*n+j]);
     }
   }
@@ -41,7 +41,16 @@
 /// USAGE:   The program takes as input the linear
 ///          dimension of the grid, and the number of iterations on the grid
 ///
-///                <progname> <iterations> <grid size>
+///                <progname> <iterations> <grid size> [<tile size|auto> <star/grid> <radius>]
+///
+///          With tile size "auto", the tile size is found by prk::autotune
+///          and cached.
+///
+///          The element type is chosen with PRK_PRECISION (see prk_types.h).
+///          The grid holds i+j plus one per iteration.  For the 16-bit types
+///          i+j is scaled into [0,1] by a power of two and the result is
+///          validated relative to its size; since out accumulates in 16 bits,
+///          they are limited to a few tens of iterations.
 ///
 ///          The output consists of diagnostics to make sure the
 ///          algorithm worked, and of timing statistics.
@@ -61,9 +70,11 @@
 //////////////////////////////////////////////////////////////////////
 
 #include "prk_util.h"
+#include "prk_autotune.h"
 #include "stencil_seq.hpp"
 
-void nothing(const int n, const int t, std::vector<double> & in, std::vector<double> & out)
+template <typename T>
+void nothing(const int64_t n, const int64_t t, std::vector<T> & in, std::vector<T> & out)
 {
     std::cout << "You are trying to use a stencil that does not exist.\n";
     std::cout << "Please generate the new stencil using the code generator\n";
@@ -73,88 +84,47 @@ void nothing(const int n, const int t, std::vector<double> & in, std::vector<dou
     std::abort();
 }
 
-int main(int argc, char* argv[])
+template <typename T>
+int stencil(int iterations, int64_t n, int radius, int64_t tile_size, bool star, bool autotune)
 {
-  std::cout << "Parallel Research Kernels version " << PRKVERSION << std::endl;
-  std::cout << "C++11 Stencil execution on 2D grid" << std::endl;
-
-  //////////////////////////////////////////////////////////////////////
-  // Process and test input parameters
-  //////////////////////////////////////////////////////////////////////
-
-  int iterations, n, radius, tile_size;
-  bool star = true;
-  try {
-      if (argc < 3) {
-        throw "Usage: <# iterations> <array dimension> [<tile_size> <star/grid> <radius>]";
-      }
-
-      // number of times to run the algorithm
-      iterations  = std::atoi(argv[1]);
-      if (iterations < 1) {
-        throw "ERROR: iterations must be >= 1";
-      }
-
-      // linear grid dimension
-      n  = std::atoi(argv[2]);
-      if (n < 1) {
-        throw "ERROR: grid dimension must be positive";
-      } else if (n > std::floor(std::sqrt(INT_MAX))) {
-        throw "ERROR: grid dimension too large - overflow risk";
-      }
+  using traits = prk::precision_traits<T>;
+  using U = typename traits::compute;
 
-      // default tile size for tiling of local transpose
-      tile_size = 32;
-      if (argc > 3) {
-          tile_size = std::atoi(argv[3]);
-          if (tile_size <= 0) tile_size = n;
-          if (tile_size > n) tile_size = n;
-      }
+  std::cout << "Precision            = " << traits::description << std::endl;
 
-      // stencil pattern
-      if (argc > 4) {
-          auto stencil = std::string(argv[4]);
-          auto grid = std::string("grid");
-          star = (stencil == grid) ? false : true;
-      }
-
-      // stencil radius
-      radius = 2;
-      if (argc > 5) {
-          radius = std::atoi(argv[5]);
-      }
-
-      if ( (radius < 1) || (2*radius+1 > n) ) {
-        throw "ERROR: Stencil radius negative or too large";
-      }
-  }
-  catch (const char * e) {
-    std::cout << e << std::endl;
+  // the 16-bit types cannot hold i+j, so in is scaled into [0,1]
+  const bool scaled = (sizeof(T) < sizeof(float));
+  const double scale = scaled ? std::exp2(-std::ceil(std::log2(2.0*(n-1)))) : 1.0;
+  if (!scaled) {
+    // the largest value of in is 2*(n-1)+iterations and the stencil only
+    // ever adds integers to out, so exact arithmetic needs both to fit
+    if (2.0*(n-1)+iterations > traits::exact || 2.0*(iterations+1) > traits::exact) {
+      std::cout << "ERROR: grid or iteration count too large for exact arithmetic in "
+                << traits::name << std::endl;
+      return 1;
+    }
+  } else if ((iterations+1.)/(2.0*traits::exact) > traits::epsilon) {
+    // each of the iterations+1 updates of out rounds by up to half an ulp
+    std::cout << "ERROR: too many iterations for the accuracy of " << traits::name << std::endl;
     return 1;
   }
 
-  std::cout << "Number of iterations = " << iterations << std::endl;
-  std::cout << "Grid size            = " << n << std::endl;
-  std::cout << "Tile size            = " << tile_size << std::endl;
-  std::cout << "Type of stencil      = " << (star ? "star" : "grid") << std::endl;
-  std::cout << "Radius of stencil    = " << radius << std::endl;
-
-  auto stencil = nothing;
+  auto stencil = nothing<T>;
   if (star) {
       switch (radius) {
-          case 1: stencil = star1; break;
-          case 2: stencil = star2; break;
-          case 3: stencil = star3; break;
-          case 4: stencil = star4; break;
-          case 5: stencil = star5; break;
+          case 1: stencil = star1<T>; break;
+          case 2: stencil = star2<T>; break;
+          case 3: stencil = star3<T>; break;
+          case 4: stencil = star4<T>; break;
+          case 5: stencil = star5<T>; break;
       }
   } else {
       switch (radius) {
-          case 1: stencil = grid1; break;
-          case 2: stencil = grid2; break;
-          case 3: stencil = grid3; break;
-          case 4: stencil = grid4; break;
-          case 5: stencil = grid5; break;
+          case 1: stencil = grid1<T>; break;
+          case 2: stencil = grid2<T>; break;
+          case 3: stencil = grid3<T>; break;
+          case 4: stencil = grid4<T>; break;
+          case 5: stencil = grid5<T>; break;
       }
   }
 
@@ -163,18 +133,34 @@ int main(int argc, char* argv[])
   //////////////////////////////////////////////////////////////////////
 
   auto stencil_time = 0.0;
+  prk::counters counters;
+
+  std::vector<T> in(n*n);
+  std::vector<T> out(n*n);
 
-  std::vector<double> in(n*n);
-  std::vector<double> out(n*n);
+  // trials run on the real grids, which are initialized afterwards
+  if (autotune) {
+    prk::autotune tuner("stencil-vector",
+                        "n=" + std::to_string(n) + "," + (star ? "star" : "grid") + std::to_string(radius)
+                        + "," + traits::name,
+                        {{"tile_size", 4, n}});
+    tile_size = tuner.tune([&] (const prk::autotune::point & p) {
+                             double t = prk::wtime();
+                             stencil(n, p[0], in, out);
+                             return prk::wtime() - t;
+                           })[0];
+  }
+  std::cout << "Tile size            = " << tile_size << std::endl;
 
   {
-    for (auto it=0; it<n; it+=tile_size) {
-      for (auto jt=0; jt<n; jt+=tile_size) {
+    for (int64_t it=0; it<n; it+=tile_size) {
+      for (int64_t jt=0; jt<n; jt+=tile_size) {
         for (auto i=it; i<std::min(n,it+tile_size); i++) {
+          const auto jend = std::min(n,jt+tile_size);
           PRAGMA_SIMD
-          for (auto j=jt; j<std::min(n,jt+tile_size); j++) {
-            in[i*n+j] = static_cast<double>(i+j);
-            out[i*n+j] = 0.0;
+          for (auto j=jt; j<jend; j++) {
+            in[i*n+j] = static_cast<U>((i+j)*scale);
+            out[i*n+j] = U(0);
           }
         }
       }
@@ -182,13 +168,20 @@ int main(int argc, char* argv[])
 
     for (auto iter = 0; iter<=iterations; iter++) {
 
-      if (iter==1) stencil_time = prk::wtime();
+      prk::cold::flush(counters, {in, out});
+
+      if (iter==1) {
+        stencil_time = prk::wtime();
+        counters.start();
+        prk::cold::start();
+      }
       // Apply the stencil operator
       stencil(n, tile_size, in, out);
       // Add constant to solution to force refresh of neighbor data, if any
-      std::transform(in.begin(), in.end(), in.begin(), [](double c) { return c+=1.0; });
+      std::transform(in.begin(), in.end(), in.begin(), [](T c) { return c+=U(1); });
     }
-    stencil_time = prk::wtime() - stencil_time;
+    stencil_time = prk::wtime() - stencil_time - prk::cold::elapsed();
+    counters.stop();
   }
 
   //////////////////////////////////////////////////////////////////////
@@ -200,16 +193,16 @@ int main(int argc, char* argv[])
 
   // compute L1 norm in parallel
   double norm = 0.0;
-  for (auto i=radius; i<n-radius; i++) {
-    for (auto j=radius; j<n-radius; j++) {
-      norm += std::fabs(out[i*n+j]);
+  for (int64_t i=radius; i<n-radius; i++) {
+    for (int64_t j=radius; j<n-radius; j++) {
+      norm += std::fabs(static_cast<double>(out[i*n+j]));
     }
   }
   norm /= active_points;
 
   // verify correctness
-  const double epsilon = 1.0e-8;
-  double reference_norm = 2.*(iterations+1.);
+  double reference_norm = 2.*(iterations+1.)*scale;
+  const double epsilon = traits::epsilon * (std::is_same<T,double>::value ? 1.0 : reference_norm);
   if (std::fabs(norm-reference_norm) > epsilon) {
     std::cout << "ERROR: L1 norm = " << norm
               << " Reference L1 norm = " << reference_norm << std::endl;
@@ -225,7 +218,93 @@ int main(int argc, char* argv[])
     auto avgtime = stencil_time/iterations;
     std::cout << "Rate (MFlops/s): " << 1.0e-6 * static_cast<double>(flops)/avgtime
               << " Avg time (s): " << avgtime << std::endl;
+    // in and out are streamed by the stencil, in again by the update
+    const prk::work_model work{static_cast<double>(flops), 4.0*n*n*sizeof(T)};
+    counters.print(iterations*work.bytes, iterations*work.flops);
+    prk::roofline::print(work, avgtime);
   }
 
   return 0;
 }
+
+int main(int argc, char* argv[])
+{
+  std::cout << "Parallel Research Kernels version " << PRKVERSION << std::endl;
+  std::cout << "C++11 Stencil execution on 2D grid" << std::endl;
+
+  //////////////////////////////////////////////////////////////////////
+  // Process and test input parameters
+  //////////////////////////////////////////////////////////////////////
+
+  int iterations, radius;
+  int64_t n, tile_size;
+  bool star = true;
+  bool autotune = false;
+  prk::precision precision;
+  try {
+      prk::cold::parse(argc, argv);
+
+      if (argc < 3) {
+        throw "Usage: <# iterations> <array dimension> [<tile_size|auto> <star/grid> <radius>]";
+      }
+
+      // number of times to run the algorithm
+      iterations  = std::atoi(argv[1]);
+      if (iterations < 1) {
+        throw "ERROR: iterations must be >= 1";
+      }
+
+      // linear grid dimension
+      n  = std::atoll(argv[2]);
+      if (n < 1) {
+        throw "ERROR: grid dimension must be positive";
+      } else if (n > std::floor(std::sqrt(INT64_MAX))) {
+        throw "ERROR: grid dimension too large - overflow risk";
+      }
+
+      // default tile size for tiling of local transpose
+      tile_size = 32;
+      autotune = (argc > 3) && std::string(argv[3]) == "auto";
+      if (argc > 3 && !autotune) {
+          tile_size = std::atoll(argv[3]);
+          if (tile_size <= 0) tile_size = n;
+          if (tile_size > n) tile_size = n;
+      }
+
+      // stencil pattern
+      if (argc > 4) {
+          auto stencil = std::string(argv[4]);
+          auto grid = std::string("grid");
+          star = (stencil == grid) ? false : true;
+      }
+
+      // stencil radius
+      radius = 2;
+      if (argc > 5) {
+          radius = std::atoi(argv[5]);
+      }
+
+      if ( (radius < 1) || (2*radius+1 > n) ) {
+        throw "ERROR: Stencil radius negative or too large";
+      }
+
+      precision = prk::get_precision();
+  }
+  catch (const char * e) {
+    std::cout << e << std::endl;
+    return 1;
+  }
+
+  std::cout << "Number of iterations = " << iterations << std::endl;
+  prk::cold::print();
+  std::cout << "Grid size            = " << n << std::endl;
+  std::cout << "Type of stencil      = " << (star ? "star" : "grid") << std::endl;
+  std::cout << "Radius of stencil    = " << radius << std::endl;
+
+  switch (precision) {
+      case prk::precision::fp32: return stencil<float>(iterations, n, radius, tile_size, star, autotune);
+      case prk::precision::bf16: return stencil<prk::bf16>(iterations, n, radius, tile_size, star, autotune);
+      case prk::precision::fp16: return stencil<prk::fp16>(iterations, n, radius, tile_size, star, autotune);
+      default:                   return stencil<double>(iterations, n, radius, tile_size, star, autotune);
+  }
+}
@@ -1,6 +1,6 @@
-void star1(const int n, const int t, matrix & in, matrix & out) {
+void star1(const int64_t n, const int64_t t, matrix & in, matrix & out) {
     auto inside = Kokkos::MDRangePolicy<Kokkos::Rank<2>>({1,1},{n-1,n-1},{t,t});
-    Kokkos::parallel_for(inside, KOKKOS_LAMBDA(int i, int j) {
+    Kokkos::parallel_for(inside, KOKKOS_LAMBDA(int64_t i, int64_t j) {
               out(i,j) += +in(i,j-1) * -0.5
                           +in(i-1,j) * -0.5
                           +in(i+1,j) * 0.5
@@ -8,9 +8,9 @@ void star1(const int n, const int t, matrix & in, matrix & out) {
     });
 }
 
-void star2(const int n, const int t, matrix & in, matrix & out) {
+void star2(const int64_t n, const int64_t t, matrix & in, matrix & out) {
     auto inside = Kokkos::MDRangePolicy<Kokkos::Rank<2>>({2,2},{n-2,n-2},{t,t});
-    Kokkos::parallel_for(inside, KOKKOS_LAMBDA(int i, int j) {
+    Kokkos::parallel_for(inside, KOKKOS_LAMBDA(int64_t i, int64_t j) {
               out(i,j) += +in(i,j-2) * -0.125
                           +in(i,j-1) * -0.25
                           +in(i-2,j) * -0.125
@@ -22,9 +22,9 @@ void star2(const int n, const int t, matrix & in, matrix & out) {
     });
 }
 
-void star3(const int n, const int t, matrix & in, matrix & out) {
+void star3(const int64_t n, const int64_t t, matrix & in, matrix & out) {
     auto inside = Kokkos::MDRangePolicy<Kokkos::Rank<2>>({3,3},{n-3,n-3},{t,t});
-    Kokkos::parallel_for(inside, KOKKOS_LAMBDA(int i, int j) {
+    Kokkos::parallel_for(inside, KOKKOS_LAMBDA(int64_t i, int64_t j) {
               out(i,j) += +in(i,j-3) * -0.0555555555556
                           +in(i,j-2) * -0.0833333333333
                           +in(i,j-1) * -0.166666666667
@@ -40,9 +40,9 @@ void star3(const int n, const int t, matrix & in, matrix & out) {
     });
 }
 
-void star4(const int n, const int t, matrix & in, matrix & out) {
+void star4(const int64_t n, const int64_t t, matrix & in, matrix & out) {
     auto inside = Kokkos::MDRangePolicy<Kokkos::Rank<2>>({4,4},{n-4,n-4},{t,t});
-    Kokkos::parallel_for(inside, KOKKOS_LAMBDA(int i, int j) {
+    Kokkos::parallel_for(inside, KOKKOS_LAMBDA(int64_t i, int64_t j) {
               out(i,j) += +in(i,j-4) * -0.03125
                           +in(i,j-3) * -0.0416666666667
                           +in(i,j-2) * -0.0625
@@ -62,9 +62,9 @@ void star4(const int n, const int t, matrix & in, matrix & out) {
     });
 }
 
-void star5(const int n, const int t, matrix & in, matrix & out) {
+void star5(const int64_t n, const int64_t t, matrix & in, matrix & out) {
     auto inside = Kokkos::MDRangePolicy<Kokkos::Rank<2>>({5,5},{n-5,n-5},{t,t});
-    Kokkos::parallel_for(inside, KOKKOS_LAMBDA(int i, int j) {
+    Kokkos::parallel_for(inside, KOKKOS_LAMBDA(int64_t i, int64_t j) {
               out(i,j) += +in(i,j-5) * -0.02
                           +in(i,j-4) * -0.025
                           +in(i,j-3) * -0.0333333333333
@@ -88,9 +88,9 @@ void star5(const int n, const int t, matrix & in, matrix & out) {
     });
 }
 
-void grid1(const int n, const int t, matrix & in, matrix & out) {
+void grid1(const int64_t n, const int64_t t, matrix & in, matrix & out) {
     auto inside = Kokkos::MDRangePolicy<Kokkos::Rank<2>>({1,1},{n-1,n-1},{t,t});
-    Kokkos::parallel_for(inside, KOKKOS_LAMBDA(int i, int j) {
+    Kokkos::parallel_for(inside, KOKKOS_LAMBDA(int64_t i, int64_t j) {
               out(i,j) += +in(i-1,j-1) * -0.25
                           +in(i,j-1) * -0.25
                           +in(i-1,j) * -0.25
@@ -101,9 +101,9 @@ void grid1(const int n, const int t, matrix & in, matrix & out) {
     });
 }
 
-void grid2(const int n, const int t, matrix & in, matrix & out) {
+void grid2(const int64_t n, const int64_t t, matrix & in, matrix & out) {
     auto inside = Kokkos::MDRangePolicy<Kokkos::Rank<2>>({2,2},{n-2,n-2},{t,t});
-    Kokkos::parallel_for(inside, KOKKOS_LAMBDA(int i, int j) {
+    Kokkos::parallel_for(inside, KOKKOS_LAMBDA(int64_t i, int64_t j) {
               out(i,j) += +in(i-2,j-2) * -0.0625
                           +in(i-1,j-2) * -0.0208333333333
                           +in(i,j-2) * -0.0208333333333
@@ -128,9 +128,9 @@ void grid2(const int n, const int t, matrix & in, matrix & out) {
     });
 }
 
-void grid3(const int n, const int t, matrix & in, matrix & out) {
+void grid3(const int64_t n, const int64_t t, matrix & in, matrix & out) {
     auto inside = Kokkos::MDRangePolicy<Kokkos::Rank<2>>({3,3},{n-3,n-3},{t,t});
-    Kokkos::parallel_for(inside, KOKKOS_LAMBDA(int i, int j) {
+    Kokkos::parallel_for(inside, KOKKOS_LAMBDA(int64_t i, int64_t j) {
               out(i,j) += +in(i-3,j-3) * -0.0277777777778
                           +in(i-2,j-3) * -0.00555555555556
                           +in(i-1,j-3) * -0.00555555555556
@@ -177,9 +177,9 @@ void grid3(const int n, const int t, matrix & in, matrix & out) {
     });
 }
 
-void grid4(const int n, const int t, matrix & in, matrix & out) {
+void grid4(const int64_t n, const int64_t t, matrix & in, matrix & out) {
     auto inside = Kokkos::MDRangePolicy<Kokkos::Rank<2>>({4,4},{n-4,n-4},{t,t});
-    Kokkos::parallel_for(inside, KOKKOS_LAMBDA(int i, int j) {
+    Kokkos::parallel_for(inside, KOKKOS_LAMBDA(int64_t i, int64_t j) {
               out(i,j) += +in(i-4,j-4) * -0.015625
                           +in(i-3,j-4) * -0.00223214285714
                           +in(i-2,j-4) * -0.00223214285714
@@ -256,9 +256,9 @@ void grid4(const int n, const int t, matrix & in, matrix & out) {
     });
 }
 
-void grid5(const int n, const int t, matrix & in, matrix & out) {
+void grid5(const int64_t n, const int64_t t, matrix & in, matrix & out) {
     auto inside = Kokkos::MDRangePolicy<Kokkos::Rank<2>>({5,5},{n-5,n-5},{t,t});
-    Kokkos::parallel_for(inside, KOKKOS_LAMBDA(int i, int j) {
+    Kokkos::parallel_for(inside, KOKKOS_LAMBDA(int64_t i, int64_t j) {
               out(i,j) += +in(i-5,j-5) * -0.01
                           +in(i-4,j-5) * -0.00111111111111
                           +in(i-3,j-5) * -0.00111111111111
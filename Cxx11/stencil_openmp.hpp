@@ -1,7 +1,7 @@
-void star1(const int n, const int t, const double * RESTRICT in, double * RESTRICT out) {
+void star1(const int64_t n, const int64_t t, const double * RESTRICT in, double * RESTRICT out) {
     OMP_FOR(collapse(2))
-    for (auto it=1; it<n-1; it+=t) {
-      for (auto jt=1; jt<n-1; jt+=t) {
+    for (int64_t it=1; it<n-1; it+=t) {
+      for (int64_t jt=1; jt<n-1; jt+=t) {
         for (auto i=it; i<std::min(n-1,it+t); ++i) {
           OMP_SIMD
           for (auto j=jt; j<std::min(n-1,jt+t); ++j) {
@@ -15,10 +15,10 @@ void star1(const int n, const int t, const double * RESTRICT in, double * RESTRI
      }
 }
 
-void star2(const int n, const int t, const double * RESTRICT in, double * RESTRICT out) {
+void star2(const int64_t n, const int64_t t, const double * RESTRICT in, double * RESTRICT out) {
     OMP_FOR(collapse(2))
-    for (auto it=2; it<n-2; it+=t) {
-      for (auto jt=2; jt<n-2; jt+=t) {
+    for (int64_t it=2; it<n-2; it+=t) {
+      for (int64_t jt=2; jt<n-2; jt+=t) {
         for (auto i=it; i<std::min(n-2,it+t); ++i) {
           OMP_SIMD
           for (auto j=jt; j<std::min(n-2,jt+t); ++j) {
@@ -36,10 +36,10 @@ void star2(const int n, const int t, const double * RESTRICT in, double * RESTRI
      }
 }
 
-void star3(const int n, const int t, const double * RESTRICT in, double * RESTRICT out) {
+void star3(const int64_t n, const int64_t t, const double * RESTRICT in, double * RESTRICT out) {
     OMP_FOR(collapse(2))
-    for (auto it=3; it<n-3; it+=t) {
-      for (auto jt=3; jt<n-3; jt+=t) {
+    for (int64_t it=3; it<n-3; it+=t) {
+      for (int64_t jt=3; jt<n-3; jt+=t) {
         for (auto i=it; i<std::min(n-3,it+t); ++i) {
           OMP_SIMD
           for (auto j=jt; j<std::min(n-3,jt+t); ++j) {
@@ -61,10 +61,10 @@ void star3(const int n, const int t, const double * RESTRICT in, double * RESTRI
      }
 }
 
-void star4(const int n, const int t, const double * RESTRICT in, double * RESTRICT out) {
+void star4(const int64_t n, const int64_t t, const double * RESTRICT in, double * RESTRICT out) {
     OMP_FOR(collapse(2))
-    for (auto it=4; it<n-4; it+=t) {
-      for (auto jt=4; jt<n-4; jt+=t) {
+    for (int64_t it=4; it<n-4; it+=t) {
+      for (int64_t jt=4; jt<n-4; jt+=t) {
         for (auto i=it; i<std::min(n-4,it+t); ++i) {
           OMP_SIMD
           for (auto j=jt; j<std::min(n-4,jt+t); ++j) {
@@ -90,10 +90,10 @@ void star4(const int n, const int t, const double * RESTRICT in, double * RESTRI
      }
 }
 
-void star5(const int n, const int t, const double * RESTRICT in, double * RESTRICT out) {
+void star5(const int64_t n, const int64_t t, const double * RESTRICT in, double * RESTRICT out) {
     OMP_FOR(collapse(2))
-    for (auto it=5; it<n-5; it+=t) {
-      for (auto jt=5; jt<n-5; jt+=t) {
+    for (int64_t it=5; it<n-5; it+=t) {
+      for (int64_t jt=5; jt<n-5; jt+=t) {
         for (auto i=it; i<std::min(n-5,it+t); ++i) {
           OMP_SIMD
           for (auto j=jt; j<std::min(n-5,jt+t); ++j) {
@@ -123,10 +123,10 @@ void star5(const int n, const int t, const double * RESTRICT in, double * RESTRI
      }
 }
 
-void grid1(const int n, const int t, const double * RESTRICT in, double * RESTRICT out) {
+void grid1(const int64_t n, const int64_t t, const double * RESTRICT in, double * RESTRICT out) {
     OMP_FOR(collapse(2))
-    for (auto it=1; it<n-1; it+=t) {
-      for (auto jt=1; jt<n-1; jt+=t) {
+    for (int64_t it=1; it<n-1; it+=t) {
+      for (int64_t jt=1; jt<n-1; jt+=t) {
         for (auto i=it; i<std::min(n-1,it+t); ++i) {
           OMP_SIMD
           for (auto j=jt; j<std::min(n-1,jt+t); ++j) {
@@ -143,10 +143,10 @@ void grid1(const int n, const int t, const double * RESTRICT in, double * RESTRI
      }
 }
 
-void grid2(const int n, const int t, const double * RESTRICT in, double * RESTRICT out) {
+void grid2(const int64_t n, const int64_t t, const double * RESTRICT in, double * RESTRICT out) {
     OMP_FOR(collapse(2))
-    for (auto it=2; it<n-2; it+=t) {
-      for (auto jt=2; jt<n-2; jt+=t) {
+    for (int64_t it=2; it<n-2; it+=t) {
+      for (int64_t jt=2; jt<n-2; jt+=t) {
         for (auto i=it; i<std::min(n-2,it+t); ++i) {
           OMP_SIMD
           for (auto j=jt; j<std::min(n-2,jt+t); ++j) {
@@ -177,10 +177,10 @@ void grid2(const int n, const int t, const double * RESTRICT in, double * RESTRI
      }
 }
 
-void grid3(const int n, const int t, const double * RESTRICT in, double * RESTRICT out) {
+void grid3(const int64_t n, const int64_t t, const double * RESTRICT in, double * RESTRICT out) {
     OMP_FOR(collapse(2))
-    for (auto it=3; it<n-3; it+=t) {
-      for (auto jt=3; jt<n-3; jt+=t) {
+    for (int64_t it=3; it<n-3; it+=t) {
+      for (int64_t jt=3; jt<n-3; jt+=t) {
         for (auto i=it; i<std::min(n-3,it+t); ++i) {
           OMP_SIMD
           for (auto j=jt; j<std::min(n-3,jt+t); ++j) {
@@ -233,10 +233,10 @@ void grid3(const int n, const int t, const double * RESTRICT in, double * RESTRI
      }
 }
 
-void grid4(const int n, const int t, const double * RESTRICT in, double * RESTRICT out) {
+void grid4(const int64_t n, const int64_t t, const double * RESTRICT in, double * RESTRICT out) {
     OMP_FOR(collapse(2))
-    for (auto it=4; it<n-4; it+=t) {
-      for (auto jt=4; jt<n-4; jt+=t) {
+    for (int64_t it=4; it<n-4; it+=t) {
+      for (int64_t jt=4; jt<n-4; jt+=t) {
         for (auto i=it; i<std::min(n-4,it+t); ++i) {
           OMP_SIMD
           for (auto j=jt; j<std::min(n-4,jt+t); ++j) {
@@ -319,10 +319,10 @@ void grid4(const int n, const int t, const double * RESTRICT in, double * RESTRI
      }
 }
 
-void grid5(const int n, const int t, const double * RESTRICT in, double * RESTRICT out) {
+void grid5(const int64_t n, const int64_t t, const double * RESTRICT in, double * RESTRICT out) {
     OMP_FOR(collapse(2))
-    for (auto it=5; it<n-5; it+=t) {
-      for (auto jt=5; jt<n-5; jt+=t) {
+    for (int64_t it=5; it<n-5; it+=t) {
+      for (int64_t jt=5; jt<n-5; jt+=t) {
         for (auto i=it; i<std::min(n-5,it+t); ++i) {
           OMP_SIMD
           for (auto j=jt; j<std::min(n-5,jt+t); ++j) {
@@ -1,4 +1,4 @@
-void star1(const int n, const int t, std::vector<double> & in, std::vector<double> & out) {
+void star1(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out) {
     RAJA::forall<thread_exec>(RAJA::Index_type(1), RAJA::Index_type(n-1), [&](RAJA::Index_type i) {
       RAJA::forall<RAJA::simd_exec>(RAJA::Index_type(1), RAJA::Index_type(n-1), [&](RAJA::Index_type j) {
             out[i*n+j] += +in[(i)*n+(j-1)] * -0.5
@@ -9,7 +9,7 @@ void star1(const int n, const int t, std::vector<double> & in, std::vector<doubl
     });
 }
 
-void star2(const int n, const int t, std::vector<double> & in, std::vector<double> & out) {
+void star2(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out) {
     RAJA::forall<thread_exec>(RAJA::Index_type(2), RAJA::Index_type(n-2), [&](RAJA::Index_type i) {
       RAJA::forall<RAJA::simd_exec>(RAJA::Index_type(2), RAJA::Index_type(n-2), [&](RAJA::Index_type j) {
             out[i*n+j] += +in[(i)*n+(j-2)] * -0.125
@@ -24,7 +24,7 @@ void star2(const int n, const int t, std::vector<double> & in, std::vector<doubl
     });
 }
 
-void star3(const int n, const int t, std::vector<double> & in, std::vector<double> & out) {
+void star3(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out) {
     RAJA::forall<thread_exec>(RAJA::Index_type(3), RAJA::Index_type(n-3), [&](RAJA::Index_type i) {
       RAJA::forall<RAJA::simd_exec>(RAJA::Index_type(3), RAJA::Index_type(n-3), [&](RAJA::Index_type j) {
             out[i*n+j] += +in[(i)*n+(j-3)] * -0.0555555555556
@@ -43,7 +43,7 @@ void star3(const int n, const int t, std::vector<double> & in, std::vector<doubl
     });
 }
 
-void star4(const int n, const int t, std::vector<double> & in, std::vector<double> & out) {
+void star4(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out) {
     RAJA::forall<thread_exec>(RAJA::Index_type(4), RAJA::Index_type(n-4), [&](RAJA::Index_type i) {
       RAJA::forall<RAJA::simd_exec>(RAJA::Index_type(4), RAJA::Index_type(n-4), [&](RAJA::Index_type j) {
             out[i*n+j] += +in[(i)*n+(j-4)] * -0.03125
@@ -66,7 +66,7 @@ void star4(const int n, const int t, std::vector<double> & in, std::vector<doubl
     });
 }
 
-void star5(const int n, const int t, std::vector<double> & in, std::vector<double> & out) {
+void star5(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out) {
     RAJA::forall<thread_exec>(RAJA::Index_type(5), RAJA::Index_type(n-5), [&](RAJA::Index_type i) {
       RAJA::forall<RAJA::simd_exec>(RAJA::Index_type(5), RAJA::Index_type(n-5), [&](RAJA::Index_type j) {
             out[i*n+j] += +in[(i)*n+(j-5)] * -0.02
@@ -93,7 +93,7 @@ void star5(const int n, const int t, std::vector<double> & in, std::vector<doubl
     });
 }
 
-void grid1(const int n, const int t, std::vector<double> & in, std::vector<double> & out) {
+void grid1(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out) {
     RAJA::forall<thread_exec>(RAJA::Index_type(1), RAJA::Index_type(n-1), [&](RAJA::Index_type i) {
       RAJA::forall<RAJA::simd_exec>(RAJA::Index_type(1), RAJA::Index_type(n-1), [&](RAJA::Index_type j) {
             out[i*n+j] += +in[(i-1)*n+(j-1)] * -0.25
@@ -107,7 +107,7 @@ void grid1(const int n, const int t, std::vector<double> & in, std::vector<doubl
     });
 }
 
-void grid2(const int n, const int t, std::vector<double> & in, std::vector<double> & out) {
+void grid2(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out) {
     RAJA::forall<thread_exec>(RAJA::Index_type(2), RAJA::Index_type(n-2), [&](RAJA::Index_type i) {
       RAJA::forall<RAJA::simd_exec>(RAJA::Index_type(2), RAJA::Index_type(n-2), [&](RAJA::Index_type j) {
             out[i*n+j] += +in[(i-2)*n+(j-2)] * -0.0625
@@ -135,7 +135,7 @@ void grid2(const int n, const int t, std::vector<double> & in, std::vector<doubl
     });
 }
 
-void grid3(const int n, const int t, std::vector<double> & in, std::vector<double> & out) {
+void grid3(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out) {
     RAJA::forall<thread_exec>(RAJA::Index_type(3), RAJA::Index_type(n-3), [&](RAJA::Index_type i) {
       RAJA::forall<RAJA::simd_exec>(RAJA::Index_type(3), RAJA::Index_type(n-3), [&](RAJA::Index_type j) {
             out[i*n+j] += +in[(i-3)*n+(j-3)] * -0.0277777777778
@@ -185,7 +185,7 @@ void grid3(const int n, const int t, std::vector<double> & in, std::vector<doubl
     });
 }
 
-void grid4(const int n, const int t, std::vector<double> & in, std::vector<double> & out) {
+void grid4(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out) {
     RAJA::forall<thread_exec>(RAJA::Index_type(4), RAJA::Index_type(n-4), [&](RAJA::Index_type i) {
       RAJA::forall<RAJA::simd_exec>(RAJA::Index_type(4), RAJA::Index_type(n-4), [&](RAJA::Index_type j) {
             out[i*n+j] += +in[(i-4)*n+(j-4)] * -0.015625
@@ -265,7 +265,7 @@ void grid4(const int n, const int t, std::vector<double> & in, std::vector<doubl
     });
 }
 
-void grid5(const int n, const int t, std::vector<double> & in, std::vector<double> & out) {
+void grid5(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out) {
     RAJA::forall<thread_exec>(RAJA::Index_type(5), RAJA::Index_type(n-5), [&](RAJA::Index_type i) {
       RAJA::forall<RAJA::simd_exec>(RAJA::Index_type(5), RAJA::Index_type(n-5), [&](RAJA::Index_type j) {
             out[i*n+j] += +in[(i-5)*n+(j-5)] * -0.01
@@ -1,9 +1,9 @@
 #define RESTRICT __restrict__
 
-void star1(const int n, const int t, const double * RESTRICT in, double * RESTRICT out) {
+void star1(const int64_t n, const int64_t t, const double * RESTRICT in, double * RESTRICT out) {
     OMP_TARGET( teams distribute parallel for simd collapse(2) schedule(static,1) )
-    for (auto i=1; i<n-1; ++i) {
-      for (auto j=1; j<n-1; ++j) {
+    for (int64_t i=1; i<n-1; ++i) {
+      for (int64_t j=1; j<n-1; ++j) {
             out[i*n+j] += +in[(i)*n+(j-1)] * -0.5
                           +in[(i-1)*n+(j)] * -0.5
                           +in[(i+1)*n+(j)] * 0.5
@@ -12,10 +12,10 @@ void star1(const int n, const int t, const double * RESTRICT in, double * RESTRI
      }
 }
 
-void star2(const int n, const int t, const double * RESTRICT in, double * RESTRICT out) {
+void star2(const int64_t n, const int64_t t, const double * RESTRICT in, double * RESTRICT out) {
     OMP_TARGET( teams distribute parallel for simd collapse(2) schedule(static,1) )
-    for (auto i=2; i<n-2; ++i) {
-      for (auto j=2; j<n-2; ++j) {
+    for (int64_t i=2; i<n-2; ++i) {
+      for (int64_t j=2; j<n-2; ++j) {
             out[i*n+j] += +in[(i)*n+(j-2)] * -0.125
                           +in[(i)*n+(j-1)] * -0.25
                           +in[(i-2)*n+(j)] * -0.125
@@ -28,10 +28,10 @@ void star2(const int n, const int t, const double * RESTRICT in, double * RESTRI
      }
 }
 
-void star3(const int n, const int t, const double * RESTRICT in, double * RESTRICT out) {
+void star3(const int64_t n, const int64_t t, const double * RESTRICT in, double * RESTRICT out) {
     OMP_TARGET( teams distribute parallel for simd collapse(2) schedule(static,1) )
-    for (auto i=3; i<n-3; ++i) {
-      for (auto j=3; j<n-3; ++j) {
+    for (int64_t i=3; i<n-3; ++i) {
+      for (int64_t j=3; j<n-3; ++j) {
             out[i*n+j] += +in[(i)*n+(j-3)] * -0.0555555555556
                           +in[(i)*n+(j-2)] * -0.0833333333333
                           +in[(i)*n+(j-1)] * -0.166666666667
@@ -48,10 +48,10 @@ void star3(const int n, const int t, const double * RESTRICT in, double * RESTRI
      }
 }
 
-void star4(const int n, const int t, const double * RESTRICT in, double * RESTRICT out) {
+void star4(const int64_t n, const int64_t t, const double * RESTRICT in, double * RESTRICT out) {
     OMP_TARGET( teams distribute parallel for simd collapse(2) schedule(static,1) )
-    for (auto i=4; i<n-4; ++i) {
-      for (auto j=4; j<n-4; ++j) {
+    for (int64_t i=4; i<n-4; ++i) {
+      for (int64_t j=4; j<n-4; ++j) {
             out[i*n+j] += +in[(i)*n+(j-4)] * -0.03125
                           +in[(i)*n+(j-3)] * -0.0416666666667
                           +in[(i)*n+(j-2)] * -0.0625
@@ -72,10 +72,10 @@ void star4(const int n, const int t, const double * RESTRICT in, double * RESTRI
      }
 }
 
-void star5(const int n, const int t, const double * RESTRICT in, double * RESTRICT out) {
+void star5(const int64_t n, const int64_t t, const double * RESTRICT in, double * RESTRICT out) {
     OMP_TARGET( teams distribute parallel for simd collapse(2) schedule(static,1) )
-    for (auto i=5; i<n-5; ++i) {
-      for (auto j=5; j<n-5; ++j) {
+    for (int64_t i=5; i<n-5; ++i) {
+      for (int64_t j=5; j<n-5; ++j) {
             out[i*n+j] += +in[(i)*n+(j-5)] * -0.02
                           +in[(i)*n+(j-4)] * -0.025
                           +in[(i)*n+(j-3)] * -0.0333333333333
@@ -100,10 +100,10 @@ void star5(const int n, const int t, const double * RESTRICT in, double * RESTRI
      }
 }
 
-void grid1(const int n, const int t, const double * RESTRICT in, double * RESTRICT out) {
+void grid1(const int64_t n, const int64_t t, const double * RESTRICT in, double * RESTRICT out) {
     OMP_TARGET( teams distribute parallel for simd collapse(2) schedule(static,1) )
-    for (auto i=1; i<n-1; ++i) {
-      for (auto j=1; j<n-1; ++j) {
+    for (int64_t i=1; i<n-1; ++i) {
+      for (int64_t j=1; j<n-1; ++j) {
             out[i*n+j] += +in[(i-1)*n+(j-1)] * -0.25
                           +in[(i)*n+(j-1)] * -0.25
                           +in[(i-1)*n+(j)] * -0.25
@@ -115,10 +115,10 @@ void grid1(const int n, const int t, const double * RESTRICT in, double * RESTRI
      }
 }
 
-void grid2(const int n, const int t, const double * RESTRICT in, double * RESTRICT out) {
+void grid2(const int64_t n, const int64_t t, const double * RESTRICT in, double * RESTRICT out) {
     OMP_TARGET( teams distribute parallel for simd collapse(2) schedule(static,1) )
-    for (auto i=2; i<n-2; ++i) {
-      for (auto j=2; j<n-2; ++j) {
+    for (int64_t i=2; i<n-2; ++i) {
+      for (int64_t j=2; j<n-2; ++j) {
             out[i*n+j] += +in[(i-2)*n+(j-2)] * -0.0625
                           +in[(i-1)*n+(j-2)] * -0.0208333333333
                           +in[(i)*n+(j-2)] * -0.0208333333333
@@ -144,10 +144,10 @@ void grid2(const int n, const int t, const double * RESTRICT in, double * RESTRI
      }
 }
 
-void grid3(const int n, const int t, const double * RESTRICT in, double * RESTRICT out) {
+void grid3(const int64_t n, const int64_t t, const double * RESTRICT in, double * RESTRICT out) {
     OMP_TARGET( teams distribute parallel for simd collapse(2) schedule(static,1) )
-    for (auto i=3; i<n-3; ++i) {
-      for (auto j=3; j<n-3; ++j) {
+    for (int64_t i=3; i<n-3; ++i) {
+      for (int64_t j=3; j<n-3; ++j) {
             out[i*n+j] += +in[(i-3)*n+(j-3)] * -0.0277777777778
                           +in[(i-2)*n+(j-3)] * -0.00555555555556
                           +in[(i-1)*n+(j-3)] * -0.00555555555556
@@ -195,10 +195,10 @@ void grid3(const int n, const int t, const double * RESTRICT in, double * RESTRI
      }
 }
 
-void grid4(const int n, const int t, const double * RESTRICT in, double * RESTRICT out) {
+void grid4(const int64_t n, const int64_t t, const double * RESTRICT in, double * RESTRICT out) {
     OMP_TARGET( teams distribute parallel for simd collapse(2) schedule(static,1) )
-    for (auto i=4; i<n-4; ++i) {
-      for (auto j=4; j<n-4; ++j) {
+    for (int64_t i=4; i<n-4; ++i) {
+      for (int64_t j=4; j<n-4; ++j) {
             out[i*n+j] += +in[(i-4)*n+(j-4)] * -0.015625
                           +in[(i-3)*n+(j-4)] * -0.00223214285714
                           +in[(i-2)*n+(j-4)] * -0.00223214285714
@@ -276,10 +276,10 @@ void grid4(const int n, const int t, const double * RESTRICT in, double * RESTRI
      }
 }
 
-void grid5(const int n, const int t, const double * RESTRICT in, double * RESTRICT out) {
+void grid5(const int64_t n, const int64_t t, const double * RESTRICT in, double * RESTRICT out) {
     OMP_TARGET( teams distribute parallel for simd collapse(2) schedule(static,1) )
-    for (auto i=5; i<n-5; ++i) {
-      for (auto j=5; j<n-5; ++j) {
+    for (int64_t i=5; i<n-5; ++i) {
+      for (int64_t j=5; j<n-5; ++j) {
             out[i*n+j] += +in[(i-5)*n+(j-5)] * -0.01
                           +in[(i-4)*n+(j-5)] * -0.00111111111111
                           +in[(i-3)*n+(j-5)] * -0.00111111111111
@@ -1,7 +1,8 @@
-void star1(const int n, const int t, std::vector<double> & in, std::vector<double> & out, const int gs) {
+void star1(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out, const int gs) {
     OMP_TASKLOOP_COLLAPSE(2, firstprivate(n) shared(in,out) grainsize(gs) )
-    for (auto it=1; it<n-1; it+=t) {
-      for (auto jt=1; jt<n-1; jt+=t) {
+    for (int64_t it=1; it<n-1; it+=t) {
+      for (int64_t jt=1; jt<n-1; jt+=t) {
+        PRK_TRACE_SCOPE("star1", it, jt);
         for (auto i=it; i<std::min(n-1,it+t); ++i) {
           OMP_SIMD
           for (auto j=jt; j<std::min(n-1,jt+t); ++j) {
@@ -15,10 +16,11 @@ void star1(const int n, const int t, std::vector<double> & in, std::vector<doubl
      }
 }
 
-void star2(const int n, const int t, std::vector<double> & in, std::vector<double> & out, const int gs) {
+void star2(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out, const int gs) {
     OMP_TASKLOOP_COLLAPSE(2, firstprivate(n) shared(in,out) grainsize(gs) )
-    for (auto it=2; it<n-2; it+=t) {
-      for (auto jt=2; jt<n-2; jt+=t) {
+    for (int64_t it=2; it<n-2; it+=t) {
+      for (int64_t jt=2; jt<n-2; jt+=t) {
+        PRK_TRACE_SCOPE("star2", it, jt);
         for (auto i=it; i<std::min(n-2,it+t); ++i) {
           OMP_SIMD
           for (auto j=jt; j<std::min(n-2,jt+t); ++j) {
@@ -36,10 +38,11 @@ void star2(const int n, const int t, std::vector<double> & in, std::vector<doubl
      }
 }
 
-void star3(const int n, const int t, std::vector<double> & in, std::vector<double> & out, const int gs) {
+void star3(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out, const int gs) {
     OMP_TASKLOOP_COLLAPSE(2, firstprivate(n) shared(in,out) grainsize(gs) )
-    for (auto it=3; it<n-3; it+=t) {
-      for (auto jt=3; jt<n-3; jt+=t) {
+    for (int64_t it=3; it<n-3; it+=t) {
+      for (int64_t jt=3; jt<n-3; jt+=t) {
+        PRK_TRACE_SCOPE("star3", it, jt);
         for (auto i=it; i<std::min(n-3,it+t); ++i) {
           OMP_SIMD
           for (auto j=jt; j<std::min(n-3,jt+t); ++j) {
@@ -61,10 +64,11 @@ void star3(const int n, const int t, std::vector<double> & in, std::vector<doubl
      }
 }
 
-void star4(const int n, const int t, std::vector<double> & in, std::vector<double> & out, const int gs) {
+void star4(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out, const int gs) {
     OMP_TASKLOOP_COLLAPSE(2, firstprivate(n) shared(in,out) grainsize(gs) )
-    for (auto it=4; it<n-4; it+=t) {
-      for (auto jt=4; jt<n-4; jt+=t) {
+    for (int64_t it=4; it<n-4; it+=t) {
+      for (int64_t jt=4; jt<n-4; jt+=t) {
+        PRK_TRACE_SCOPE("star4", it, jt);
         for (auto i=it; i<std::min(n-4,it+t); ++i) {
           OMP_SIMD
           for (auto j=jt; j<std::min(n-4,jt+t); ++j) {
@@ -90,10 +94,11 @@ void star4(const int n, const int t, std::vector<double> & in, std::vector<doubl
      }
 }
 
-void star5(const int n, const int t, std::vector<double> & in, std::vector<double> & out, const int gs) {
+void star5(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out, const int gs) {
     OMP_TASKLOOP_COLLAPSE(2, firstprivate(n) shared(in,out) grainsize(gs) )
-    for (auto it=5; it<n-5; it+=t) {
-      for (auto jt=5; jt<n-5; jt+=t) {
+    for (int64_t it=5; it<n-5; it+=t) {
+      for (int64_t jt=5; jt<n-5; jt+=t) {
+        PRK_TRACE_SCOPE("star5", it, jt);
         for (auto i=it; i<std::min(n-5,it+t); ++i) {
           OMP_SIMD
           for (auto j=jt; j<std::min(n-5,jt+t); ++j) {
@@ -123,10 +128,11 @@ void star5(const int n, const int t, std::vector<double> & in, std::vector<doubl
      }
 }
 
-void grid1(const int n, const int t, std::vector<double> & in, std::vector<double> & out, const int gs) {
+void grid1(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out, const int gs) {
     OMP_TASKLOOP_COLLAPSE(2, firstprivate(n) shared(in,out) grainsize(gs) )
-    for (auto it=1; it<n-1; it+=t) {
-      for (auto jt=1; jt<n-1; jt+=t) {
+    for (int64_t it=1; it<n-1; it+=t) {
+      for (int64_t jt=1; jt<n-1; jt+=t) {
+        PRK_TRACE_SCOPE("grid1", it, jt);
         for (auto i=it; i<std::min(n-1,it+t); ++i) {
           OMP_SIMD
           for (auto j=jt; j<std::min(n-1,jt+t); ++j) {
@@ -143,10 +149,11 @@ void grid1(const int n, const int t, std::vector<double> & in, std::vector<doubl
      }
 }
 
-void grid2(const int n, const int t, std::vector<double> & in, std::vector<double> & out, const int gs) {
+void grid2(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out, const int gs) {
     OMP_TASKLOOP_COLLAPSE(2, firstprivate(n) shared(in,out) grainsize(gs) )
-    for (auto it=2; it<n-2; it+=t) {
-      for (auto jt=2; jt<n-2; jt+=t) {
+    for (int64_t it=2; it<n-2; it+=t) {
+      for (int64_t jt=2; jt<n-2; jt+=t) {
+        PRK_TRACE_SCOPE("grid2", it, jt);
         for (auto i=it; i<std::min(n-2,it+t); ++i) {
           OMP_SIMD
           for (auto j=jt; j<std::min(n-2,jt+t); ++j) {
@@ -177,10 +184,11 @@ void grid2(const int n, const int t, std::vector<double> & in, std::vector<doubl
      }
 }
 
-void grid3(const int n, const int t, std::vector<double> & in, std::vector<double> & out, const int gs) {
+void grid3(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out, const int gs) {
     OMP_TASKLOOP_COLLAPSE(2, firstprivate(n) shared(in,out) grainsize(gs) )
-    for (auto it=3; it<n-3; it+=t) {
-      for (auto jt=3; jt<n-3; jt+=t) {
+    for (int64_t it=3; it<n-3; it+=t) {
+      for (int64_t jt=3; jt<n-3; jt+=t) {
+        PRK_TRACE_SCOPE("grid3", it, jt);
         for (auto i=it; i<std::min(n-3,it+t); ++i) {
           OMP_SIMD
           for (auto j=jt; j<std::min(n-3,jt+t); ++j) {
@@ -233,10 +241,11 @@ void grid3(const int n, const int t, std::vector<double> & in, std::vector<doubl
      }
 }
 
-void grid4(const int n, const int t, std::vector<double> & in, std::vector<double> & out, const int gs) {
+void grid4(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out, const int gs) {
     OMP_TASKLOOP_COLLAPSE(2, firstprivate(n) shared(in,out) grainsize(gs) )
-    for (auto it=4; it<n-4; it+=t) {
-      for (auto jt=4; jt<n-4; jt+=t) {
+    for (int64_t it=4; it<n-4; it+=t) {
+      for (int64_t jt=4; jt<n-4; jt+=t) {
+        PRK_TRACE_SCOPE("grid4", it, jt);
         for (auto i=it; i<std::min(n-4,it+t); ++i) {
           OMP_SIMD
           for (auto j=jt; j<std::min(n-4,jt+t); ++j) {
@@ -319,10 +328,11 @@ void grid4(const int n, const int t, std::vector<double> & in, std::vector<doubl
      }
 }
 
-void grid5(const int n, const int t, std::vector<double> & in, std::vector<double> & out, const int gs) {
+void grid5(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out, const int gs) {
     OMP_TASKLOOP_COLLAPSE(2, firstprivate(n) shared(in,out) grainsize(gs) )
-    for (auto it=5; it<n-5; it+=t) {
-      for (auto jt=5; jt<n-5; jt+=t) {
+    for (int64_t it=5; it<n-5; it+=t) {
+      for (int64_t jt=5; jt<n-5; jt+=t) {
+        PRK_TRACE_SCOPE("grid5", it, jt);
         for (auto i=it; i<std::min(n-5,it+t); ++i) {
           OMP_SIMD
           for (auto j=jt; j<std::min(n-5,jt+t); ++j) {
@@ -1,5 +1,5 @@
-void star1(const int n, const int t, std::vector<double> & in, std::vector<double> & out) {
-  tbb::blocked_range2d<int> range(1, n-1, t, 1, n-1, t);
+void star1(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out) {
+  tbb::blocked_range2d<int64_t> range(1, n-1, t, 1, n-1, t);
   tbb::parallel_for( range, [&](decltype(range)& r ) {
     for (auto i=r.rows().begin(); i!=r.rows().end(); ++i ) {
       PRAGMA_SIMD
@@ -13,8 +13,8 @@ void star1(const int n, const int t, std::vector<double> & in, std::vector<doubl
   }, tbb_partitioner );
 }
 
-void star2(const int n, const int t, std::vector<double> & in, std::vector<double> & out) {
-  tbb::blocked_range2d<int> range(2, n-2, t, 2, n-2, t);
+void star2(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out) {
+  tbb::blocked_range2d<int64_t> range(2, n-2, t, 2, n-2, t);
   tbb::parallel_for( range, [&](decltype(range)& r ) {
     for (auto i=r.rows().begin(); i!=r.rows().end(); ++i ) {
       PRAGMA_SIMD
@@ -32,8 +32,8 @@ void star2(const int n, const int t, std::vector<double> & in, std::vector<doubl
   }, tbb_partitioner );
 }
 
-void star3(const int n, const int t, std::vector<double> & in, std::vector<double> & out) {
-  tbb::blocked_range2d<int> range(3, n-3, t, 3, n-3, t);
+void star3(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out) {
+  tbb::blocked_range2d<int64_t> range(3, n-3, t, 3, n-3, t);
   tbb::parallel_for( range, [&](decltype(range)& r ) {
     for (auto i=r.rows().begin(); i!=r.rows().end(); ++i ) {
       PRAGMA_SIMD
@@ -55,8 +55,8 @@ void star3(const int n, const int t, std::vector<double> & in, std::vector<doubl
   }, tbb_partitioner );
 }
 
-void star4(const int n, const int t, std::vector<double> & in, std::vector<double> & out) {
-  tbb::blocked_range2d<int> range(4, n-4, t, 4, n-4, t);
+void star4(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out) {
+  tbb::blocked_range2d<int64_t> range(4, n-4, t, 4, n-4, t);
   tbb::parallel_for( range, [&](decltype(range)& r ) {
     for (auto i=r.rows().begin(); i!=r.rows().end(); ++i ) {
       PRAGMA_SIMD
@@ -82,8 +82,8 @@ void star4(const int n, const int t, std::vector<double> & in, std::vector<doubl
   }, tbb_partitioner );
 }
 
-void star5(const int n, const int t, std::vector<double> & in, std::vector<double> & out) {
-  tbb::blocked_range2d<int> range(5, n-5, t, 5, n-5, t);
+void star5(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out) {
+  tbb::blocked_range2d<int64_t> range(5, n-5, t, 5, n-5, t);
   tbb::parallel_for( range, [&](decltype(range)& r ) {
     for (auto i=r.rows().begin(); i!=r.rows().end(); ++i ) {
       PRAGMA_SIMD
@@ -113,8 +113,8 @@ void star5(const int n, const int t, std::vector<double> & in, std::vector<doubl
   }, tbb_partitioner );
 }
 
-void grid1(const int n, const int t, std::vector<double> & in, std::vector<double> & out) {
-  tbb::blocked_range2d<int> range(1, n-1, t, 1, n-1, t);
+void grid1(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out) {
+  tbb::blocked_range2d<int64_t> range(1, n-1, t, 1, n-1, t);
   tbb::parallel_for( range, [&](decltype(range)& r ) {
     for (auto i=r.rows().begin(); i!=r.rows().end(); ++i ) {
       PRAGMA_SIMD
@@ -131,8 +131,8 @@ void grid1(const int n, const int t, std::vector<double> & in, std::vector<doubl
   }, tbb_partitioner );
 }
 
-void grid2(const int n, const int t, std::vector<double> & in, std::vector<double> & out) {
-  tbb::blocked_range2d<int> range(2, n-2, t, 2, n-2, t);
+void grid2(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out) {
+  tbb::blocked_range2d<int64_t> range(2, n-2, t, 2, n-2, t);
   tbb::parallel_for( range, [&](decltype(range)& r ) {
     for (auto i=r.rows().begin(); i!=r.rows().end(); ++i ) {
       PRAGMA_SIMD
@@ -163,8 +163,8 @@ void grid2(const int n, const int t, std::vector<double> & in, std::vector<doubl
   }, tbb_partitioner );
 }
 
-void grid3(const int n, const int t, std::vector<double> & in, std::vector<double> & out) {
-  tbb::blocked_range2d<int> range(3, n-3, t, 3, n-3, t);
+void grid3(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out) {
+  tbb::blocked_range2d<int64_t> range(3, n-3, t, 3, n-3, t);
   tbb::parallel_for( range, [&](decltype(range)& r ) {
     for (auto i=r.rows().begin(); i!=r.rows().end(); ++i ) {
       PRAGMA_SIMD
@@ -217,8 +217,8 @@ void grid3(const int n, const int t, std::vector<double> & in, std::vector<doubl
   }, tbb_partitioner );
 }
 
-void grid4(const int n, const int t, std::vector<double> & in, std::vector<double> & out) {
-  tbb::blocked_range2d<int> range(4, n-4, t, 4, n-4, t);
+void grid4(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out) {
+  tbb::blocked_range2d<int64_t> range(4, n-4, t, 4, n-4, t);
   tbb::parallel_for( range, [&](decltype(range)& r ) {
     for (auto i=r.rows().begin(); i!=r.rows().end(); ++i ) {
       PRAGMA_SIMD
@@ -301,8 +301,8 @@ void grid4(const int n, const int t, std::vector<double> & in, std::vector<doubl
   }, tbb_partitioner );
 }
 
-void grid5(const int n, const int t, std::vector<double> & in, std::vector<double> & out) {
-  tbb::blocked_range2d<int> range(5, n-5, t, 5, n-5, t);
+void grid5(const int64_t n, const int64_t t, std::vector<double> & in, std::vector<double> & out) {
+  tbb::blocked_range2d<int64_t> range(5, n-5, t, 5, n-5, t);
   tbb::parallel_for( range, [&](decltype(range)& r ) {
     for (auto i=r.rows().begin(); i!=r.rows().end(); ++i ) {
       PRAGMA_SIMD
@@ -73,7 +73,7 @@ int main(int argc, char * argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int order;
+  int64_t order;
   try {
       if (argc < 3) {
         throw "Usage: <# iterations> <matrix order>";
@@ -84,11 +84,11 @@ int main(int argc, char * argv[])
         throw "ERROR: iterations must be >= 1";
       }
 
-      order = std::atoi(argv[2]);
+      order = std::atoll(argv[2]);
       if (order <= 0) {
         throw "ERROR: Matrix Order must be greater than 0";
       } else if (order > std::floor(std::sqrt(INT_MAX))) {
-        throw "ERROR: matrix dimension too large - overflow risk";
+        throw "ERROR: matrix too large for the BLAS integer range";
       }
   }
   catch (const char * e) {
@@ -125,8 +125,8 @@ int main(int argc, char * argv[])
       vDSP_mtransD(&(A[0]), 1, &(T[0]), 1, order, order);
 #else
 #warning No CBLAS transpose extension available!
-      for (auto i=0;i<order; i++) {
-        for (auto j=0;j<order;j++) {
+      for (int64_t i=0;i<order; i++) {
+        for (int64_t j=0;j<order;j++) {
           T2[i*order+j] = A[j*order+i];
         }
       }
@@ -146,10 +146,10 @@ int main(int argc, char * argv[])
   const auto addit = (iterations+1.) * (iterations/2.);
   double abserr(0);
   // TODO: replace with std::generate, std::accumulate, or similar
-  for (auto j=0; j<order; j++) {
-    for (auto i=0; i<order; i++) {
-      const int ij = i*order+j;
-      const int ji = j*order+i;
+  for (int64_t j=0; j<order; j++) {
+    for (int64_t i=0; i<order; i++) {
+      const int64_t ij = i*order+j;
+      const int64_t ji = j*order+i;
       const double reference = static_cast<double>(ij)*(1.+iterations)+addit;
       abserr += std::fabs(B[ji] - reference);
     }
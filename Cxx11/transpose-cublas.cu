@@ -70,7 +70,7 @@ int main(int argc, char * argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int order;
+  int64_t order;
   try {
       if (argc < 3) {
         throw "Usage: <# iterations> <matrix order>";
@@ -81,11 +81,11 @@ int main(int argc, char * argv[])
         throw "ERROR: iterations must be >= 1";
       }
 
-      order = std::atoi(argv[2]);
+      order = std::atoll(argv[2]);
       if (order <= 0) {
         throw "ERROR: Matrix Order must be greater than 0";
       } else if (order > std::floor(std::sqrt(INT_MAX))) {
-        throw "ERROR: matrix dimension too large - overflow risk";
+        throw "ERROR: matrix too large for the BLAS integer range";
       }
   }
   catch (const char * e) {
@@ -113,8 +113,8 @@ int main(int argc, char * argv[])
   prk::CUDA::check( cudaMallocHost((void**)&h_b, bytes) );
 
   // fill A with the sequence 0 to order^2-1 as doubles
-  for (auto j=0; j<order; j++) {
-    for (auto i=0; i<order; i++) {
+  for (int64_t j=0; j<order; j++) {
+    for (int64_t i=0; i<order; i++) {
       h_a[j*order+i] = order*j+i;
       h_b[j*order+i] = 0;
     }
@@ -133,8 +133,8 @@ int main(int argc, char * argv[])
   // correctly implement incx=0.
   double * h_o;
   prk::CUDA::check( cudaMallocHost((void**)&h_o, bytes) );
-  for (auto j=0; j<order; j++) {
-    for (auto i=0; i<order; i++) {
+  for (int64_t j=0; j<order; j++) {
+    for (int64_t i=0; i<order; i++) {
       h_o[j*order+i] = 1;
     }
   }
@@ -218,8 +218,8 @@ int main(int argc, char * argv[])
   // TODO: replace with std::generate, std::accumulate, or similar
   const double addit = (iterations+1.) * (iterations/2.);
   double abserr(0);
-  for (auto j=0; j<order; j++) {
-    for (auto i=0; i<order; i++) {
+  for (int64_t j=0; j<order; j++) {
+    for (int64_t i=0; i<order; i++) {
       const size_t ij = (size_t)i*(size_t)order+(size_t)j;
       const size_t ji = (size_t)j*(size_t)order+(size_t)i;
       const double reference = static_cast<double>(ij)*(1.+iterations)+addit;
@@ -240,8 +240,8 @@ int main(int argc, char * argv[])
               << " Avg time (s): " << avgtime << std::endl;
   } else {
 #ifdef VERBOSE
-    for (auto i=0; i<order; i++) {
-      for (auto j=0; j<order; j++) {
+    for (int64_t i=0; i<order; i++) {
+      for (int64_t j=0; j<order; j++) {
         std::cout << "(" << i << "," << j << ") = " << h_a[i*order+j] << ", " << h_b[i*order+j] << "\n";
       }
     }
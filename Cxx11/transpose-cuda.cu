@@ -65,11 +65,11 @@
 const int tile_dim = 32;
 const int block_rows = 8;
 
-__global__ void transpose(int order, prk_float * A, prk_float * B)
+__global__ void transpose(int64_t order, prk_float * A, prk_float * B)
 {
-    int x = blockIdx.x * tile_dim + threadIdx.x;
-    int y = blockIdx.y * tile_dim + threadIdx.y;
-    int width = gridDim.x * tile_dim;
+    int64_t x = blockIdx.x * tile_dim + threadIdx.x;
+    int64_t y = blockIdx.y * tile_dim + threadIdx.y;
+    int64_t width = gridDim.x * tile_dim;
 
     for (int j = 0; j < tile_dim; j+= block_rows) {
         B[x*width + (y+j)] += A[(y+j)*width + x];
@@ -77,10 +77,10 @@ __global__ void transpose(int order, prk_float * A, prk_float * B)
     }
 }
 #else
-__global__ void transpose(unsigned order, prk_float * A, prk_float * B)
+__global__ void transpose(int64_t order, prk_float * A, prk_float * B)
 {
-    auto i = blockIdx.x * blockDim.x + threadIdx.x;
-    auto j = blockIdx.y * blockDim.y + threadIdx.y;
+    int64_t i = blockIdx.x * blockDim.x + threadIdx.x;
+    int64_t j = blockIdx.y * blockDim.y + threadIdx.y;
 
     if ((i<order) && (j<order)) {
         B[i*order+j] += A[j*order+i];
@@ -102,7 +102,7 @@ int main(int argc, char * argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int order, tile_size;
+  int64_t order, tile_size;
   try {
       if (argc < 3) {
         throw "Usage: <# iterations> <matrix order>";
@@ -113,10 +113,10 @@ int main(int argc, char * argv[])
         throw "ERROR: iterations must be >= 1";
       }
 
-      order = std::atoi(argv[2]);
+      order = std::atoll(argv[2]);
       if (order <= 0) {
         throw "ERROR: Matrix Order must be greater than 0";
-      } else if (order > std::floor(std::sqrt(INT_MAX))) {
+      } else if (order > std::floor(std::sqrt(INT64_MAX))) {
         throw "ERROR: matrix dimension too large - overflow risk";
       }
 
@@ -129,7 +129,7 @@ int main(int argc, char * argv[])
       // default tile size for tiling of local transpose
       tile_size = 32;
       if (argc > 3) {
-          tile_size = std::atoi(argv[3]);
+          tile_size = std::atoll(argv[3]);
           if (tile_size <= 0) tile_size = order;
           if (tile_size > order) tile_size = order;
       }
@@ -180,8 +180,8 @@ int main(int argc, char * argv[])
   h_b = new prk_float[nelems];
 #endif
   // fill A with the sequence 0 to order^2-1
-  for (auto j=0; j<order; j++) {
-    for (auto i=0; i<order; i++) {
+  for (int64_t j=0; j<order; j++) {
+    for (int64_t i=0; i<order; i++) {
       h_a[j*order+i] = static_cast<prk_float>(order*j+i);
       h_b[j*order+i] = static_cast<prk_float>(0);
     }
@@ -226,8 +226,8 @@ int main(int argc, char * argv[])
 
   const double addit = (iterations+1.) * (iterations/2.);
   double abserr(0);
-  for (auto j=0; j<order; j++) {
-    for (auto i=0; i<order; i++) {
+  for (int64_t j=0; j<order; j++) {
+    for (int64_t i=0; i<order; i++) {
       const size_t ij = (size_t)i*(size_t)order+(size_t)j;
       const size_t ji = (size_t)j*(size_t)order+(size_t)i;
       const double reference = static_cast<double>(ij)*(1.+iterations)+addit;
@@ -253,8 +253,8 @@ int main(int argc, char * argv[])
               << " Avg time (s): " << avgtime << std::endl;
   } else {
 #ifdef VERBOSE
-    for (auto i=0; i<order; i++) {
-      for (auto j=0; j<order; j++) {
+    for (int64_t i=0; i<order; i++) {
+      for (int64_t j=0; j<order; j++) {
         std::cout << "(" << i << "," << j << ") = " << h_a[i*order+j] << ", " << h_b[i*order+j] << "\n";
       }
     }
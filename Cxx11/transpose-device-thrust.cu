@@ -51,18 +51,18 @@
 
 #include "prk_util.h"
 
-struct x : public thrust::unary_function<void,int>
+struct x : public thrust::unary_function<void,int64_t>
 {
-    int i;
-    int order;
+    int64_t i;
+    int64_t order;
     thrust::device_vector<double> & A;
     thrust::device_vector<double> & B;
 
-    x(int i, int order, thrust::device_vector<double> & A, thrust::device_vector<double> & B) :
+    x(int64_t i, int64_t order, thrust::device_vector<double> & A, thrust::device_vector<double> & B) :
         i(i), order(order), A(A), B(B) {}
 
     __host__ __device__
-    void operator()(int j)
+    void operator()(int64_t j)
     {
         B[i*order+j] += A[j*order+i];
         A[j*order+i] += 1.0;
@@ -71,11 +71,11 @@ struct x : public thrust::unary_function<void,int>
 };
 
 //__device__
-void transpose(const int order, thrust::device_vector<double> & A, thrust::device_vector<double> & B)
+void transpose(const int64_t order, thrust::device_vector<double> & A, thrust::device_vector<double> & B)
 {
-    thrust::counting_iterator<int> start(0);
-    thrust::counting_iterator<int> end = start + order;
-    thrust::for_each( thrust::device, start, end, [=,&A,&B] (int i) {
+    thrust::counting_iterator<int64_t> start(0);
+    thrust::counting_iterator<int64_t> end = start + order;
+    thrust::for_each( thrust::device, start, end, [=,&A,&B] (int64_t i) {
       thrust::for_each( thrust::device, start, end, x(i,order,A,B) );
     });
 }
@@ -90,7 +90,7 @@ int main(int argc, char * argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int order;
+  int64_t order;
   try {
       if (argc < 3) {
         throw "Usage: <# iterations> <matrix order>";
@@ -103,10 +103,10 @@ int main(int argc, char * argv[])
       }
 
       // order of a the matrix
-      order = std::atoi(argv[2]);
+      order = std::atoll(argv[2]);
       if (order <= 0) {
         throw "ERROR: Matrix Order must be greater than 0";
-      } else if (order > std::floor(std::sqrt(INT_MAX))) {
+      } else if (order > std::floor(std::sqrt(INT64_MAX))) {
         throw "ERROR: matrix dimension too large - overflow risk";
       }
   }
@@ -128,7 +128,7 @@ int main(int argc, char * argv[])
   thrust::sequence(thrust::device, A.begin(), A.end() );
   thrust::fill(thrust::device, B.begin(), B.end(), 0.0);
 
-  auto range = boost::irange(0,order);
+  auto range = boost::irange(static_cast<int64_t>(0),order);
 
   auto trans_time = 0.0;
 
@@ -139,8 +139,8 @@ int main(int argc, char * argv[])
 #if 1
     transpose(order, A, B);
 #else
-    thrust::for_each( std::begin(range), std::end(range), [=,&A,&B] (int i) {
-      thrust::for_each( std::begin(range), std::end(range), [=,&A,&B] (int j) {
+    thrust::for_each( std::begin(range), std::end(range), [=,&A,&B] (int64_t i) {
+      thrust::for_each( std::begin(range), std::end(range), [=,&A,&B] (int64_t j) {
         B[i*order+j] += A[j*order+i];
         A[j*order+i] += 1.0;
       });
@@ -158,8 +158,8 @@ int main(int argc, char * argv[])
   auto abserr = 0.0;
   for (auto i : range) {
     for (auto j : range) {
-      const int ij = i*order+j;
-      const int ji = j*order+i;
+      const int64_t ij = i*order+j;
+      const int64_t ji = j*order+i;
       const double reference = static_cast<double>(ij)*(1.+iterations)+addit;
       abserr += std::fabs(B[ji] - reference);
     }
@@ -62,7 +62,7 @@ int main(int argc, char * argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int order;
+  int64_t order;
   try {
       if (argc < 3) {
         throw "Usage: <# iterations> <matrix order>";
@@ -75,10 +75,10 @@ int main(int argc, char * argv[])
       }
 
       // order of a the matrix
-      order = std::atoi(argv[2]);
+      order = std::atoll(argv[2]);
       if (order <= 0) {
         throw "ERROR: Matrix Order must be greater than 0";
-      } else if (order > std::floor(std::sqrt(INT_MAX))) {
+      } else if (order > std::floor(std::sqrt(INT64_MAX))) {
         throw "ERROR: matrix dimension too large - overflow risk";
       }
   }
@@ -100,7 +100,7 @@ int main(int argc, char * argv[])
   thrust::sequence(thrust::host, A.begin(), A.end() );
   thrust::fill(thrust::host, B.begin(), B.end(), 0.0);
 
-  auto range = boost::irange(0,order);
+  auto range = boost::irange(static_cast<int64_t>(0),order);
 
   auto trans_time = 0.0;
 
@@ -109,8 +109,8 @@ int main(int argc, char * argv[])
     if (iter==1) trans_time = prk::wtime();
 
     // transpose
-    thrust::for_each( thrust::host, std::begin(range), std::end(range), [&] (int i) {
-      thrust::for_each( thrust::host, std::begin(range), std::end(range), [&] (int j) {
+    thrust::for_each( thrust::host, std::begin(range), std::end(range), [&] (int64_t i) {
+      thrust::for_each( thrust::host, std::begin(range), std::end(range), [&] (int64_t j) {
         B[i*order+j] += A[j*order+i];
         A[j*order+i] += 1.0;
       });
@@ -127,8 +127,8 @@ int main(int argc, char * argv[])
   auto abserr = 0.0;
   for (auto i : range) {
     for (auto j : range) {
-      const int ij = i*order+j;
-      const int ji = j*order+i;
+      const int64_t ij = i*order+j;
+      const int64_t ji = j*order+i;
       const double reference = static_cast<double>(ij)*(1.+iterations)+addit;
       abserr += std::fabs(B[ji] - reference);
     }
@@ -0,0 +1,101 @@
+///
+/// Copyright (c) 2018, Intel Corporation
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions
+/// are met:
+///
+/// * Redistributions of source code must retain the above copyright
+///       notice, this list of conditions and the following disclaimer.
+/// * Redistributions in binary form must reproduce the above
+///       copyright notice, this list of conditions and the following
+///       disclaimer in the documentation and/or other materials provided
+///       with the distribution.
+/// * Neither the name of Intel Corporation nor the names of its
+///       contributors may be used to endorse or promote products
+///       derived from this software without specific prior written
+///       permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+/// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+/// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+/// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+/// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+/// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+/// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+/// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+/// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+/// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef TRANSPOSE_KERNEL_H
+#define TRANSPOSE_KERNEL_H
+
+#include "prk_openmp.h"
+
+#define RESTRICT __restrict__
+
+// The transpose of transpose-openmp and prk-suite: B += A^T, then A += 1.
+// The loops are orphaned worksharing constructs, like the stencils in
+// stencil_openmp.hpp, so they are called from inside a parallel region.
+
+inline void transpose_init(int64_t order, double * RESTRICT A, double * RESTRICT B)
+{
+    OMP_FOR()
+    for (int64_t i=0;i<order; i++) {
+      PRAGMA_SIMD
+      for (int64_t j=0;j<order;j++) {
+        A[i*order+j] = static_cast<double>(i*order+j);
+        B[i*order+j] = 0.0;
+      }
+    }
+}
+
+inline void transpose_tiled(int64_t order, int64_t tile_size, double * RESTRICT A, double * RESTRICT B)
+{
+    if (tile_size < order) {
+      OMP_FOR()
+      for (int64_t it=0; it<order; it+=tile_size) {
+        for (int64_t jt=0; jt<order; jt+=tile_size) {
+          PRAGMA_SIMD
+          for (auto i=it; i<std::min(order,it+tile_size); i++) {
+            PRAGMA_SIMD
+            for (auto j=jt; j<std::min(order,jt+tile_size); j++) {
+              B[i*order+j] += A[j*order+i];
+              A[j*order+i] += 1.0;
+            }
+          }
+        }
+      }
+    } else {
+      OMP_FOR()
+      for (int64_t i=0;i<order; i++) {
+      PRAGMA_SIMD
+        for (int64_t j=0;j<order;j++) {
+          B[i*order+j] += A[j*order+i];
+          A[j*order+i] += 1.0;
+        }
+      }
+    }
+}
+
+// The sum of the absolute differences of B from its value after
+// iterations+1 transposes.  This is called outside of a parallel region.
+inline double transpose_error(int iterations, int64_t order, const double * RESTRICT B)
+{
+    const auto addit = (iterations+1.) * (iterations/2.);
+    auto abserr = 0.0;
+    OMP_PARALLEL_FOR_REDUCE( +:abserr )
+    for (int64_t j=0; j<order; j++) {
+      for (int64_t i=0; i<order; i++) {
+        const int64_t ij = i*order+j;
+        const int64_t ji = j*order+i;
+        const double reference = static_cast<double>(ij)*(1.+iterations)+addit;
+        abserr += std::fabs(B[ji] - reference);
+      }
+    }
+    return abserr;
+}
+
+#endif /* TRANSPOSE_KERNEL_H */
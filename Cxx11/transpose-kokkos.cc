@@ -71,8 +71,8 @@ int main(int argc, char * argv[])
     //////////////////////////////////////////////////////////////////////
 
     int iterations;
-    int order;
-    int tile_size;
+    int64_t order;
+    int64_t tile_size;
     bool permute = false;
     try {
         if (argc < 3) {
@@ -84,15 +84,15 @@ int main(int argc, char * argv[])
           throw "ERROR: iterations must be >= 1";
         }
 
-        order = std::atoi(argv[2]);
+        order = std::atoll(argv[2]);
         if (order <= 0) {
           throw "ERROR: Matrix Order must be greater than 0";
-        } else if (order > std::floor(std::sqrt(INT_MAX))) {
+        } else if (order > std::floor(std::sqrt(INT64_MAX))) {
           throw "ERROR: matrix dimension too large - overflow risk";
         }
 
         // default tile size for tiling of local transpose
-        tile_size = (argc>3) ? std::atoi(argv[3]) : 32;
+        tile_size = (argc>3) ? std::atoll(argv[3]) : 32;
         // a negative tile size means no tiling of the local transpose
         if (tile_size <= 0) tile_size = order;
 
@@ -129,7 +129,7 @@ int main(int argc, char * argv[])
     auto policy_lr = Kokkos::MDRangePolicy<rl>({0,0},order2,tile2);
     auto policy_rl = Kokkos::MDRangePolicy<lr>({0,0},order2,tile2);
 
-    Kokkos::parallel_for(policy, KOKKOS_LAMBDA(int i, int j) {
+    Kokkos::parallel_for(policy, KOKKOS_LAMBDA(int64_t i, int64_t j) {
         A(i,j) = static_cast<double>(i*order+j);
         B(i,j) = 0.0;
     });
@@ -141,12 +141,12 @@ int main(int argc, char * argv[])
       if (iter==1) trans_time = prk::wtime();
 
       if (permute) {
-          Kokkos::parallel_for(policy_rl, KOKKOS_LAMBDA(int i, int j) {
+          Kokkos::parallel_for(policy_rl, KOKKOS_LAMBDA(int64_t i, int64_t j) {
               B(i,j) += A(j,i);
               A(j,i) += 1.0;
           });
       } else {
-          Kokkos::parallel_for(policy_lr, KOKKOS_LAMBDA(int i, int j) {
+          Kokkos::parallel_for(policy_lr, KOKKOS_LAMBDA(int64_t i, int64_t j) {
               B(i,j) += A(j,i);
               A(j,i) += 1.0;
           });
@@ -161,7 +161,7 @@ int main(int argc, char * argv[])
 
     double const addit = (iterations+1.) * (0.5*iterations);
     double abserr(0);
-    Kokkos::parallel_reduce(policy, KOKKOS_LAMBDA(int i, int j, double & update) {
+    Kokkos::parallel_reduce(policy, KOKKOS_LAMBDA(int64_t i, int64_t j, double & update) {
         size_t const ij = i*order+j;
         double const reference = static_cast<double>(ij)*(1.+iterations)+addit;
         update += std::fabs(B(j,i) - reference);
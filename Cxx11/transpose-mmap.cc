@@ -0,0 +1,585 @@
+///
+/// Copyright (c) 2013, Intel Corporation
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions
+/// are met:
+///
+/// * Redistributions of source code must retain the above copyright
+///       notice, this list of conditions and the following disclaimer.
+/// * Redistributions in binary form must reproduce the above
+///       copyright notice, this list of conditions and the following
+///       disclaimer in the documentation and/or other materials provided
+///       with the distribution.
+/// * Neither the name of Intel Corporation nor the names of its
+///       contributors may be used to endorse or promote products
+///       derived from this software without specific prior written
+///       permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+/// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+/// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+/// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+/// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+/// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+/// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+/// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+/// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+/// ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+/// POSSIBILITY OF SUCH DAMAGE.
+
+//////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////
+///
+/// NAME:    transpose
+///
+/// PURPOSE: This program measures the time for the transpose of a
+///          column-major stored matrix into a row-major stored matrix
+///          when neither matrix fits in memory.
+///
+/// USAGE:   Program input is the number of times to repeat the operation,
+///          the matrix order, and optionally the memory budget, the I/O
+///          method, the tile size and the directory of the matrix files:
+///
+///          transpose-mmap <# iterations> <matrix order>
+///                         [<memory budget (MB)> [mmap|pread [<tile size> [<directory>]]]]
+///
+///          A and B are files of order^2 doubles in the given directory
+///          (default ".") that are removed at exit.  B is swept in bands of
+///          rows, together with the matching band of columns of A, and the
+///          band height is the largest one for which the bands fit in the
+///          memory budget (default 256 MB).
+///
+///          With "mmap" (the default) both files are mapped.  The band in
+///          progress is faulted in and written back explicitly, so that file
+///          I/O and compute are timed separately, and the next band is
+///          announced with MADV_WILLNEED.  The residency of the mappings
+///          is up to the kernel; bands of B that are done are dropped with
+///          MADV_DONTNEED.
+///
+///          With "pread" the bands are read and written with pread/pwrite
+///          into two sets of buffers, and a helper thread writes back the
+///          previous band and reads the next one while the current one is
+///          transposed.  This needs at least two bands, so the band height
+///          is at most half the matrix order.
+///
+///          The output consists of diagnostics to make sure the
+///          transpose worked and timing statistics, including the rates
+///          of file I/O and of compute on their own.
+///
+/// FUNCTIONS CALLED:
+///
+///          Other than standard C functions, the following
+///          functions are used in this program:
+///
+///          wtime()
+///          mmap(), madvise(), msync(), pread(), pwrite()
+///
+/// HISTORY: Out-of-core variant of transpose-vector, 2018.
+///
+//////////////////////////////////////////////////////////////////////
+
+#include "prk_util.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+namespace {
+
+// A scratch file of a fixed size, removed when it goes out of scope.
+// ftruncate leaves it sparse, i.e. all zero.
+class scratch_file {
+
+  private:
+
+    std::string name;
+    int fd;
+
+  public:
+
+    scratch_file(const std::string & dir, const std::string & tag, size_t bytes)
+    {
+        name = dir + "/prk-transpose-" + tag + "-" + std::to_string(getpid()) + ".dat";
+        fd = open(name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+        if (fd < 0) {
+            throw "ERROR: cannot create the matrix files";
+        }
+        if (ftruncate(fd, bytes) != 0) {
+            close(fd);
+            unlink(name.c_str());
+            throw "ERROR: cannot extend the matrix files - is there enough disk space?";
+        }
+    }
+
+    ~scratch_file()
+    {
+        close(fd);
+        unlink(name.c_str());
+    }
+
+    scratch_file(const scratch_file &) = delete;
+    scratch_file & operator=(const scratch_file &) = delete;
+
+    int descriptor() const { return fd; }
+
+    // pread and pwrite may transfer less than asked for
+    void read(void * p, size_t bytes, size_t offset) const
+    {
+        char * c = static_cast<char*>(p);
+        while (bytes > 0) {
+            const ssize_t n = pread(fd, c, bytes, offset);
+            if (n <= 0) throw "ERROR: pread of the matrix files failed";
+            c += n; bytes -= n; offset += n;
+        }
+    }
+
+    void write(const void * p, size_t bytes, size_t offset) const
+    {
+        const char * c = static_cast<const char*>(p);
+        while (bytes > 0) {
+            const ssize_t n = pwrite(fd, c, bytes, offset);
+            if (n <= 0) throw "ERROR: pwrite of the matrix files failed";
+            c += n; bytes -= n; offset += n;
+        }
+    }
+};
+
+// A shared read-write mapping of a whole scratch file.
+class mapping {
+
+  private:
+
+    void * base;
+    size_t bytes;
+
+  public:
+
+    mapping(const scratch_file & f, size_t b) : bytes(b)
+    {
+        base = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, f.descriptor(), 0);
+        if (base == MAP_FAILED) {
+            throw "ERROR: mmap of the matrix files failed";
+        }
+    }
+
+    ~mapping() { munmap(base, bytes); }
+
+    mapping(const mapping &) = delete;
+    mapping & operator=(const mapping &) = delete;
+
+    double * data() const { return static_cast<double*>(base); }
+
+    // madvise and msync want page-aligned ranges, so the range is widened
+    // to whole pages; pages shared with a neighbouring band are harmless
+    // to advise, since the mapping is backed by the file
+    void advise(size_t offset, size_t length, int advice) const
+    {
+        const size_t page = sysconf(_SC_PAGESIZE);
+        const size_t first = offset / page * page;
+        madvise(static_cast<char*>(base) + first, offset + length - first, advice);
+    }
+
+    void sync(size_t offset, size_t length) const
+    {
+        const size_t page = sysconf(_SC_PAGESIZE);
+        const size_t first = offset / page * page;
+        if (msync(static_cast<char*>(base) + first, offset + length - first, MS_SYNC) != 0) {
+            throw "ERROR: msync of the matrix files failed";
+        }
+    }
+};
+
+// One helper thread that runs one job at a time.  submit() waits for the
+// previous job, and wait() rethrows what a job threw.
+class io_thread {
+
+  private:
+
+    std::mutex m;
+    std::condition_variable cv;
+    std::function<void()> job;
+    const char * error = nullptr;
+    bool busy = false;
+    bool done = false;
+    std::thread worker;
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(m);
+        while (true) {
+            cv.wait(lock, [this] { return busy || done; });
+            if (!busy) return;
+            lock.unlock();
+            const char * e = nullptr;
+            try {
+                job();
+            }
+            catch (const char * x) {
+                e = x;
+            }
+            lock.lock();
+            error = e;
+            busy = false;
+            cv.notify_all();
+        }
+    }
+
+  public:
+
+    io_thread() : worker([this] { run(); }) {}
+
+    ~io_thread()
+    {
+        {
+            std::unique_lock<std::mutex> lock(m);
+            cv.wait(lock, [this] { return !busy; });
+            done = true;
+        }
+        cv.notify_all();
+        worker.join();
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(m);
+        cv.wait(lock, [this] { return !busy; });
+        if (error != nullptr) {
+            const char * e = error;
+            error = nullptr;
+            throw e;
+        }
+    }
+
+    void submit(std::function<void()> f)
+    {
+        wait();
+        std::unique_lock<std::mutex> lock(m);
+        job = std::move(f);
+        busy = true;
+        cv.notify_all();
+    }
+};
+
+// Faults in p[0:n] for writing by storing back one element of every page,
+// so that the band kernel does not take the write faults either.
+void touch(double * p, int64_t n)
+{
+    const int64_t stride = sysconf(_SC_PAGESIZE) / sizeof(double);
+    volatile double * v = p;
+    for (int64_t i=0; i<n; i+=stride) v[i] = v[i];
+    v[n-1] = v[n-1];
+}
+
+// B[i][j] += A[j][i] and A[j][i] += 1 for the rows of one band of B,
+// where row i of the band of B is at b+i*ldb and column i of the band
+// of A is at a+i, with a stride of lda between the rows of A
+void transpose_band(int64_t rows, int64_t order, int64_t tile_size,
+                    double * RESTRICT a, int64_t lda, double * RESTRICT b, int64_t ldb)
+{
+    for (int64_t it=0; it<rows; it+=tile_size) {
+      for (int64_t jt=0; jt<order; jt+=tile_size) {
+        for (int64_t i=it; i<std::min(rows,it+tile_size); i++) {
+          for (int64_t j=jt; j<std::min(order,jt+tile_size); j++) {
+            b[i*ldb+j] += a[j*lda+i];
+            a[j*lda+i] += 1.0;
+          }
+        }
+      }
+    }
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+  std::cout << "Parallel Research Kernels version " << PRKVERSION << std::endl;
+  std::cout << "C++11 Out-of-core matrix transpose: B = A^T" << std::endl;
+
+  //////////////////////////////////////////////////////////////////////
+  // Read and test input parameters
+  //////////////////////////////////////////////////////////////////////
+
+  int iterations;
+  int64_t order;
+  int64_t budget;
+  int64_t tile_size;
+  bool use_mmap = true;
+  std::string dir(".");
+  try {
+      if (argc < 3) {
+        throw "Usage: <# iterations> <matrix order> [<memory budget (MB)> [mmap|pread [<tile size> [<directory>]]]]";
+      }
+
+      iterations  = std::atoi(argv[1]);
+      if (iterations < 1) {
+        throw "ERROR: iterations must be >= 1";
+      }
+
+      order = std::atoll(argv[2]);
+      if (order <= 1) {
+        throw "ERROR: Matrix Order must be greater than 1";
+      } else if (order > std::floor(std::sqrt(INT64_MAX/sizeof(double)))) {
+        throw "ERROR: matrix dimension too large - overflow risk";
+      }
+
+      budget = (argc>3) ? std::atoll(argv[3]) : 256;
+      if (budget < 1) {
+        throw "ERROR: memory budget must be at least 1 MB";
+      }
+
+      if (argc>4) {
+        const std::string io(argv[4]);
+        if (io == "pread") {
+          use_mmap = false;
+        } else if (io != "mmap") {
+          throw "ERROR: I/O method must be mmap or pread";
+        }
+      }
+
+      // default tile size for tiling of local transpose
+      tile_size = (argc>5) ? std::atoll(argv[5]) : 32;
+      // a negative tile size means no tiling of the local transpose
+      if (tile_size <= 0) tile_size = order;
+
+      if (argc>6) dir = std::string(argv[6]);
+  }
+  catch (const char * e) {
+    std::cout << e << std::endl;
+    return 1;
+  }
+
+  // a band of h rows of B and the matching h columns of A hold 2*h*order
+  // doubles, and the pread method keeps two sets of bands
+  const int64_t band_bytes = 2 * order * static_cast<int64_t>(sizeof(double));
+  int64_t band = (budget << 20) / (use_mmap ? band_bytes : 2*band_bytes);
+  if (band < 1) {
+    std::cout << "ERROR: memory budget too small for one row of the matrices, which needs "
+              << (use_mmap ? 1 : 2) * band_bytes << " bytes" << std::endl;
+    return 1;
+  }
+  band = std::min(band, use_mmap ? order : prk::divceil(order,int64_t(2)));
+  const int64_t bands = prk::divceil(order,band);
+
+  std::cout << "Number of iterations = " << iterations << std::endl;
+  std::cout << "Matrix order         = " << order << std::endl;
+  std::cout << "Memory budget (MB)   = " << budget << std::endl;
+  std::cout << "I/O method           = " << (use_mmap ? "mmap" : "pread with helper thread") << std::endl;
+  std::cout << "Band height          = " << band << " (" << bands << " bands)" << std::endl;
+  std::cout << "Tile size            = " << tile_size << std::endl;
+  std::cout << "Matrix files in      = " << dir << std::endl;
+
+  //////////////////////////////////////////////////////////////////////
+  // Allocate space and perform the computation
+  //////////////////////////////////////////////////////////////////////
+
+  const size_t bytes = static_cast<size_t>(order) * static_cast<size_t>(order) * sizeof(double);
+
+  auto trans_time = 0.0;
+  auto io_time = 0.0;
+  auto compute_time = 0.0;
+  double io_bytes = 0.0;
+
+  double abserr(0);
+  double refsum(0);
+
+
+  try {
+    scratch_file A(dir, "A", bytes);
+    scratch_file B(dir, "B", bytes);
+
+    // fill A with the sequence 0 to order^2-1, a band of rows at a time
+    {
+      std::vector<double> rows(band*order);
+      for (int64_t r=0; r<order; r+=band) {
+        const int64_t h = std::min(band, order-r);
+        for (int64_t ij=0; ij<h*order; ij++) {
+          rows[ij] = static_cast<double>(r*order+ij);
+        }
+        A.write(rows.data(), h*order*sizeof(double), r*order*sizeof(double));
+      }
+    }
+
+    // band k holds the rows first(k) to first(k)+height(k)-1 of B and the
+    // same columns of A; k counts on across iterations
+    auto first  = [&] (int64_t k) { return (k % bands) * band; };
+    auto height = [&] (int64_t k) { return std::min(band, order - first(k)); };
+
+    if (use_mmap) {
+
+      mapping MA(A, bytes);
+      mapping MB(B, bytes);
+      double * pA = MA.data();
+      double * pB = MB.data();
+
+      // B is swept front to back; A is visited a band of columns at a time,
+      // so only the pages of the band are announced
+      MB.advise(0, bytes, MADV_SEQUENTIAL);
+      auto willneed = [&] (int64_t k) {
+        const int64_t f = first(k), h = height(k);
+        MB.advise(f*order*sizeof(double), h*order*sizeof(double), MADV_WILLNEED);
+        for (int64_t j=0; j<order; j++) {
+          MA.advise((j*order+f)*sizeof(double), h*sizeof(double), MADV_WILLNEED);
+        }
+      };
+
+      willneed(0);
+      for (auto iter = 0; iter<=iterations; iter++) {
+
+        if (iter==1) {
+          trans_time = prk::wtime();
+          io_time = compute_time = io_bytes = 0.0;
+        }
+
+        for (int64_t k=0; k<bands; k++) {
+          const int64_t f = first(k), h = height(k);
+
+          double t0 = prk::wtime();
+          if (bands > 1) willneed(k+1);
+          touch(pB+f*order, h*order);
+          for (int64_t j=0; j<order; j++) {
+            touch(pA+j*order+f, h);
+          }
+
+          double t1 = prk::wtime();
+          transpose_band(h, order, tile_size, pA+f, order, pB+f*order, order);
+
+          // the band of B is final for this iteration; the band of A shares
+          // pages with the next one, so all of A is written back at the end
+          double t2 = prk::wtime();
+          MB.sync(f*order*sizeof(double), h*order*sizeof(double));
+          MB.advise(f*order*sizeof(double), h*order*sizeof(double), MADV_DONTNEED);
+
+          double t3 = prk::wtime();
+          io_time += (t1-t0) + (t3-t2);
+          compute_time += t2-t1;
+          // both bands are read and written
+          io_bytes += 4.0*h*order*sizeof(double);
+        }
+
+        double t = prk::wtime();
+        MA.sync(0, bytes);
+        io_time += prk::wtime() - t;
+      }
+      trans_time = prk::wtime() - trans_time;
+
+    } else {
+
+      struct buffers {
+        std::vector<double> a; // band of columns of A, stored as rows of length height
+        std::vector<double> b; // band of rows of B
+      };
+      std::vector<buffers> set(2, buffers{std::vector<double>(order*band), std::vector<double>(band*order)});
+
+      // these run on the helper thread, or on this one while the helper is
+      // idle, so the I/O statistics are never updated concurrently
+      auto load = [&] (int64_t k, buffers & s) {
+        const int64_t f = first(k), h = height(k);
+        double t = prk::wtime();
+        B.read(s.b.data(), h*order*sizeof(double), f*order*sizeof(double));
+        for (int64_t j=0; j<order; j++) {
+          A.read(&s.a[j*h], h*sizeof(double), (j*order+f)*sizeof(double));
+        }
+        io_time += prk::wtime() - t;
+        io_bytes += 2.0*h*order*sizeof(double);
+      };
+      auto store = [&] (int64_t k, const buffers & s) {
+        const int64_t f = first(k), h = height(k);
+        double t = prk::wtime();
+        B.write(s.b.data(), h*order*sizeof(double), f*order*sizeof(double));
+        for (int64_t j=0; j<order; j++) {
+          A.write(&s.a[j*h], h*sizeof(double), (j*order+f)*sizeof(double));
+        }
+        io_time += prk::wtime() - t;
+        io_bytes += 2.0*h*order*sizeof(double);
+      };
+
+      // while band k is transposed, band k-1 is written back and band k+1
+      // is read into the same set of buffers.  Bands k-1, k and k+1 are
+      // distinct because there are at least two bands.
+      const int64_t steps = (iterations+1) * bands;
+      io_thread helper;
+      helper.submit([&] { load(0, set[0]); });
+      for (int64_t k=0; k<steps; k++) {
+        helper.wait();
+
+        if (k==bands) {
+          trans_time = prk::wtime();
+          io_time = compute_time = io_bytes = 0.0;
+        }
+
+        helper.submit([&,k] {
+                        if (k>0) store(k-1, set[(k-1)%2]);
+                        if (k+1<steps) load(k+1, set[(k+1)%2]);
+                      });
+
+        const int64_t h = height(k);
+        double t = prk::wtime();
+        transpose_band(h, order, tile_size, set[k%2].a.data(), h, set[k%2].b.data(), order);
+        compute_time += prk::wtime() - t;
+      }
+      helper.wait();
+      store(steps-1, set[(steps-1)%2]);
+      trans_time = prk::wtime() - trans_time;
+    }
+
+    //////////////////////////////////////////////////////////////////////
+    /// Analyze and output results
+    //////////////////////////////////////////////////////////////////////
+
+    const auto addit = (iterations+1.) * (iterations/2.);
+    std::vector<double> rows(band*order);
+    for (int64_t r=0; r<order; r+=band) {
+      const int64_t h = std::min(band, order-r);
+      B.read(rows.data(), h*order*sizeof(double), r*order*sizeof(double));
+      for (int64_t i=0; i<h; i++) {
+        for (int64_t j=0; j<order; j++) {
+          const int64_t ij = j*order+(r+i);
+          const double reference = static_cast<double>(ij)*(1.+iterations)+addit;
+          abserr += std::fabs(rows[i*order+j] - reference);
+          refsum += reference;
+        }
+      }
+    }
+  }
+  catch (const char * e) {
+    std::cout << e << std::endl;
+    return 1;
+  }
+
+#ifdef VERBOSE
+  std::cout << "Sum of absolute differences: " << abserr << std::endl;
+#endif
+
+  const auto epsilon = 1.0e-8;
+  if (abserr < epsilon) {
+    std::cout << "Solution validates" << std::endl;
+    auto avgtime = trans_time/iterations;
+    std::cout << "Rate (MB/s): " << 1.0e-6 * (2L*bytes)/avgtime
+              << " Avg time (s): " << avgtime << std::endl;
+    // with pread the I/O overlaps the compute, so the two times may add up
+    // to more than the total
+    std::cout << "File I/O (GB/s): " << 1.0e-9 * io_bytes/io_time
+              << " Avg time (s): " << io_time/iterations
+              << " Volume (GB): " << 1.0e-9 * io_bytes << std::endl;
+    // the band kernel reads and writes both A and B
+    std::cout << "Compute (GB/s): " << 1.0e-9 * (4.0*bytes*iterations)/compute_time
+              << " Avg time (s): " << compute_time/iterations << std::endl;
+    // only the compute has a roofline; the file I/O is bound by the device
+    const prk::work_model work{2.0*order*order, 4.0*bytes};
+    prk::roofline::print(work, compute_time/iterations);
+  } else {
+    std::cout << "ERROR: Aggregate squared error " << abserr
+              << " exceeds threshold " << epsilon << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -77,8 +77,8 @@ int main(int argc, char * argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int order;
-  int tile_size;
+  int64_t order;
+  int64_t tile_size;
   try {
       if (argc < 3) {
         throw "Usage: <# iterations> <matrix order> [tile size]";
@@ -89,15 +89,15 @@ int main(int argc, char * argv[])
         throw "ERROR: iterations must be >= 1";
       }
 
-      order = std::atoi(argv[2]);
+      order = std::atoll(argv[2]);
       if (order <= 0) {
         throw "ERROR: Matrix Order must be greater than 0";
-      } else if (order > std::floor(std::sqrt(INT_MAX))) {
+      } else if (order > std::floor(std::sqrt(INT64_MAX))) {
         throw "ERROR: matrix dimension too large - overflow risk";
       }
 
       // default tile size for tiling of local transpose
-      tile_size = (argc>3) ? std::atoi(argv[3]) : 32;
+      tile_size = (argc>3) ? std::atoll(argv[3]) : 32;
       // a negative tile size means no tiling of the local transpose
       if (tile_size <= 0) tile_size = order;
   }
@@ -119,8 +119,8 @@ int main(int argc, char * argv[])
 
   double * h_A = new double[order*order];
   double * h_B = new double[order*order];
-  for (auto i=0;i<order; i++) {
-    for (auto j=0;j<order;j++) {
+  for (int64_t i=0;i<order; i++) {
+    for (int64_t j=0;j<order;j++) {
       h_A[i*order+j] = static_cast<double>(i*order+j);
       h_B[i*order+j] = 0.0;
     }
@@ -156,10 +156,10 @@ int main(int argc, char * argv[])
 
   const auto addit = (iterations+1.) * (iterations/2.);
   auto abserr = 0.0;
-  for (auto j=0; j<order; j++) {
-    for (auto i=0; i<order; i++) {
-      const int ij = i*order+j;
-      const int ji = j*order+i;
+  for (int64_t j=0; j<order; j++) {
+    for (int64_t i=0; i<order; i++) {
+      const int64_t ij = i*order+j;
+      const int64_t ji = j*order+i;
       const double reference = static_cast<double>(ij)*(1.+iterations)+addit;
       abserr += std::fabs(h_B[ji] - reference);
     }
@@ -56,7 +56,7 @@
 #include "prk_opencl.h"
 
 template <typename T>
-void run(cl::Context context, int iterations, int order)
+void run(cl::Context context, int iterations, int64_t order)
 {
   auto precision = (sizeof(T)==8) ? 64 : 32;
 
@@ -65,7 +65,7 @@ void run(cl::Context context, int iterations, int order)
   auto function = (precision==64) ? "transpose64" : "transpose32";
 
   cl_int err;
-  auto kernel = cl::make_kernel<int, cl::Buffer, cl::Buffer>(program, function, &err);
+  auto kernel = cl::make_kernel<cl_long, cl::Buffer, cl::Buffer>(program, function, &err);
   if(err != CL_SUCCESS){
     std::vector<cl::Device> devices = context.getInfo<CL_CONTEXT_DEVICES>();
     std::cout << program.getBuildInfo<CL_PROGRAM_BUILD_LOG>(devices[0]) << std::endl;
@@ -107,10 +107,10 @@ void run(cl::Context context, int iterations, int order)
   // TODO: replace with std::generate, std::accumulate, or similar
   const double addit = (iterations+1.0) * (0.5*iterations);
   double abserr = 0.0;
-  for (auto j=0; j<order; j++) {
-    for (auto i=0; i<order; i++) {
-      const int ij = i*order+j;
-      const int ji = j*order+i;
+  for (int64_t j=0; j<order; j++) {
+    for (int64_t i=0; i<order; i++) {
+      const int64_t ij = i*order+j;
+      const int64_t ji = j*order+i;
       const double reference = static_cast<double>(ij)*(iterations+1)+addit;
       abserr += std::fabs(static_cast<double>(h_b[ji]) - reference);
     }
@@ -149,7 +149,7 @@ int main(int argc, char* argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int order;
+  int64_t order;
   try {
       if (argc < 3) {
         throw "Usage: <# iterations> <matrix order>";
@@ -162,10 +162,10 @@ int main(int argc, char* argv[])
       }
 
       // order of a the matrix
-      order = std::atol(argv[2]);
+      order = std::atoll(argv[2]);
       if (order <= 0) {
         throw "ERROR: Matrix Order must be greater than 0";
-      } else if (order > std::floor(std::sqrt(INT_MAX))) {
+      } else if (order > std::floor(std::sqrt(INT64_MAX))) {
         throw "ERROR: matrix dimension too large - overflow risk";
       }
   }
@@ -64,8 +64,8 @@ int main(int argc, char * argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int order;
-  int tile_size;
+  int64_t order;
+  int64_t tile_size;
   try {
       if (argc < 3) {
         throw "Usage: <# iterations> <matrix order> [tile size]";
@@ -76,15 +76,15 @@ int main(int argc, char * argv[])
         throw "ERROR: iterations must be >= 1";
       }
 
-      order = std::atoi(argv[2]);
+      order = std::atoll(argv[2]);
       if (order <= 0) {
         throw "ERROR: Matrix Order must be greater than 0";
-      } else if (order > std::floor(std::sqrt(INT_MAX))) {
+      } else if (order > std::floor(std::sqrt(INT64_MAX))) {
         throw "ERROR: matrix dimension too large - overflow risk";
       }
 
       // default tile size for tiling of local transpose
-      tile_size = (argc>3) ? std::atoi(argv[3]) : 32;
+      tile_size = (argc>3) ? std::atoll(argv[3]) : 32;
       // a negative tile size means no tiling of the local transpose
       if (tile_size <= 0) tile_size = order;
   }
@@ -111,9 +111,9 @@ int main(int argc, char * argv[])
   OMP_PARALLEL()
   {
     OMP_FOR()
-    for (auto i=0;i<order; i++) {
+    for (int64_t i=0;i<order; i++) {
       PRAGMA_SIMD
-      for (auto j=0;j<order;j++) {
+      for (int64_t j=0;j<order;j++) {
         A[i*order+j] = static_cast<double>(i*order+j);
         B[i*order+j] = 0.0;
       }
@@ -130,8 +130,8 @@ int main(int argc, char * argv[])
       // transpose the  matrix
       if (tile_size < order) {
         OMP_TARGET( teams distribute parallel for simd collapse(2) )
-        for (auto it=0; it<order; it+=tile_size) {
-          for (auto jt=0; jt<order; jt+=tile_size) {
+        for (int64_t it=0; it<order; it+=tile_size) {
+          for (int64_t jt=0; jt<order; jt+=tile_size) {
             for (auto i=it; i<std::min(order,it+tile_size); i++) {
               for (auto j=jt; j<std::min(order,jt+tile_size); j++) {
                 B[i*order+j] += A[j*order+i];
@@ -142,8 +142,8 @@ int main(int argc, char * argv[])
         }
       } else {
         OMP_TARGET( teams distribute parallel for simd collapse(2) schedule(static,1) )
-        for (auto i=0;i<order; i++) {
-          for (auto j=0;j<order;j++) {
+        for (int64_t i=0;i<order; i++) {
+          for (int64_t j=0;j<order;j++) {
             B[i*order+j] += A[j*order+i];
             A[j*order+i] += 1.0;
           }
@@ -160,10 +160,10 @@ int main(int argc, char * argv[])
   const auto addit = (iterations+1.) * (iterations/2.);
   auto abserr = 0.0;
   OMP_PARALLEL_FOR_REDUCE( +:abserr )
-  for (auto j=0; j<order; j++) {
-    for (auto i=0; i<order; i++) {
-      const int ij = i*order+j;
-      const int ji = j*order+i;
+  for (int64_t j=0; j<order; j++) {
+    for (int64_t i=0; i<order; i++) {
+      const int64_t ij = i*order+j;
+      const int64_t ji = j*order+i;
       const double reference = static_cast<double>(ij)*(1.+iterations)+addit;
       abserr += std::fabs(B[ji] - reference);
     }
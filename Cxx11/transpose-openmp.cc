@@ -53,6 +53,7 @@
 //////////////////////////////////////////////////////////////////////
 
 #include "prk_util.h"
+#include "transpose-kernel.h"
 
 int main(int argc, char * argv[])
 {
@@ -68,8 +69,8 @@ int main(int argc, char * argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int order;
-  int tile_size;
+  int64_t order;
+  int64_t tile_size;
   try {
       if (argc < 3) {
         throw "Usage: <# iterations> <matrix order> [tile size]";
@@ -82,15 +83,15 @@ int main(int argc, char * argv[])
       }
 
       // order of a the matrix
-      order = std::atoi(argv[2]);
+      order = std::atoll(argv[2]);
       if (order <= 0) {
         throw "ERROR: Matrix Order must be greater than 0";
-      } else if (order > std::floor(std::sqrt(INT_MAX))) {
+      } else if (order > std::floor(std::sqrt(INT64_MAX))) {
         throw "ERROR: matrix dimension too large - overflow risk";
       }
 
       // default tile size for tiling of local transpose
-      tile_size = (argc>3) ? std::atoi(argv[3]) : 32;
+      tile_size = (argc>3) ? std::atoll(argv[3]) : 32;
       // a negative tile size means no tiling of the local transpose
       if (tile_size <= 0) tile_size = order;
   }
@@ -117,14 +118,7 @@ int main(int argc, char * argv[])
 
   OMP_PARALLEL()
   {
-    OMP_FOR()
-    for (auto i=0;i<order; i++) {
-      PRAGMA_SIMD
-      for (auto j=0;j<order;j++) {
-        A[i*order+j] = static_cast<double>(i*order+j);
-        B[i*order+j] = 0.0;
-      }
-    }
+    transpose_init(order, A, B);
 
     for (auto iter = 0; iter<=iterations; iter++) {
 
@@ -135,30 +129,7 @@ int main(int argc, char * argv[])
       }
 
       // transpose the  matrix
-      if (tile_size < order) {
-        OMP_FOR()
-        for (auto it=0; it<order; it+=tile_size) {
-          for (auto jt=0; jt<order; jt+=tile_size) {
-            PRAGMA_SIMD
-            for (auto i=it; i<std::min(order,it+tile_size); i++) {
-              PRAGMA_SIMD
-              for (auto j=jt; j<std::min(order,jt+tile_size); j++) {
-                B[i*order+j] += A[j*order+i];
-                A[j*order+i] += 1.0;
-              }
-            }
-          }
-        }
-      } else {
-        OMP_FOR()
-        for (auto i=0;i<order; i++) {
-        PRAGMA_SIMD
-          for (auto j=0;j<order;j++) {
-            B[i*order+j] += A[j*order+i];
-            A[j*order+i] += 1.0;
-          }
-        }
-      }
+      transpose_tiled(order, tile_size, A, B);
     }
     OMP_BARRIER
     OMP_MASTER
@@ -169,17 +140,7 @@ int main(int argc, char * argv[])
   /// Analyze and output results
   //////////////////////////////////////////////////////////////////////
 
-  const auto addit = (iterations+1.) * (iterations/2.);
-  auto abserr = 0.0;
-  OMP_PARALLEL_FOR_REDUCE( +:abserr )
-  for (auto j=0; j<order; j++) {
-    for (auto i=0; i<order; i++) {
-      const int ij = i*order+j;
-      const int ji = j*order+i;
-      const double reference = static_cast<double>(ij)*(1.+iterations)+addit;
-      abserr += std::fabs(B[ji] - reference);
-    }
-  }
+  const auto abserr = transpose_error(iterations, order, B);
 
 #ifdef VERBOSE
   std::cout << "Sum of absolute differences: " << abserr << std::endl;
@@ -192,6 +153,10 @@ int main(int argc, char * argv[])
     auto bytes = (size_t)order * (size_t)order * sizeof(double);
     std::cout << "Rate (MB/s): " << 1.0e-6 * (2L*bytes)/avgtime
               << " Avg time (s): " << avgtime << std::endl;
+    // the rate counts reading A and writing B, but A is updated as well
+    // and B is accumulated into, so each is read and written
+    const prk::work_model work{2.0*order*order, 4.0*bytes};
+    prk::roofline::print(work, avgtime);
   } else {
     std::cout << "ERROR: Aggregate squared error " << abserr
               << " exceeds threshold " << epsilon << std::endl;
@@ -62,8 +62,8 @@ int main(int argc, char * argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int order;
-  int tile_size;
+  int64_t order;
+  int64_t tile_size;
   bool permute = false;
   try {
       if (argc < 3) {
@@ -75,15 +75,15 @@ int main(int argc, char * argv[])
         throw "ERROR: iterations must be >= 1";
       }
 
-      order = std::atoi(argv[2]);
+      order = std::atoll(argv[2]);
       if (order <= 0) {
         throw "ERROR: Matrix Order must be greater than 0";
-      } else if (order > std::floor(std::sqrt(INT_MAX))) {
+      } else if (order > std::floor(std::sqrt(INT64_MAX))) {
         throw "ERROR: matrix dimension too large - overflow risk";
       }
 
       // default tile size for tiling of local transpose
-      tile_size = (argc>3) ? std::atoi(argv[3]) : 32;
+      tile_size = (argc>3) ? std::atoll(argv[3]) : 32;
       // a negative tile size means no tiling of the local transpose
       if (tile_size <= 0) tile_size = order;
 
@@ -125,7 +125,7 @@ int main(int argc, char * argv[])
   RAJA::RangeSegment range(0, order);
   auto range2d = RAJA::make_tuple(range, range);
 
-  RAJA::kernel<regular_policy>(range2d, [=](int i, int j) {
+  RAJA::kernel<regular_policy>(range2d, [=](RAJA::Index_type i, RAJA::Index_type j) {
       A(i,j) = static_cast<double>(i*order+j);
       B(i,j) = 0.0;
   });
@@ -135,12 +135,12 @@ int main(int argc, char * argv[])
     if (iter==1) trans_time = prk::wtime();
 
     if (permute) {
-        RAJA::kernel<permute_policy>(range2d, [=](int i, int j) {
+        RAJA::kernel<permute_policy>(range2d, [=](RAJA::Index_type i, RAJA::Index_type j) {
             B(i,j) += A(j,i);
             A(j,i) += 1.0;
         });
     } else {
-        RAJA::kernel<regular_policy>(range2d, [=](int i, int j) {
+        RAJA::kernel<regular_policy>(range2d, [=](RAJA::Index_type i, RAJA::Index_type j) {
             B(i,j) += A(j,i);
             A(j,i) += 1.0;
         });
@@ -158,7 +158,7 @@ int main(int argc, char * argv[])
 
   double const addit = (iterations+1.) * (0.5*iterations);
   RAJA::ReduceSum<reduce_exec, double> abserr(0.0);
-  RAJA::kernel<reduce_policy>(range2d, [=](int i, int j) {
+  RAJA::kernel<reduce_policy>(range2d, [=](RAJA::Index_type i, RAJA::Index_type j) {
       double const ij = static_cast<double>(i*order+j);
       double const reference = ij*(1.+iterations)+addit;
       abserr += std::fabs(B(j,i) - reference);
@@ -64,8 +64,8 @@ int main(int argc, char * argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int order;
-  int tile_size;
+  int64_t order;
+  int64_t tile_size;
   try {
       if (argc < 3) {
         throw "Usage: <# iterations> <matrix order> [tile size]";
@@ -78,15 +78,15 @@ int main(int argc, char * argv[])
       }
 
       // order of a the matrix
-      order = std::atoi(argv[2]);
+      order = std::atoll(argv[2]);
       if (order <= 0) {
         throw "ERROR: Matrix Order must be greater than 0";
-      } else if (order > std::floor(std::sqrt(INT_MAX))) {
+      } else if (order > std::floor(std::sqrt(INT64_MAX))) {
         throw "ERROR: matrix dimension too large - overflow risk";
       }
 
       // default tile size for tiling of local transpose
-      tile_size = (argc>3) ? std::atoi(argv[3]) : 32;
+      tile_size = (argc>3) ? std::atoll(argv[3]) : 32;
       // a negative tile size means no tiling of the local transpose
       if (tile_size <= 0) tile_size = order;
 
@@ -108,8 +108,8 @@ int main(int argc, char * argv[])
   std::valarray<double> B(0.0,order*order);
 
   auto trans_time = 0.0;
-  for (auto j=0; j<order; j++) {
-    for (auto i=0; i<order; i++) {
+  for (int64_t j=0; j<order; j++) {
+    for (int64_t i=0; i<order; i++) {
       A[j*order+i] = order*j+i;
     }
   }
@@ -120,8 +120,8 @@ int main(int argc, char * argv[])
 
     // transpose the  matrix
     if (tile_size < order) {
-      for (auto it=0; it<order; it+=tile_size) {
-        for (auto jt=0; jt<order; jt+=tile_size) {
+      for (int64_t it=0; it<order; it+=tile_size) {
+        for (int64_t jt=0; jt<order; jt+=tile_size) {
           for (auto i=it; i<std::min(order,it+tile_size); i++) {
             for (auto j=jt; j<std::min(order,jt+tile_size); j++) {
               B[i*order+j] += A[j*order+i];
@@ -131,8 +131,8 @@ int main(int argc, char * argv[])
         }
       }
     } else {
-      for (auto i=0;i<order; i++) {
-        for (auto j=0;j<order;j++) {
+      for (int64_t i=0;i<order; i++) {
+        for (int64_t j=0;j<order;j++) {
           B[i*order+j] += A[j*order+i];
           A[j*order+i] += 1.0;
         }
@@ -148,10 +148,10 @@ int main(int argc, char * argv[])
   // TODO: replace with std::generate, std::accumulate, or similar
   const auto addit = (iterations+1.) * (iterations/2.);
   auto abserr = 0.0;
-  for (auto j=0; j<order; j++) {
-    for (auto i=0; i<order; i++) {
-      const int ij = i*order+j;
-      const int ji = j*order+i;
+  for (int64_t j=0; j<order; j++) {
+    for (int64_t i=0; i<order; i++) {
+      const int64_t ij = i*order+j;
+      const int64_t ji = j*order+i;
       const double reference = static_cast<double>(ij)*(1.+iterations)+addit;
       abserr += std::fabs(B[ji] - reference);
     }
@@ -168,6 +168,10 @@ int main(int argc, char * argv[])
     auto bytes = (size_t)order * (size_t)order * sizeof(double);
     std::cout << "Rate (MB/s): " << 1.0e-6 * (2L*bytes)/avgtime
               << " Avg time (s): " << avgtime << std::endl;
+    // the rate counts reading A and writing B, but A is updated as well
+    // and B is accumulated into, so each is read and written
+    const prk::work_model work{2.0*order*order, 4.0*bytes};
+    prk::roofline::print(work, avgtime);
   } else {
     std::cout << "ERROR: Aggregate squared error " << abserr
               << " exceeds threshold " << epsilon << std::endl;
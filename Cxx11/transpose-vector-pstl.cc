@@ -68,7 +68,7 @@ int main(int argc, char * argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int order;
+  int64_t order;
   try {
       if (argc < 3) {
         throw "Usage: <# iterations> <matrix order>";
@@ -81,10 +81,10 @@ int main(int argc, char * argv[])
       }
 
       // order of a the matrix
-      order = std::atoi(argv[2]);
+      order = std::atoll(argv[2]);
       if (order <= 0) {
         throw "ERROR: Matrix Order must be greater than 0";
-      } else if (order > std::floor(std::sqrt(INT_MAX))) {
+      } else if (order > std::floor(std::sqrt(INT64_MAX))) {
         throw "ERROR: matrix dimension too large - overflow risk";
       }
   }
@@ -116,15 +116,15 @@ int main(int argc, char * argv[])
 
     // transpose
 #if defined(USE_PSTL) && defined(USE_INTEL_PSTL)
-  std::for_each( exec::par, std::begin(range), std::end(range), [&] (int i) {
-    std::for_each( exec::unseq, std::begin(range), std::end(range), [&] (int j) {
+  std::for_each( exec::par, std::begin(range), std::end(range), [&] (int64_t i) {
+    std::for_each( exec::unseq, std::begin(range), std::end(range), [&] (int64_t j) {
 #elif defined(USE_PSTL) && defined(__GNUC__) && defined(__GNUC_MINOR__) \
                         && ( (__GNUC__ == 8) || (__GNUC__ == 7) && (__GNUC_MINOR__ >= 2) )
-  __gnu_parallel::for_each( std::begin(range), std::end(range), [&] (int i) {
-    __gnu_parallel::for_each( std::begin(range), std::end(range), [&] (int j) {
+  __gnu_parallel::for_each( std::begin(range), std::end(range), [&] (int64_t i) {
+    __gnu_parallel::for_each( std::begin(range), std::end(range), [&] (int64_t j) {
 #else
-  std::for_each( std::begin(range), std::end(range), [&] (int i) {
-    std::for_each( std::begin(range), std::end(range), [&] (int j) {
+  std::for_each( std::begin(range), std::end(range), [&] (int64_t i) {
+    std::for_each( std::begin(range), std::end(range), [&] (int64_t j) {
 #endif
         B[i*order+j] += A[j*order+i];
         A[j*order+i] += 1.0;
@@ -142,8 +142,8 @@ int main(int argc, char * argv[])
   auto abserr = 0.0;
   for (auto i : range) {
     for (auto j : range) {
-      const int ij = i*order+j;
-      const int ji = j*order+i;
+      const int64_t ij = i*order+j;
+      const int64_t ji = j*order+i;
       const double reference = static_cast<double>(ij)*(1.+iterations)+addit;
       abserr += std::fabs(B[ji] - reference);
     }
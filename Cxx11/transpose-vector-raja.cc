@@ -95,34 +95,34 @@ typedef RAJA::NestedPolicy<RAJA::ExecList<RAJA::tbb_for_dynamic, RAJA::simd_exec
 #endif
 
 template <typename exec_policy, typename LoopBody>
-void Lambda(int order, LoopBody body)
+void Lambda(indx order, LoopBody body)
 {
     RAJA::forallN<exec_policy>( range(0, order), range(0, order), body);
 }
 
 template <typename exec_policy>
-void Initialize(int order, std::vector<double> & A, std::vector<double> & B)
+void Initialize(indx order, std::vector<double> & A, std::vector<double> & B)
 {
-    Lambda<exec_policy>(order, [=,&A,&B](int i, int j) {
+    Lambda<exec_policy>(order, [=,&A,&B](indx i, indx j) {
         A[i*order+j] = static_cast<double>(i*order+j);
         B[i*order+j] = 0.0;
     });
 }
 
 template <typename exec_policy>
-void Transpose(int order, std::vector<double> & A, std::vector<double> & B)
+void Transpose(indx order, std::vector<double> & A, std::vector<double> & B)
 {
-    Lambda<exec_policy>(order, [=,&A,&B](int i, int j) {
+    Lambda<exec_policy>(order, [=,&A,&B](indx i, indx j) {
         B[i*order+j] += A[j*order+i];
         A[j*order+i] += 1.0;
     });
 }
 
 template <typename outer_policy, typename inner_policy>
-void Initialize(int order, std::vector<double> & A, std::vector<double> & B)
+void Initialize(indx order, std::vector<double> & A, std::vector<double> & B)
 {
-    RAJA::forall<outer_policy>(0, order, [=,&A,&B](int i) {
-      RAJA::forall<inner_policy>(0, order, [=,&A,&B](int j) {
+    RAJA::forall<outer_policy>(indx(0), order, [=,&A,&B](indx i) {
+      RAJA::forall<inner_policy>(indx(0), order, [=,&A,&B](indx j) {
         A[i*order+j] = static_cast<double>(i*order+j);
         B[i*order+j] = 0.0;
       });
@@ -130,10 +130,10 @@ void Initialize(int order, std::vector<double> & A, std::vector<double> & B)
 }
 
 template <typename outer_policy, typename inner_policy>
-void Transpose(int order, std::vector<double> & A, std::vector<double> & B)
+void Transpose(indx order, std::vector<double> & A, std::vector<double> & B)
 {
-    RAJA::forall<outer_policy>(0, order, [=,&A,&B](int i) {
-      RAJA::forall<inner_policy>(0, order, [=,&A,&B](int j) {
+    RAJA::forall<outer_policy>(indx(0), order, [=,&A,&B](indx i) {
+      RAJA::forall<inner_policy>(indx(0), order, [=,&A,&B](indx j) {
         B[i*order+j] += A[j*order+i];
         A[j*order+i] += 1.0;
       });
@@ -141,11 +141,11 @@ void Transpose(int order, std::vector<double> & A, std::vector<double> & B)
 }
 
 template <typename loop_policy, typename reduce_policy>
-double Error(int iterations, int order, std::vector<double> & B)
+double Error(int iterations, indx order, std::vector<double> & B)
 {
       RAJA::ReduceSum<reduce_policy, double> abserr(0.0);
       typedef RAJA::NestedPolicy<RAJA::ExecList<loop_policy, RAJA::seq_exec>> exec_policy;
-      RAJA::forallN<exec_policy>( range(0, order), range(0, order), [=,&B](int i, int j) {
+      RAJA::forallN<exec_policy>( range(0, order), range(0, order), [=,&B](indx i, indx j) {
           const auto dij = static_cast<double>(i*order+j);
           const auto addit = (iterations+1.) * (0.5*iterations);
           const auto reference = dij*(1.+iterations)+addit;
@@ -171,7 +171,8 @@ int main(int argc, char * argv[])
       return argc;
   }
 
-  int iterations, order;
+  int iterations;
+  indx order;
   std::string use_for="seq", use_permute="no";
   auto use_simd=true, use_nested=true, use_tiled=false;
   try {
@@ -183,10 +184,10 @@ int main(int argc, char * argv[])
       }
 
       // order of a the matrix
-      order = std::atoi(argv[2]);
+      order = std::atoll(argv[2]);
       if (order <= 0) {
         throw "ERROR: Matrix Order must be greater than 0";
-      } else if (order > std::floor(std::sqrt(INT_MAX))) {
+      } else if (order > std::floor(std::sqrt(INT64_MAX))) {
         throw "ERROR: matrix dimension too large - overflow risk";
       }
 
@@ -54,6 +54,7 @@
 
 #include "prk_util.h"
 #include "prk_tbb.h"
+#include "prk_affinity.h"
 
 int main(int argc, char * argv[])
 {
@@ -65,8 +66,9 @@ int main(int argc, char * argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int order;
-  int tile_size;
+  int64_t order;
+  int64_t tile_size;
+  prk::affinity affinity;
   try {
       if (argc < 3) {
         throw "Usage: <# iterations> <matrix order> [tile size]";
@@ -79,17 +81,19 @@ int main(int argc, char * argv[])
       }
 
       // order of a the matrix
-      order = std::atoi(argv[2]);
+      order = std::atoll(argv[2]);
       if (order <= 0) {
         throw "ERROR: Matrix Order must be greater than 0";
-      } else if (order > std::floor(std::sqrt(INT_MAX))) {
+      } else if (order > std::floor(std::sqrt(INT64_MAX))) {
         throw "ERROR: matrix dimension too large - overflow risk";
       }
 
       // default tile size for tiling of local transpose
-      tile_size = (argc>3) ? std::atoi(argv[3]) : 32;
+      tile_size = (argc>3) ? std::atoll(argv[3]) : 32;
       // a negative tile size means no tiling of the local transpose
       if (tile_size <= 0) tile_size = order;
+
+      affinity = prk::get_affinity();
   }
   catch (const char * e) {
     std::cout << e << std::endl;
@@ -99,8 +103,10 @@ int main(int argc, char * argv[])
   const char* envvar = std::getenv("TBB_NUM_THREADS");
   int num_threads = (envvar!=NULL) ? std::atoi(envvar) : tbb::task_scheduler_init::default_num_threads();
   tbb::task_scheduler_init init(num_threads);
+  prk::affinity_observer observer(affinity);
 
   std::cout << "Number of threads    = " << num_threads << std::endl;
+  affinity.print(num_threads);
   std::cout << "Number of iterations = " << iterations << std::endl;
   std::cout << "Matrix order         = " << order << std::endl;
   std::cout << "Tile size            = " << tile_size << std::endl;
@@ -115,7 +121,7 @@ int main(int argc, char * argv[])
   std::vector<double> A(order*order);
   std::vector<double> B(order*order);
 
-  tbb::blocked_range2d<int> range(0, order, tile_size, 0, order, tile_size);
+  tbb::blocked_range2d<int64_t> range(0, order, tile_size, 0, order, tile_size);
   tbb::parallel_for( range, [&](decltype(range)& r) {
                      for (auto i=r.rows().begin(); i!=r.rows().end(); ++i ) {
                          PRAGMA_SIMD
@@ -148,10 +154,10 @@ int main(int argc, char * argv[])
   double abserr(0);
 #if 0
   // Use this if, for whatever reason, TBB reductions are not reliable.
-  for (auto j=0; j<order; j++) {
-    for (auto i=0; i<order; i++) {
-      const int ij = i*order+j;
-      const int ji = j*order+i;
+  for (int64_t j=0; j<order; j++) {
+    for (int64_t i=0; i<order; i++) {
+      const int64_t ij = i*order+j;
+      const int64_t ji = j*order+i;
       const double reference = static_cast<double>(ij)*(1.+iterations)+addit;
       abserr += std::fabs(B[ji] - reference);
     }
@@ -161,8 +167,8 @@ int main(int argc, char * argv[])
                                  [&](decltype(range)& r, double temp) -> double {
                                      for (auto i=r.rows().begin(); i!=r.rows().end(); ++i ) {
                                          for (auto j=r.cols().begin(); j!=r.cols().end(); ++j ) {
-                                             const int ij = i*order+j;
-                                             const int ji = j*order+i;
+                                             const int64_t ij = i*order+j;
+                                             const int64_t ji = j*order+i;
                                              const double reference = static_cast<double>(ij)*(1.+iterations)+addit;
                                              temp += std::fabs(B[ji] - reference);
                                          }
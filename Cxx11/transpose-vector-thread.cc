@@ -39,10 +39,12 @@
 /// USAGE:   Program input is the matrix order and the number of times to
 ///          repeat the operation:
 ///
-///          transpose <matrix_size> <# iterations> [tile size]
+///          transpose <# iterations> <matrix_size> <block size|auto> [tile size]
 ///
 ///          An optional parameter specifies the tile size used to divide the
 ///          individual matrix blocks for improved cache and TLB performance.
+///          With block size "auto", the block and tile sizes are found
+///          together by prk::autotune and cached.
 ///
 ///          The output consists of diagnostics to make sure the
 ///          transpose worked and timing statistics.
@@ -53,6 +55,8 @@
 //////////////////////////////////////////////////////////////////////
 
 #include "prk_util.h"
+#include "prk_autotune.h"
+#include "prk_affinity.h"
 
 // These headers are busted with NVCC and GCC 5.4.0
 // The <future> header is busted with Cray C++ 8.6.1.
@@ -71,12 +75,14 @@ int main(int argc, char * argv[])
   //////////////////////////////////////////////////////////////////////
 
   int iterations;
-  int order;
-  int tile_size;
-  int block_size;
+  int64_t order;
+  int64_t tile_size;
+  int64_t block_size;
+  bool autotune = false;
+  prk::affinity affinity;
   try {
-      if (argc < 3) {
-        throw "Usage: <# iterations> <matrix order> <block size> [tile size]";
+      if (argc < 4) {
+        throw "Usage: <# iterations> <matrix order> <block size|auto> [tile size]";
       }
 
       // number of times to do the transpose
@@ -86,12 +92,13 @@ int main(int argc, char * argv[])
       }
 
       // order of a the matrix
-      order = std::atoi(argv[2]);
+      order = std::atoll(argv[2]);
       if (order <= 0) {
         throw "ERROR: Matrix Order must be greater than 0";
       }
 
-      block_size = std::atoi(argv[3]);
+      autotune = std::string(argv[3]) == "auto";
+      block_size = autotune ? order : std::atoll(argv[3]);
       if (block_size <= 0) {
         throw "ERROR: block size must be greater than 0";
       }
@@ -101,15 +108,66 @@ int main(int argc, char * argv[])
       }
 
       // default tile size for tiling of local transpose
-      tile_size = (argc>4) ? std::atoi(argv[4]) : 32;
+      tile_size = (argc>4) ? std::atoll(argv[4]) : 32;
       // a negative tile size means no tiling of the local transpose
       if (tile_size <= 0) tile_size = block_size;
+
+      affinity = prk::get_affinity();
   }
   catch (const char * e) {
     std::cout << e << std::endl;
     return 1;
   }
 
+  //////////////////////////////////////////////////////////////////////
+  // Allocate space and perform the computation
+  //////////////////////////////////////////////////////////////////////
+
+  std::vector<double> A(order*order);
+  std::vector<double> B(order*order,0.0);
+
+  std::vector<std::thread> pool;
+
+  auto transpose = [&] (int64_t block_size, int64_t tile_size) {
+      for (int64_t ib=0; ib<order; ib+=block_size) {
+        for (int64_t jb=0; jb<order; jb+=block_size) {
+          const int tid = static_cast<int>(pool.size());
+          pool.push_back(std::thread([=,&A,&B,&affinity] {
+            affinity.pin(tid);
+            // the last block is partial when block_size does not divide order
+            const auto iend = std::min(order,ib+block_size);
+            const auto jend = std::min(order,jb+block_size);
+            for (auto it=ib; it<iend; it+=tile_size) {
+              for (auto jt=jb; jt<jend; jt+=tile_size) {
+                for (auto i=it; i<std::min(iend,it+tile_size); i++) {
+                  for (auto j=jt; j<std::min(jend,jt+tile_size); j++) {
+                    B[i*order+j] += A[j*order+i];
+                    A[j*order+i] += 1.0;
+                  }
+                }
+              }
+            }
+          } ));
+        }
+      }
+      std::for_each(pool.begin(), pool.end(), [](std::thread & t) { t.join(); });
+      pool.clear();
+  };
+
+  // trials run on the real matrices, which are initialized afterwards;
+  // blocks no smaller than order/16 keep the thread count at most 256
+  if (autotune) {
+    prk::autotune tuner("transpose-vector-thread", "order=" + std::to_string(order),
+                        {{"block_size", prk::divceil(order,16), order}, {"tile_size", 4, order}});
+    auto best = tuner.tune([&] (const prk::autotune::point & p) {
+                             double t = prk::wtime();
+                             transpose(p[0], p[1]);
+                             return prk::wtime() - t;
+                           });
+    block_size = best[0];
+    tile_size  = best[1];
+  }
+
   int num_threads = order/block_size;
   if (order % block_size) num_threads++;
   num_threads *= num_threads;
@@ -119,6 +177,7 @@ int main(int argc, char * argv[])
   std::cout << "Matrix order          = " << order << std::endl;
   std::cout << "Block size            = " << block_size << std::endl;
   std::cout << "Tile size             = " << tile_size << std::endl;
+  affinity.print(num_threads);
 
   if (num_threads > 300) {
       std::cout << "These settings may lead to resource exhaustion.\n"
@@ -126,42 +185,17 @@ int main(int argc, char * argv[])
       return 1;
   }
 
-  //////////////////////////////////////////////////////////////////////
-  // Allocate space and perform the computation
-  //////////////////////////////////////////////////////////////////////
-
-  std::vector<double> A(order*order);
-  std::vector<double> B(order*order,0.0);
-
   // fill A with the sequence 0 to order^2-1 as doubles
   std::iota(A.begin(), A.end(), 0.0);
+  std::fill(B.begin(), B.end(), 0.0);
 
   auto trans_time = 0.0;
 
-  std::vector<std::thread> pool;
-
   for (auto iter = 0; iter<=iterations; iter++) {
 
     if (iter==1) trans_time = prk::wtime();
 
-    for (auto ib=0; ib<order; ib+=block_size) {
-      for (auto jb=0; jb<order; jb+=block_size) {
-        pool.push_back(std::thread([=,&A,&B] {
-          for (auto it=ib; it<std::min(order,ib+block_size); it+=tile_size) {
-            for (auto jt=jb; jt<std::min(order,jb+block_size); jt+=tile_size) {
-              for (auto i=it; i<std::min(ib+block_size,it+tile_size); i++) {
-                for (auto j=jt; j<std::min(jb+block_size,jt+tile_size); j++) {
-                  B[i*order+j] += A[j*order+i];
-                  A[j*order+i] += 1.0;
-                }
-              }
-            }
-          }
-        } ));
-      }
-    }
-    std::for_each(pool.begin(), pool.end(), [](std::thread & t) { t.join(); });
-    pool.clear();
+    transpose(block_size, tile_size);
   }
   trans_time = prk::wtime() - trans_time;
 
@@ -172,10 +206,10 @@ int main(int argc, char * argv[])
   // TODO: replace with std::generate, std::accumulate, or similar
   const auto addit = (iterations+1.) * (iterations/2.);
   auto abserr = 0.0;
-  for (auto j=0; j<order; j++) {
-    for (auto i=0; i<order; i++) {
-      const int ij = i*order+j;
-      const int ji = j*order+i;
+  for (int64_t j=0; j<order; j++) {
+    for (int64_t i=0; i<order; i++) {
+      const int64_t ij = i*order+j;
+      const int64_t ji = j*order+i;
       const double reference = static_cast<double>(ij)*(1.+iterations)+addit;
       abserr += std::fabs(B[ji] - reference);
     }
@@ -192,6 +226,10 @@ int main(int argc, char * argv[])
     auto bytes = (size_t)order * (size_t)order * sizeof(double);
     std::cout << "Rate (MB/s): " << 1.0e-6 * (2L*bytes)/avgtime
               << " Avg time (s): " << avgtime << std::endl;
+    // the rate counts reading A and writing B, but A is updated as well
+    // and B is accumulated into, so each is read and written
+    const prk::work_model work{2.0*order*order, 4.0*bytes};
+    prk::roofline::print(work, avgtime, num_threads);
   } else {
     std::cout << "ERROR: Aggregate squared error " << abserr
               << " exceeds threshold " << epsilon << std::endl;
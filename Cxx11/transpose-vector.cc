@@ -39,10 +39,12 @@
 /// USAGE:   Program input is the matrix order and the number of times to
 ///          repeat the operation:
 ///
-///          transpose <matrix_size> <# iterations> [tile size]
+///          transpose <matrix_size> <# iterations> [tile size|auto]
 ///
 ///          An optional parameter specifies the tile size used to divide the
 ///          individual matrix blocks for improved cache and TLB performance.
+///          With "auto", the tile size is found by prk::autotune and cached.
+///          The element type is chosen with PRK_PRECISION (see prk_types.h).
 ///
 ///          The output consists of diagnostics to make sure the
 ///          transpose worked and timing statistics.
@@ -53,89 +55,91 @@
 //////////////////////////////////////////////////////////////////////
 
 #include "prk_util.h"
+#include "prk_autotune.h"
 
-int main(int argc, char * argv[])
+template <typename T>
+int transpose(int iterations, int64_t order, int64_t tile_size, bool autotune)
 {
-  std::cout << "Parallel Research Kernels version " << PRKVERSION << std::endl;
-  std::cout << "C++11 Matrix transpose: B = A^T" << std::endl;
-
-  //////////////////////////////////////////////////////////////////////
-  // Read and test input parameters
-  //////////////////////////////////////////////////////////////////////
+  using U = typename prk::precision_traits<T>::compute;
 
-  int iterations;
-  int order;
-  int tile_size;
-  try {
-      if (argc < 3) {
-        throw "Usage: <# iterations> <matrix order> [tile size]";
-      }
+  std::cout << "Precision            = " << prk::precision_traits<T>::description << std::endl;
 
-      iterations  = std::atoi(argv[1]);
-      if (iterations < 1) {
-        throw "ERROR: iterations must be >= 1";
-      }
-
-      order = std::atoi(argv[2]);
-      if (order <= 0) {
-        throw "ERROR: Matrix Order must be greater than 0";
-      } else if (order > std::floor(std::sqrt(INT_MAX))) {
-        throw "ERROR: matrix dimension too large - overflow risk";
-      }
-
-      // default tile size for tiling of local transpose
-      tile_size = (argc>3) ? std::atoi(argv[3]) : 32;
-      // a negative tile size means no tiling of the local transpose
-      if (tile_size <= 0) tile_size = order;
-  }
-  catch (const char * e) {
-    std::cout << e << std::endl;
+  // the 16-bit types cannot hold order^2, so A is scaled into [0,1)
+  const double scale = (sizeof(T) < sizeof(float)) ? 1.0/(static_cast<double>(order)*order) : 1.0;
+  const double largest = (static_cast<double>(order)*order-1.0)*scale*(1.+iterations)
+                       + (iterations+1.)*(iterations/2.);
+  if (largest > prk::precision_traits<T>::max) {
+    std::cout << "ERROR: too many iterations for the range of " << prk::precision_traits<T>::name << std::endl;
     return 1;
   }
 
-  std::cout << "Number of iterations = " << iterations << std::endl;
-  std::cout << "Matrix order         = " << order << std::endl;
-  std::cout << "Tile size            = " << tile_size << std::endl;
-
   //////////////////////////////////////////////////////////////////////
   // Allocate space and perform the computation
   //////////////////////////////////////////////////////////////////////
 
   auto trans_time = 0.0;
+  prk::counters counters;
 
-  std::vector<double> A(order*order);
-  std::vector<double> B(order*order,0.0);
-
-  // fill A with the sequence 0 to order^2-1 as doubles
-  std::iota(A.begin(), A.end(), 0.0);
-
-  {
-    for (auto iter = 0; iter<=iterations; iter++) {
-
-      if (iter==1) trans_time = prk::wtime();
+  std::vector<T> A(order*order);
+  std::vector<T> B(order*order,U(0));
 
-      // transpose the  matrix
+  auto kernel = [&] (int64_t tile_size) {
       if (tile_size < order) {
-        for (auto it=0; it<order; it+=tile_size) {
-          for (auto jt=0; jt<order; jt+=tile_size) {
+        for (int64_t it=0; it<order; it+=tile_size) {
+          for (int64_t jt=0; jt<order; jt+=tile_size) {
             for (auto i=it; i<std::min(order,it+tile_size); i++) {
               for (auto j=jt; j<std::min(order,jt+tile_size); j++) {
                 B[i*order+j] += A[j*order+i];
-                A[j*order+i] += 1.0;
+                A[j*order+i] += U(1);
               }
             }
           }
         }
       } else {
-        for (auto i=0;i<order; i++) {
-          for (auto j=0;j<order;j++) {
+        for (int64_t i=0;i<order; i++) {
+          for (int64_t j=0;j<order;j++) {
             B[i*order+j] += A[j*order+i];
-            A[j*order+i] += 1.0;
+            A[j*order+i] += U(1);
           }
         }
       }
+  };
+
+  // trials run on the real matrices, which are initialized afterwards
+  if (autotune) {
+    prk::autotune tuner("transpose-vector",
+                        "order=" + std::to_string(order) + "," + prk::precision_traits<T>::name,
+                        {{"tile_size", 4, order}});
+    tile_size = tuner.tune([&] (const prk::autotune::point & p) {
+                             double t = prk::wtime();
+                             kernel(p[0]);
+                             return prk::wtime() - t;
+                           })[0];
+  }
+  std::cout << "Tile size            = " << tile_size << std::endl;
+
+  // fill A with the sequence 0 to order^2-1, times scale
+  for (size_t ij=0; ij<A.size(); ij++) {
+    A[ij] = U(static_cast<double>(ij)*scale);
+  }
+  std::fill(B.begin(), B.end(), U(0));
+
+  {
+    for (auto iter = 0; iter<=iterations; iter++) {
+
+      prk::cold::flush(counters, {A, B});
+
+      if (iter==1) {
+        trans_time = prk::wtime();
+        counters.start();
+        prk::cold::start();
+      }
+
+      // transpose the  matrix
+      kernel(tile_size);
     }
-    trans_time = prk::wtime() - trans_time;
+    trans_time = prk::wtime() - trans_time - prk::cold::elapsed();
+    counters.stop();
   }
 
   //////////////////////////////////////////////////////////////////////
@@ -144,13 +148,15 @@ int main(int argc, char * argv[])
 
   const auto addit = (iterations+1.) * (iterations/2.);
   double abserr(0);
+  double refsum(0);
   // TODO: replace with std::generate, std::accumulate, or similar
-  for (auto j=0; j<order; j++) {
-    for (auto i=0; i<order; i++) {
-      const int ij = i*order+j;
-      const int ji = j*order+i;
-      const double reference = static_cast<double>(ij)*(1.+iterations)+addit;
-      abserr += std::fabs(B[ji] - reference);
+  for (int64_t j=0; j<order; j++) {
+    for (int64_t i=0; i<order; i++) {
+      const int64_t ij = i*order+j;
+      const int64_t ji = j*order+i;
+      const double reference = static_cast<double>(ij)*scale*(1.+iterations)+addit;
+      abserr += std::fabs(static_cast<double>(B[ji]) - reference);
+      refsum += reference;
     }
   }
 
@@ -158,13 +164,20 @@ int main(int argc, char * argv[])
   std::cout << "Sum of absolute differences: " << abserr << std::endl;
 #endif
 
-  const auto epsilon = 1.0e-8;
+  // the double result is exact, so the error must vanish; narrower types
+  // round, so the error is taken relative to the size of the result
+  const auto epsilon = prk::precision_traits<T>::epsilon * (std::is_same<T,double>::value ? 1.0 : refsum);
   if (abserr < epsilon) {
     std::cout << "Solution validates" << std::endl;
     auto avgtime = trans_time/iterations;
-    auto bytes = (size_t)order * (size_t)order * sizeof(double);
+    auto bytes = (size_t)order * (size_t)order * sizeof(T);
     std::cout << "Rate (MB/s): " << 1.0e-6 * (2L*bytes)/avgtime
               << " Avg time (s): " << avgtime << std::endl;
+    // the rate counts reading A and writing B, but A is updated as well
+    // and B is accumulated into, so each is read and written
+    const prk::work_model work{2.0*order*order, 4.0*bytes};
+    counters.print(iterations*work.bytes, iterations*work.flops);
+    prk::roofline::print(work, avgtime);
   } else {
     std::cout << "ERROR: Aggregate squared error " << abserr
               << " exceeds threshold " << epsilon << std::endl;
@@ -174,4 +187,62 @@ int main(int argc, char * argv[])
   return 0;
 }
 
+int main(int argc, char * argv[])
+{
+  std::cout << "Parallel Research Kernels version " << PRKVERSION << std::endl;
+  std::cout << "C++11 Matrix transpose: B = A^T" << std::endl;
+
+  //////////////////////////////////////////////////////////////////////
+  // Read and test input parameters
+  //////////////////////////////////////////////////////////////////////
+
+  int iterations;
+  int64_t order;
+  int64_t tile_size;
+  bool autotune = false;
+  prk::precision precision;
+  try {
+      prk::cold::parse(argc, argv);
+
+      if (argc < 3) {
+        throw "Usage: <# iterations> <matrix order> [tile size|auto]";
+      }
+
+      iterations  = std::atoi(argv[1]);
+      if (iterations < 1) {
+        throw "ERROR: iterations must be >= 1";
+      }
+
+      order = std::atoll(argv[2]);
+      if (order <= 0) {
+        throw "ERROR: Matrix Order must be greater than 0";
+      } else if (order > std::floor(std::sqrt(INT64_MAX))) {
+        throw "ERROR: matrix dimension too large - overflow risk";
+      }
+
+      // default tile size for tiling of local transpose
+      autotune = (argc>3) && std::string(argv[3]) == "auto";
+      tile_size = (argc>3 && !autotune) ? std::atoll(argv[3]) : 32;
+      // a negative tile size means no tiling of the local transpose
+      if (tile_size <= 0) tile_size = order;
+
+      precision = prk::get_precision();
+  }
+  catch (const char * e) {
+    std::cout << e << std::endl;
+    return 1;
+  }
+
+  std::cout << "Number of iterations = " << iterations << std::endl;
+  prk::cold::print();
+  std::cout << "Matrix order         = " << order << std::endl;
+
+  switch (precision) {
+      case prk::precision::fp32: return transpose<float>(iterations, order, tile_size, autotune);
+      case prk::precision::bf16: return transpose<prk::bf16>(iterations, order, tile_size, autotune);
+      case prk::precision::fp16: return transpose<prk::fp16>(iterations, order, tile_size, autotune);
+      default:                   return transpose<double>(iterations, order, tile_size, autotune);
+  }
+}
+
 
@@ -8,10 +8,10 @@
 
 #pragma OPENCL EXTENSION cl_khr_fp64 : enable
 
-__kernel void transpose32(const int order, __global float * a, __global float * b)
+__kernel void transpose32(const long order, __global float * a, __global float * b)
 {
-    const int i = get_global_id(0);
-    const int j = get_global_id(1);
+    const long i = get_global_id(0);
+    const long j = get_global_id(1);
 
     if ((i<order) && (j<order)) {
         b[i*order+j] += a[j*order+i];
@@ -19,10 +19,10 @@ __kernel void transpose32(const int order, __global float * a, __global float *
     }
 }
 
-__kernel void transpose64(const int order, __global double * a, __global double * b)
+__kernel void transpose64(const long order, __global double * a, __global double * b)
 {
-    const int i = get_global_id(0);
-    const int j = get_global_id(1);
+    const long i = get_global_id(0);
+    const long j = get_global_id(1);
 
     if ((i<order) && (j<order)) {
         b[i*order+j] += a[j*order+i];
@@ -321,24 +321,46 @@ case "$PRK_TARGET" in
         $PRK_TARGET_PATH/nstream-valarray   10 16777216 32
 
         # C++11 without external parallelism
-        make -C $PRK_TARGET_PATH p2p-vector p2p-hyperplane-vector stencil-vector transpose-vector nstream-vector \
-                                 dgemm-vector sparse-vector
+        make -C $PRK_TARGET_PATH p2p-vector p2p-hyperplane-vector p2p-hyperplane-skew-vector stencil-vector transpose-vector nstream-vector \
+                                 dgemm-vector sparse-vector pic-vector
         $PRK_TARGET_PATH/p2p-vector              10 1024 1024
         $PRK_TARGET_PATH/p2p-vector              10 1024 1024 100 100
         $PRK_TARGET_PATH/p2p-hyperplane-vector   10 1024
         $PRK_TARGET_PATH/p2p-hyperplane-vector   10 1024 64
+        $PRK_TARGET_PATH/p2p-hyperplane-skew-vector 10 1024
         $PRK_TARGET_PATH/stencil-vector          10 1000
         $PRK_TARGET_PATH/transpose-vector        10 1024 32
         $PRK_TARGET_PATH/nstream-vector          10 16777216 32
         $PRK_TARGET_PATH/dgemm-vector            10 400 400 # untiled
         $PRK_TARGET_PATH/dgemm-vector            10 400 32
+        $PRK_TARGET_PATH/transpose-vector        10 1024 32 --cold
+        $PRK_TARGET_PATH/dgemm-vector            10 400 32 --cold=flush
+        $PRK_TARGET_PATH/p2p-vector              10 1024 1024 --cold
+        export PRK_AUTOTUNE_DB=$PWD/prk-autotune.db
+        $PRK_TARGET_PATH/transpose-vector        10 1024 auto
+        $PRK_TARGET_PATH/transpose-vector        10 1024 auto # cached
+        $PRK_TARGET_PATH/stencil-vector          10 1000 auto
+        $PRK_TARGET_PATH/dgemm-vector            10 400 auto
         $PRK_TARGET_PATH/sparse-vector           10 10 5
+        $PRK_TARGET_PATH/pic-vector              10 1000 1000000 1 0 GEOMETRIC 0.99
+        $PRK_TARGET_PATH/pic-vector              10 1000 1000000 0 1 SINUSOIDAL
+        $PRK_TARGET_PATH/pic-vector              10 1000 1000000 1 0 LINEAR 1.0 3.0
+        $PRK_TARGET_PATH/pic-vector              10 1000 1000000 1 0 PATCH 0 200 100 200
         #echo "Test stencil code generator"
         for s in star grid ; do
             for r in 1 2 3 4 5 ; do
                 $PRK_TARGET_PATH/stencil-vector 10 200 20 $s $r
             done
         done
+        for p in float bf16 fp16 ; do
+            export PRK_PRECISION=$p
+            $PRK_TARGET_PATH/nstream-vector      10 16777216 32
+            $PRK_TARGET_PATH/transpose-vector    10 1024 32
+            $PRK_TARGET_PATH/stencil-vector      10 1000 20
+            $PRK_TARGET_PATH/dgemm-vector        10 400 32
+            $PRK_TARGET_PATH/sparse-vector       10 10 5
+        done
+        unset PRK_PRECISION
 
         # C++11 with CBLAS
         if [ "${TRAVIS_OS_NAME}" = "osx" ] ; then
@@ -349,9 +371,28 @@ case "$PRK_TARGET" in
         fi
 
         # C++11 native parallelism
-        make -C $PRK_TARGET_PATH transpose-vector-thread transpose-vector-async
+        make -C $PRK_TARGET_PATH transpose-vector-thread transpose-vector-async random-vector-thread \
+                                 reduce-vector-thread refcount-vector-thread global-vector-thread \
+                                 p2p-vector-thread transpose-mmap
         $PRK_TARGET_PATH/transpose-vector-thread 10 1024 512 32
         $PRK_TARGET_PATH/transpose-vector-async  10 1024 512 32
+        $PRK_TARGET_PATH/transpose-vector-thread 10 1024 auto
+        $PRK_TARGET_PATH/transpose-vector-async  10 1024 auto
+        $PRK_TARGET_PATH/random-vector-thread    4 20 16 16
+        $PRK_TARGET_PATH/random-vector-thread    2 20 16 16 bucket 1024
+        $PRK_TARGET_PATH/reduce-vector-thread    4 10 100000
+        $PRK_TARGET_PATH/reduce-vector-thread    3 10 1001 binary-p2p
+        $PRK_TARGET_PATH/refcount-vector-thread  4 100000 16
+        $PRK_TARGET_PATH/global-vector-thread    4 1000 64
+        $PRK_TARGET_PATH/p2p-vector-thread       4 10 1024 1024
+        for a in compact scatter cores smt 0 ; do
+            PRK_AFFINITY=$a $PRK_TARGET_PATH/p2p-vector-thread 2 10 1024 1024
+        done
+        PRK_AFFINITY=compact $PRK_TARGET_PATH/transpose-vector-async 10 1024 512 32
+        $PRK_TARGET_PATH/p2p-vector-thread       3 10 1024 1024 100
+        $PRK_TARGET_PATH/p2p-vector-thread       4 10 128 128 16 8
+        $PRK_TARGET_PATH/transpose-mmap          4 1024 4
+        $PRK_TARGET_PATH/transpose-mmap          4 1024 4 pread 32 /tmp
 
         # C++11 with OpenMP
         export OMP_NUM_THREADS=2
@@ -359,14 +400,23 @@ case "$PRK_TARGET" in
             gcc)
                 # Host
                 echo "OPENMPFLAG=-fopenmp" >> common/make.defs
-                make -C $PRK_TARGET_PATH p2p-tasks-openmp p2p-hyperplane-openmp stencil-openmp \
-                                         transpose-openmp nstream-openmp
+                make -C $PRK_TARGET_PATH p2p-tasks-openmp p2p-hyperplane-openmp p2p-hyperplane-skew-openmp stencil-openmp \
+                                         transpose-openmp nstream-openmp pic-sort-openmp amr-tasks-openmp prk-suite
                 $PRK_TARGET_PATH/p2p-tasks-openmp                 10 1024 1024 100 100
+                $PRK_TARGET_PATH/p2p-tasks-openmp                 10 128 128 16 16 8
+                $PRK_TARGET_PATH/p2p-tasks-openmp                 10 1024 1024 auto
                 $PRK_TARGET_PATH/p2p-hyperplane-openmp     10 1024
                 $PRK_TARGET_PATH/p2p-hyperplane-openmp     10 1024 64
+                $PRK_TARGET_PATH/p2p-hyperplane-skew-openmp 10 1024
                 $PRK_TARGET_PATH/stencil-openmp            10 1000
                 $PRK_TARGET_PATH/transpose-openmp          10 1024 32
                 $PRK_TARGET_PATH/nstream-openmp            10 16777216 32
+                $PRK_TARGET_PATH/pic-sort-openmp           10 1000 1000000 1 0 0 GEOMETRIC 0.99
+                $PRK_TARGET_PATH/pic-sort-openmp           10 1000 1000000 1 0 5 SINUSOIDAL
+                $PRK_TARGET_PATH/amr-tasks-openmp          10 1000 100 2 5 2 1
+                $PRK_TARGET_PATH/amr-tasks-openmp          10 400 64 1 3 3 2 32 grid 3
+                $PRK_TARGET_PATH/prk-suite                 $PRK_TARGET_PATH/nightly.suite prk-suite.json
+                PRK_SUITE_THRESHOLD=1 $PRK_TARGET_PATH/prk-suite --compare prk-suite.json
                 #echo "Test stencil code generator"
                 for s in star grid ; do
                     for r in 1 2 3 4 5 ; do
@@ -394,11 +444,13 @@ case "$PRK_TARGET" in
                 if [ "${TRAVIS_OS_NAME}" = "osx" ] ; then
                     # Host
                     echo "OPENMPFLAG=-fopenmp" >> common/make.defs
-                    make -C $PRK_TARGET_PATH p2p-tasks-openmp p2p-hyperplane-openmp stencil-openmp \
+                    make -C $PRK_TARGET_PATH p2p-tasks-openmp p2p-hyperplane-openmp p2p-hyperplane-skew-openmp stencil-openmp \
                                              transpose-openmp nstream-openmp
                     $PRK_TARGET_PATH/p2p-tasks-openmp                 10 1024 1024 100 100
+                    $PRK_TARGET_PATH/p2p-tasks-openmp                 10 128 128 16 16 8
                     $PRK_TARGET_PATH/p2p-hyperplane-openmp     10 1024
                     $PRK_TARGET_PATH/p2p-hyperplane-openmp     10 1024 64
+                    $PRK_TARGET_PATH/p2p-hyperplane-skew-openmp 10 1024
                     $PRK_TARGET_PATH/stencil-openmp            10 1000
                     $PRK_TARGET_PATH/transpose-openmp          10 1024 32
                     $PRK_TARGET_PATH/nstream-openmp            10 16777216 32
@@ -498,6 +550,7 @@ case "$PRK_TARGET" in
             $PRK_TARGET_PATH/p2p-hyperplane-vector-tbb    10 1024 1
             $PRK_TARGET_PATH/p2p-hyperplane-vector-tbb    10 1024 32
             $PRK_TARGET_PATH/p2p-tasks-tbb                10 1024 1024 32 32
+            $PRK_TARGET_PATH/p2p-tasks-tbb                10 1024 1024 4 4
             $PRK_TARGET_PATH/stencil-vector-tbb           10 1000
             $PRK_TARGET_PATH/transpose-vector-tbb         10 1024 32
             $PRK_TARGET_PATH/nstream-vector-tbb           10 16777216 32